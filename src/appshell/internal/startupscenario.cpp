@@ -35,6 +35,9 @@ void StartupScenario::setStartupScorePath(const io::path& path)
 
 void StartupScenario::run()
 {
+    //! NOTE Offers the scores of a session that did not end properly before anything else is opened
+    dispatcher()->dispatch("recover-autosaved-scores");
+
     if (!m_startupScorePath.empty()) {
         openScore(m_startupScorePath);
         return;
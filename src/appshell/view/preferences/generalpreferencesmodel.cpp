@@ -89,12 +89,12 @@ bool GeneralPreferencesModel::isTelemetryAllowed() const
 
 bool GeneralPreferencesModel::isAutoSave() const
 {
-    return false;
+    return notationConfiguration()->isAutoSaveEnabled();
 }
 
 int GeneralPreferencesModel::autoSavePeriod() const
 {
-    return 0;
+    return notationConfiguration()->autoSavePeriod();
 }
 
 bool GeneralPreferencesModel::isOSCRemoteControl() const
@@ -129,13 +129,21 @@ void GeneralPreferencesModel::setIsTelemetryAllowed(bool isTelemetryAllowed)
 
 void GeneralPreferencesModel::setIsAutoSave(bool isAutoSave)
 {
-    NOT_IMPLEMENTED;
+    if (isAutoSave == this->isAutoSave()) {
+        return;
+    }
+
+    notationConfiguration()->setIsAutoSaveEnabled(isAutoSave);
     emit isAutoSaveChanged(isAutoSave);
 }
 
 void GeneralPreferencesModel::setAutoSavePeriod(int autoSavePeriod)
 {
-    NOT_IMPLEMENTED;
+    if (autoSavePeriod == this->autoSavePeriod()) {
+        return;
+    }
+
+    notationConfiguration()->setAutoSavePeriod(autoSavePeriod);
     emit autoSavePeriodChanged(autoSavePeriod);
 }
 
@@ -31,6 +31,7 @@
 #include "languages/ilanguagesconfiguration.h"
 #include "languages/ilanguagesservice.h"
 #include "telemetry/itelemetryconfiguration.h"
+#include "notation/inotationconfiguration.h"
 
 namespace mu::appshell {
 class GeneralPreferencesModel : public QObject, public async::Asyncable
@@ -41,6 +42,7 @@ class GeneralPreferencesModel : public QObject, public async::Asyncable
     INJECT(appshell, languages::ILanguagesConfiguration, languagesConfiguration)
     INJECT(appshell, languages::ILanguagesService, languagesService)
     INJECT(appshell, telemetry::ITelemetryConfiguration, telemetryConfiguration)
+    INJECT(appshell, notation::INotationConfiguration, notationConfiguration)
 
     Q_PROPERTY(QVariantList languages READ languages NOTIFY languagesChanged)
     Q_PROPERTY(QString currentLanguageCode READ currentLanguageCode WRITE setCurrentLanguageCode NOTIFY currentLanguageCodeChanged)
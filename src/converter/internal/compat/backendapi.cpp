@@ -22,6 +22,7 @@
 #include "backendapi.h"
 
 #include <stdio.h>
+#include <memory>
 
 #include <QString>
 #include <QBuffer>
@@ -272,25 +273,30 @@ Ret BackendApi::exportScorePngs(const INotationPtr notation, BackendJsonWriter&
 
     PageList notationPages = pages(notation);
 
+    std::vector<QByteArray> pngDatas(notationPages.size());
+    std::vector<std::unique_ptr<QBuffer> > pngBuffers;
+    std::vector<io::Device*> pngDevices;
+    for (QByteArray& pngData : pngDatas) {
+        auto pngDevice = std::make_unique<QBuffer>(&pngData);
+        pngDevice->open(QIODevice::ReadWrite);
+        pngDevices.push_back(pngDevice.get());
+        pngBuffers.push_back(std::move(pngDevice));
+    }
+
+    INotationWriter::Options options {
+        { INotationWriter::OptionKey::TRANSPARENT_BACKGROUND, Val(false) }
+    };
+
     bool result = true;
-    for (size_t i = 0; i < notationPages.size(); ++i) {
-        QByteArray pngData;
-        QBuffer pngDevice(&pngData);
-        pngDevice.open(QIODevice::ReadWrite);
-
-        INotationWriter::Options options {
-            { INotationWriter::OptionKey::PAGE_NUMBER, Val(static_cast<int>(i)) },
-            { INotationWriter::OptionKey::TRANSPARENT_BACKGROUND, Val(false) }
-        };
-
-        Ret writeRet = pngWriter->write(notation, pngDevice, options);
-        if (!writeRet) {
-            LOGW() << writeRet.toString();
-            result = false;
-        }
+    Ret writeRet = pngWriter->writePages(notation, pngDevices, options);
+    if (!writeRet) {
+        LOGW() << writeRet.toString();
+        result = false;
+    }
 
+    for (size_t i = 0; i < pngDatas.size(); ++i) {
         bool lastArrayValue = ((notationPages.size() - 1) == i);
-        jsonWriter.addValue(pngData.toBase64(), lastArrayValue);
+        jsonWriter.addValue(pngDatas[i].toBase64(), lastArrayValue);
     }
 
     jsonWriter.closeArray(addSeparator);
@@ -315,26 +321,31 @@ Ret BackendApi::exportScoreSvgs(const INotationPtr notation, const io::path& hig
     PageList notationPages = pages(notation);
     QVariantMap notesColors = readNotesColors(highlightConfigPath);
 
+    std::vector<QByteArray> svgDatas(notationPages.size());
+    std::vector<std::unique_ptr<QBuffer> > svgBuffers;
+    std::vector<io::Device*> svgDevices;
+    for (QByteArray& svgData : svgDatas) {
+        auto svgDevice = std::make_unique<QBuffer>(&svgData);
+        svgDevice->open(QIODevice::ReadWrite);
+        svgDevices.push_back(svgDevice.get());
+        svgBuffers.push_back(std::move(svgDevice));
+    }
+
+    INotationWriter::Options options {
+        { INotationWriter::OptionKey::TRANSPARENT_BACKGROUND, Val(false) },
+        { INotationWriter::OptionKey::NOTES_COLORS, Val(notesColors) }
+    };
+
     bool result = true;
-    for (size_t i = 0; i < notationPages.size(); ++i) {
-        QByteArray svgData;
-        QBuffer svgDevice(&svgData);
-        svgDevice.open(QIODevice::ReadWrite);
-
-        INotationWriter::Options options {
-            { INotationWriter::OptionKey::PAGE_NUMBER, Val(static_cast<int>(i)) },
-            { INotationWriter::OptionKey::TRANSPARENT_BACKGROUND, Val(false) },
-            { INotationWriter::OptionKey::NOTES_COLORS, Val(notesColors) }
-        };
-
-        Ret writeRet = svgWriter->write(notation, svgDevice, options);
-        if (!writeRet) {
-            LOGW() << writeRet.toString();
-            result = false;
-        }
+    Ret writeRet = svgWriter->writePages(notation, svgDevices, options);
+    if (!writeRet) {
+        LOGW() << writeRet.toString();
+        result = false;
+    }
 
+    for (size_t i = 0; i < svgDatas.size(); ++i) {
         bool lastArrayValue = ((notationPages.size() - 1) == i);
-        jsonWriter.addValue(svgData.toBase64(), !lastArrayValue);
+        jsonWriter.addValue(svgDatas[i].toBase64(), !lastArrayValue);
     }
 
     jsonWriter.closeArray(addSeparator);
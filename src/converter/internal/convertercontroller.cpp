@@ -21,6 +21,8 @@
  */
 #include "convertercontroller.h"
 
+#include <memory>
+
 #include <QFile>
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -174,25 +176,30 @@ mu::Ret ConverterController::convertPageByPage(notation::INotationWriterPtr writ
 {
     TRACEFUNC;
 
-    for (size_t i = 0; i < notation->elements()->pages().size(); i++) {
+    const size_t pageCount = notation->elements()->pages().size();
+
+    std::vector<std::unique_ptr<QFile> > files;
+    std::vector<io::Device*> devices;
+    for (size_t i = 0; i < pageCount; i++) {
         const QString filePath = io::path(io::dirpath(out) + "/" + io::basename(out) + "-%1." + io::syffix(out)).toQString().arg(i + 1);
 
-        QFile file(filePath);
-        if (!file.open(QFile::WriteOnly)) {
+        auto file = std::make_unique<QFile>(filePath);
+        if (!file->open(QFile::WriteOnly)) {
             return make_ret(Err::OutFileFailedOpen);
         }
 
-        INotationWriter::Options options {
-            { INotationWriter::OptionKey::PAGE_NUMBER, Val(static_cast<int>(i)) },
-        };
+        devices.push_back(file.get());
+        files.push_back(std::move(file));
+    }
 
-        Ret ret = writer->write(notation, file, options);
-        if (!ret) {
-            LOGE() << "failed write, err: " << ret.toString() << ", path: " << out;
-            return make_ret(Err::OutFileFailedWrite);
-        }
+    Ret ret = writer->writePages(notation, devices);
+    if (!ret) {
+        LOGE() << "failed write, err: " << ret.toString() << ", path: " << out;
+        return make_ret(Err::OutFileFailedWrite);
+    }
 
-        file.close();
+    for (const std::unique_ptr<QFile>& file : files) {
+        file->close();
     }
 
     return make_ret(Ret::Code::Ok);
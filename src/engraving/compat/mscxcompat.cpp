@@ -24,40 +24,68 @@
 #include <QFile>
 #include <QBuffer>
 
+#include "scorecache.h"
+
 #include "log.h"
 
-Ms::Score::FileError mu::engraving::compat::loadMsczOrMscx(Ms::MasterScore* score, const QString& path, bool ignoreVersionError)
+Ms::Score::FileError mu::engraving::compat::loadMsczOrMscx(Ms::MasterScore* score, const QString& path, bool ignoreVersionError,
+                                                           const ScoreCache* cache, bool* cacheEntryFailed)
 {
-    QByteArray msczData;
-    QString filePath = path;
-    if (path.endsWith(".mscx")) {
-        //! NOTE Convert mscx -> mscz
+    bool isMscx = path.endsWith(".mscx");
+    if (!isMscx && !path.endsWith(".mscz")) {
+        LOGE() << "unknown type, path: " << path;
+        return Ms::Score::FileError::FILE_UNKNOWN_TYPE;
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        LOGE() << "failed open file: " << path;
+        return Ms::Score::FileError::FILE_OPEN_ERROR;
+    }
+
+    QByteArray fileData = file.readAll();
+    QString filePath = isMscx ? path + ".mscz" : path;
+
+    if (cache) {
+        ScoreCache::SourceVersion sourceVersion;
+        QByteArray cachedData = cache->load(fileData, &sourceVersion);
+        if (!cachedData.isEmpty()) {
+            QBuffer cachedBuf(&cachedData);
+            MsczReader reader(&cachedBuf);
+            reader.setFilePath(filePath);
+            reader.open();
 
-        QFile mscxFile(path);
-        if (!mscxFile.open(QIODevice::ReadOnly)) {
-            LOGE() << "failed open file: " << path;
-            return Ms::Score::FileError::FILE_OPEN_ERROR;
+            Ms::Score::FileError err = score->loadMscz(reader, ignoreVersionError);
+            if (err == Ms::Score::FileError::FILE_NO_ERROR) {
+                //! NOTE Report the version of the file on disk, not of the cache entry
+                score->setMscVersion(sourceVersion.mscVersion);
+                score->setMscoreVersion(sourceVersion.mscoreVersion);
+                score->setMscoreRevision(sourceVersion.mscoreRevision);
+            } else {
+                //! NOTE The score is already partially read, so drop the entry;
+                //! the next attempt will load the file itself
+                LOGE() << "failed load cached score, path: " << path;
+                cache->remove(fileData);
+                if (cacheEntryFailed) {
+                    *cacheEntryFailed = true;
+                }
+            }
+
+            return err;
         }
+    }
 
-        QByteArray mscxData = mscxFile.readAll();
+    QByteArray msczData;
+    if (isMscx) {
+        //! NOTE Convert mscx -> mscz
 
         QBuffer buf(&msczData);
         MsczWriter writer(&buf);
-        filePath = path + ".mscz";
         writer.setFilePath(filePath);
         writer.open();
-        writer.writeScore(mscxData);
-    } else if (path.endsWith(".mscz")) {
-        QFile msczFile(path);
-        if (!msczFile.open(QIODevice::ReadOnly)) {
-            LOGE() << "failed open file: " << path;
-            return Ms::Score::FileError::FILE_OPEN_ERROR;
-        }
-
-        msczData = msczFile.readAll();
+        writer.writeScore(fileData);
     } else {
-        LOGE() << "unknown type, path: " << path;
-        return Ms::Score::FileError::FILE_UNKNOWN_TYPE;
+        msczData = fileData;
     }
 
     QBuffer msczBuf(&msczData);
@@ -66,5 +94,9 @@ Ms::Score::FileError mu::engraving::compat::loadMsczOrMscx(Ms::MasterScore* scor
     reader.open();
 
     Ms::Score::FileError err = score->loadMscz(reader, ignoreVersionError);
+    if (cache && err == Ms::Score::FileError::FILE_NO_ERROR && score->mscVersion() < Ms::MSCVERSION) {
+        cache->store(fileData, score);
+    }
+
     return err;
 }
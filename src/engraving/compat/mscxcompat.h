@@ -25,7 +25,14 @@
 #include "libmscore/score.h"
 
 namespace mu::engraving::compat {
-Ms::Score::FileError loadMsczOrMscx(Ms::MasterScore* score, const QString& path, bool ignoreVersionError = false);
+class ScoreCache;
+
+//! NOTE If a cache is given, files in an older format are loaded from it when possible
+//! and stored in it after a successful load.
+//! A cache entry that cannot be read is removed and cacheEntryFailed is set, the score
+//! is partially read then, so the file has to be loaded again into a new score
+Ms::Score::FileError loadMsczOrMscx(Ms::MasterScore* score, const QString& path, bool ignoreVersionError = false,
+                                    const ScoreCache* cache = nullptr, bool* cacheEntryFailed = nullptr);
 }
 
 #endif // MU_ENGRAVING_MSCXCOMPAT_H
@@ -0,0 +1,199 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "scorecache.h"
+
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+
+#include "config.h"
+#include "libmscore/mscore.h"
+#include "libmscore/score.h"
+
+#include "log.h"
+
+using namespace mu::engraving::compat;
+
+static const quint32 CACHE_MAGIC = 0x4d534343; // "MSCC"
+static const quint32 CACHE_FORMAT_VERSION = 1;
+
+static QByteArray sha1(const QByteArray& data)
+{
+    return QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+}
+
+ScoreCache::ScoreCache(const QString& dirPath, qint64 maxSize)
+    : m_dirPath(dirPath), m_maxSize(maxSize)
+{
+}
+
+QString ScoreCache::dirPath() const
+{
+    return m_dirPath;
+}
+
+QString ScoreCache::programKey()
+{
+    return QString("%1-%2-%3-%4").arg(VERSION, MUSESCORE_REVISION, BUILD_NUMBER).arg(Ms::MSCVERSION);
+}
+
+QString ScoreCache::entryFilePath(const QByteArray& sourceHash) const
+{
+    return m_dirPath + "/" + QString::fromLatin1(sourceHash.toHex()) + ".mscache";
+}
+
+QByteArray ScoreCache::load(const QByteArray& sourceData, SourceVersion* sourceVersion) const
+{
+    const QByteArray sourceHash = sha1(sourceData);
+    QFile file(entryFilePath(sourceHash));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_9);
+
+    quint32 magic = 0;
+    quint32 formatVersion = 0;
+    QString programKey;
+    QByteArray entrySourceHash;
+    quint64 entrySourceSize = 0;
+    qint32 mscVersion = 0;
+    QString mscoreVersion;
+    qint32 mscoreRevision = 0;
+    QByteArray payloadHash;
+    QByteArray payload;
+
+    in >> magic >> formatVersion;
+    if (magic != CACHE_MAGIC || formatVersion != CACHE_FORMAT_VERSION) {
+        LOGW() << "unknown cache entry format: " << file.fileName();
+        return QByteArray();
+    }
+
+    in >> programKey >> entrySourceHash >> entrySourceSize >> mscVersion >> mscoreVersion >> mscoreRevision >> payloadHash >> payload;
+    if (in.status() != QDataStream::Ok) {
+        LOGW() << "truncated cache entry: " << file.fileName();
+        return QByteArray();
+    }
+
+    if (programKey != ScoreCache::programKey()) {
+        LOGD() << "cache entry written by another program version: " << programKey;
+        return QByteArray();
+    }
+
+    if (entrySourceHash != sourceHash || entrySourceSize != quint64(sourceData.size())) {
+        return QByteArray();
+    }
+
+    if (sha1(payload) != payloadHash) {
+        LOGW() << "corrupted cache entry: " << file.fileName();
+        return QByteArray();
+    }
+
+    //! NOTE The modification time orders the entries for eviction
+    file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+
+    if (sourceVersion) {
+        sourceVersion->mscVersion = mscVersion;
+        sourceVersion->mscoreVersion = mscoreVersion;
+        sourceVersion->mscoreRevision = mscoreRevision;
+    }
+
+    return payload;
+}
+
+bool ScoreCache::store(const QByteArray& sourceData, Ms::MasterScore* score) const
+{
+    //! NOTE Writing marks the score as saved by this version, but it is still the file on disk
+    SourceVersion sourceVersion;
+    sourceVersion.mscVersion = score->mscVersion();
+    sourceVersion.mscoreVersion = score->mscoreVersion();
+    sourceVersion.mscoreRevision = score->mscoreRevision();
+
+    QByteArray payload;
+    QBuffer payloadBuf(&payload);
+    bool ok = score->writeMscz(&payloadBuf, score->fileInfo()->fileName(), false, false);
+
+    score->setMscVersion(sourceVersion.mscVersion);
+    score->setMscoreVersion(sourceVersion.mscoreVersion);
+    score->setMscoreRevision(sourceVersion.mscoreRevision);
+
+    if (!ok) {
+        LOGE() << "failed write score to cache";
+        return false;
+    }
+
+    return storeData(sourceData, payload, sourceVersion);
+}
+
+bool ScoreCache::storeData(const QByteArray& sourceData, const QByteArray& payload, const SourceVersion& sourceVersion) const
+{
+    if (!QDir().mkpath(m_dirPath)) {
+        LOGE() << "failed create cache dir: " << m_dirPath;
+        return false;
+    }
+
+    const QByteArray sourceHash = sha1(sourceData);
+    QSaveFile file(entryFilePath(sourceHash));
+    if (!file.open(QIODevice::WriteOnly)) {
+        LOGE() << "failed open file: " << file.fileName();
+        return false;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_9);
+    out << CACHE_MAGIC << CACHE_FORMAT_VERSION;
+    out << programKey() << sourceHash << quint64(sourceData.size())
+        << qint32(sourceVersion.mscVersion) << sourceVersion.mscoreVersion << qint32(sourceVersion.mscoreRevision);
+    out << sha1(payload) << payload;
+
+    if (out.status() != QDataStream::Ok || !file.commit()) {
+        LOGE() << "failed write file: " << file.fileName();
+        return false;
+    }
+
+    evict(m_maxSize);
+
+    return true;
+}
+
+void ScoreCache::remove(const QByteArray& sourceData) const
+{
+    QFile::remove(entryFilePath(sha1(sourceData)));
+}
+
+void ScoreCache::evict(qint64 maxSize) const
+{
+    const QFileInfoList entries = QDir(m_dirPath).entryInfoList({ "*.mscache" }, QDir::Files, QDir::Time);
+
+    qint64 size = 0;
+    for (int i = 0; i < entries.size(); ++i) {
+        size += entries.at(i).size();
+        if (i > 0 && size > maxSize) {
+            QFile::remove(entries.at(i).absoluteFilePath());
+        }
+    }
+}
@@ -0,0 +1,78 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_ENGRAVING_SCORECACHE_H
+#define MU_ENGRAVING_SCORECACHE_H
+
+#include <QString>
+#include <QByteArray>
+
+namespace Ms {
+class MasterScore;
+}
+
+namespace mu::engraving::compat {
+//! NOTE Sidecar cache for scores written in an older file format.
+//! An entry holds the score as it is after reading and compatibility fixups,
+//! saved in the current format, so reopening an unchanged file skips the
+//! legacy readers. Entries are keyed by the SHA-1 of the original file data
+//! and are only used when the program version and the payload checksum match;
+//! otherwise the caller falls back to normal loading.
+//! Only the legacy reading is skipped: the element tree is still read from the
+//! cached MSCX and laid out, libmscore has no binary form of the element tree or
+//! of the layout to restore. Files in the current format are not cached.
+//! The least recently used entries are removed when the cache grows over its maximum size.
+class ScoreCache
+{
+public:
+    static constexpr qint64 DEFAULT_MAX_SIZE = 256 * 1024 * 1024;
+
+    explicit ScoreCache(const QString& dirPath, qint64 maxSize = DEFAULT_MAX_SIZE);
+
+    //! Version info of the original file, restored after reading a cache entry
+    struct SourceVersion {
+        int mscVersion = 0;
+        QString mscoreVersion;
+        int mscoreRevision = 0;
+    };
+
+    QString dirPath() const;
+
+    //! Returns the cached mscz data for the given source file data (empty if there is no valid entry)
+    QByteArray load(const QByteArray& sourceData, SourceVersion* sourceVersion = nullptr) const;
+    bool store(const QByteArray& sourceData, Ms::MasterScore* score) const;
+    bool storeData(const QByteArray& sourceData, const QByteArray& payload, const SourceVersion& sourceVersion) const;
+    void remove(const QByteArray& sourceData) const;
+
+    //! Removes the least recently used entries over maxSize, the most recent one is always kept
+    void evict(qint64 maxSize) const;
+
+    static QString programKey();
+
+private:
+    QString entryFilePath(const QByteArray& sourceHash) const;
+
+    QString m_dirPath;
+    qint64 m_maxSize = DEFAULT_MAX_SIZE;
+};
+}
+
+#endif // MU_ENGRAVING_SCORECACHE_H
@@ -65,6 +65,8 @@ struct DrawPolygon {
 struct DrawText {
     PointF pos;
     QString text;
+    bool workaround = false; // drawn with drawTextWorkaround
+    uint ucs4Code = 0; // not 0 if drawn with drawSymbol
 };
 
 struct DrawRectText {
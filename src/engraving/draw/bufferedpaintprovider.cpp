@@ -118,9 +118,20 @@ const DrawData::State& BufferedPaintProvider::currentState() const
     return currentData().state;
 }
 
-DrawData::Data& BufferedPaintProvider::editableData()
+//! NOTE A data is replayed grouped by the kind of primitives, so it only holds primitives of one kind.
+//! A primitive of another kind starts a new data with the same state, that keeps the recorded order.
+template<typename T>
+std::vector<T>& BufferedPaintProvider::editablePrimitives(std::vector<T> DrawData::Data::* primitives)
 {
-    return m_currentObjects.top().datas.back();
+    DrawData::Data& data = m_currentObjects.top().datas.back();
+    if (data.empty() || !(data.*primitives).empty()) {
+        return data.*primitives;
+    }
+
+    DrawData::Data newData;
+    newData.state = data.state;
+    m_currentObjects.top().datas.push_back(std::move(newData));
+    return m_currentObjects.top().datas.back().*primitives;
 }
 
 DrawData::State& BufferedPaintProvider::editableState()
@@ -185,10 +196,17 @@ const Brush& BufferedPaintProvider::brush() const
 
 void BufferedPaintProvider::save()
 {
+    m_savedStates.push(currentState());
 }
 
 void BufferedPaintProvider::restore()
 {
+    if (m_savedStates.empty()) {
+        return;
+    }
+
+    editableState() = m_savedStates.top();
+    m_savedStates.pop();
 }
 
 void BufferedPaintProvider::setTransform(const QTransform& transform)
@@ -212,11 +230,8 @@ void BufferedPaintProvider::drawPath(const QPainterPath& path)
         mode = DrawMode::Fill;
     } else if (st.brush.style() == BrushStyle::NoBrush) {
         mode = DrawMode::Stroke;
-    } else {
-        LOGW() << "not set pen or brush, path will not draw";
-        return;
     }
-    editableData().paths.push_back({ path, st.pen, st.brush, mode });
+    editablePrimitives(&DrawData::Data::paths).push_back({ path, st.pen, st.brush, mode });
 }
 
 void BufferedPaintProvider::drawPolygon(const PointF* points, size_t pointCount, PolygonMode mode)
@@ -225,38 +240,38 @@ void BufferedPaintProvider::drawPolygon(const PointF* points, size_t pointCount,
     for (size_t i = 0; i < pointCount; ++i) {
         pol[i] = PointF(points[i].x(), points[i].y());
     }
-    editableData().polygons.push_back(DrawPolygon { pol, mode });
+    editablePrimitives(&DrawData::Data::polygons).push_back(DrawPolygon { pol, mode });
 }
 
 void BufferedPaintProvider::drawText(const PointF& point, const QString& text)
 {
-    editableData().texts.push_back(DrawText { point, text });
+    editablePrimitives(&DrawData::Data::texts).push_back(DrawText { point, text });
 }
 
 void BufferedPaintProvider::drawText(const RectF& rect, int flags, const QString& text)
 {
-    editableData().rectTexts.push_back(DrawRectText { rect, flags, text });
+    editablePrimitives(&DrawData::Data::rectTexts).push_back(DrawRectText { rect, flags, text });
 }
 
 void BufferedPaintProvider::drawTextWorkaround(const Font& f, const PointF& pos, const QString& text)
 {
     setFont(f);
-    drawText(pos, text);
+    editablePrimitives(&DrawData::Data::texts).push_back(DrawText { pos, text, true });
 }
 
 void BufferedPaintProvider::drawSymbol(const PointF& point, uint ucs4Code)
 {
-    drawText(point, QString::fromUcs4(&ucs4Code, 1));
+    editablePrimitives(&DrawData::Data::texts).push_back(DrawText { point, QString::fromUcs4(&ucs4Code, 1), false, ucs4Code });
 }
 
 void BufferedPaintProvider::drawPixmap(const PointF& p, const QPixmap& pm)
 {
-    editableData().pixmaps.push_back(DrawPixmap { p, pm });
+    editablePrimitives(&DrawData::Data::pixmaps).push_back(DrawPixmap { p, pm });
 }
 
 void BufferedPaintProvider::drawTiledPixmap(const RectF& rect, const QPixmap& pm, const PointF& offset)
 {
-    editableData().tiledPixmap.push_back(DrawTiledPixmap { rect, pm, offset });
+    editablePrimitives(&DrawData::Data::tiledPixmap).push_back(DrawTiledPixmap { rect, pm, offset });
 }
 
 const DrawData& BufferedPaintProvider::drawData() const
@@ -269,4 +284,6 @@ void BufferedPaintProvider::clear()
     m_buf = DrawData();
     std::stack<DrawData::Object> empty;
     m_currentObjects.swap(empty);
+    std::stack<DrawData::State> emptyStates;
+    m_savedStates.swap(emptyStates);
 }
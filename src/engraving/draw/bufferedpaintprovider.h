@@ -92,13 +92,15 @@ public:
 private:
 
     const DrawData::Data& currentData() const;
-    DrawData::Data& editableData();
+    template<typename T>
+    std::vector<T>& editablePrimitives(std::vector<T> DrawData::Data::* primitives);
 
     const DrawData::State& currentState() const;
     DrawData::State& editableState();
 
     DrawData m_buf;
     std::stack<DrawData::Object> m_currentObjects;
+    std::stack<DrawData::State> m_savedStates;
     bool m_isActive = false;
     DrawObjectsLogger* m_drawObjectsLogger = nullptr;
 };
@@ -20,6 +20,9 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 #include "font.h"
+
+#include <QHash>
+
 #include "global/realfn.h"
 
 using namespace mu::draw;
@@ -29,6 +32,12 @@ Font::Font(const QString& family)
 {
 }
 
+uint mu::draw::qHash(const Font& font, uint seed)
+{
+    return ::qHash(font.family(), seed) ^ ::qHash(int(font.weight()), seed)
+           ^ ::qHash((int(font.bold()) | int(font.italic()) << 1 | int(font.underline()) << 2), seed);
+}
+
 bool Font::operator ==(const Font& other) const
 {
     return m_family == other.m_family
@@ -90,6 +90,9 @@ private:
     bool m_noFontMerging = false;
     Hinting m_hinting = Hinting::PreferDefaultHinting;
 };
+
+//! NOTE The point size is compared with a tolerance, so it is not part of the hash
+uint qHash(const Font& font, uint seed = 0);
 }
 
 #endif // MU_DRAW_FONT_H
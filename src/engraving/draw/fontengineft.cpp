@@ -21,6 +21,9 @@
  */
 #include "fontengineft.h"
 
+#include <algorithm>
+#include <vector>
+
 #include <QFile>
 #include <QHash>
 
@@ -49,17 +52,41 @@ static bool _init_ft()
 
 struct mu::draw::FTGlyphMetrics
 {
-    FT_BBox bb;
+    FT_BBox bb { 0, 0, 0, 0 };
     double linearHoriAdvance = 0.0;
+    bool valid = false;
 };
 
+//! NOTE The metrics are loaded on the first query of a glyph, together with the other
+//! glyphs of its block. SMuFL fonts number their glyphs in code point order, so the
+//! symbols of a layout mostly share a few blocks, and a later query is a hash lookup
+//! of the glyph index followed by an array lookup.
+static constexpr size_t GLYPH_BLOCK_SIZE = 64;
+
 struct mu::draw::FTData
 {
     QByteArray fontData;
     FT_Face face = nullptr;
-    QHash<uint, FTGlyphMetrics> metrics;
+    QHash<uint /*ucs4*/, uint /*glyph index*/> glyphIndexes; // 0 if not in the font
+    std::vector<FTGlyphMetrics> metrics; // indexed by glyph index
+    std::vector<bool> loadedBlocks;
 };
 
+static QRectF toBBox(const FT_BBox& bb, qreal DPI_F)
+{
+    //! NOTE Moved form sym.cpp ScoreFont::computeMetrics as is
+    double m = 640.0 / DPI_F;
+    QRectF bbox;
+    bbox.setCoords(bb.xMin / m, -bb.yMax / m, bb.xMax / m, -bb.yMin / m);
+    return bbox;
+}
+
+static qreal toAdvance(double linearHoriAdvance, qreal DPI_F)
+{
+    //! NOTE Moved form sym.cpp ScoreFont::computeMetrics as is
+    return linearHoriAdvance * DPI_F / 655360.0;
+}
+
 FontEngineFT::FontEngineFT()
 {
     m_data = new FTData();
@@ -94,58 +121,97 @@ bool FontEngineFT::load(const QString& path)
     qreal pixelSize = 200.0;
     FT_Set_Pixel_Sizes(m_data->face, 0, int(pixelSize + .5));
 
+    const size_t glyphCount = static_cast<size_t>(m_data->face->num_glyphs);
+    m_data->metrics.assign(glyphCount, FTGlyphMetrics());
+    m_data->loadedBlocks.assign((glyphCount + GLYPH_BLOCK_SIZE - 1) / GLYPH_BLOCK_SIZE, false);
+
     return true;
 }
 
+uint FontEngineFT::glyphIndex(uint ucs4) const
+{
+    auto it = m_data->glyphIndexes.constFind(ucs4);
+    if (it != m_data->glyphIndexes.constEnd()) {
+        return it.value();
+    }
+
+    uint index = FT_Get_Char_Index(m_data->face, ucs4);
+    m_data->glyphIndexes.insert(ucs4, index);
+    return index;
+}
+
+void FontEngineFT::loadGlyphBlock(size_t block) const
+{
+    FT_Face face = m_data->face;
+    const size_t end = std::min((block + 1) * GLYPH_BLOCK_SIZE, m_data->metrics.size());
+    for (size_t index = block * GLYPH_BLOCK_SIZE; index < end; ++index) {
+        if (FT_Load_Glyph(face, FT_UInt(index), FT_LOAD_DEFAULT) != 0) {
+            continue;
+        }
+
+        FT_BBox bb;
+        if (FT_Outline_Get_BBox(&face->glyph->outline, &bb) == 0) {
+            FTGlyphMetrics& gm = m_data->metrics[index];
+            gm.bb = bb;
+            gm.linearHoriAdvance = face->glyph->linearHoriAdvance;
+            gm.valid = true;
+        }
+    }
+    m_data->loadedBlocks[block] = true;
+}
+
 QRectF FontEngineFT::bbox(uint ucs4, qreal DPI_F) const
 {
-    FTGlyphMetrics* gm = glyphMetrics(ucs4);
+    const FTGlyphMetrics* gm = glyphMetrics(ucs4);
     if (!gm) {
         return QRectF();
     }
 
-    const FT_BBox& bb = gm->bb;
-    //! NOTE Moved form sym.cpp ScoreFont::computeMetrics as is
-    double m = 640.0 / DPI_F;
-    QRectF bbox;
-    bbox.setCoords(bb.xMin / m, -bb.yMax / m, bb.xMax / m, -bb.yMin / m);
-    return bbox;
+    return toBBox(gm->bb, DPI_F);
 }
 
 qreal FontEngineFT::advance(uint ucs4, qreal DPI_F) const
 {
-    FTGlyphMetrics* gm = glyphMetrics(ucs4);
+    const FTGlyphMetrics* gm = glyphMetrics(ucs4);
     if (!gm) {
         return 0.0;
     }
 
-    //! NOTE Moved form sym.cpp ScoreFont::computeMetrics as is
-    return gm->linearHoriAdvance * DPI_F / 655360.0;
+    return toAdvance(gm->linearHoriAdvance, DPI_F);
 }
 
-FTGlyphMetrics* FontEngineFT::glyphMetrics(uint ucs4) const
+QRectF FontEngineFT::bbox(const std::vector<uint>& ucs4s, qreal DPI_F) const
 {
-    if (m_data->metrics.contains(ucs4)) {
-        return &m_data->metrics[ucs4];
-    }
+    QRectF bbox;
+    double linearHoriAdvance = 0.0;
+    for (uint ucs4 : ucs4s) {
+        const FTGlyphMetrics* gm = glyphMetrics(ucs4);
+        if (!gm) {
+            continue;
+        }
 
-    FT_UInt index = FT_Get_Char_Index(m_data->face, ucs4);
-    if (index == 0) {
-        return nullptr;
+        bbox |= toBBox(gm->bb, DPI_F).translated(toAdvance(linearHoriAdvance, DPI_F), 0.0);
+        linearHoriAdvance += gm->linearHoriAdvance;
     }
+    return bbox;
+}
 
-    if (FT_Load_Glyph(m_data->face, index, FT_LOAD_DEFAULT) != 0) {
+const FTGlyphMetrics* FontEngineFT::glyphMetrics(uint ucs4) const
+{
+    if (!m_data->face) {
         return nullptr;
     }
 
-    FT_BBox bb;
-    if (FT_Outline_Get_BBox(&m_data->face->glyph->outline, &bb) != 0) {
+    const uint index = glyphIndex(ucs4);
+    if (index == 0 || index >= m_data->metrics.size()) {
         return nullptr;
     }
 
-    FTGlyphMetrics& gm = m_data->metrics[ucs4];
-    gm.bb = bb;
-    gm.linearHoriAdvance = m_data->face->glyph->linearHoriAdvance;
+    const size_t block = index / GLYPH_BLOCK_SIZE;
+    if (!m_data->loadedBlocks[block]) {
+        loadGlyphBlock(block);
+    }
 
-    return &gm;
+    const FTGlyphMetrics& gm = m_data->metrics[index];
+    return gm.valid ? &gm : nullptr;
 }
@@ -22,6 +22,8 @@
 #ifndef MU_DRAW_FONTENGINEFT_H
 #define MU_DRAW_FONTENGINEFT_H
 
+#include <vector>
+
 #include <QString>
 #include <QByteArray>
 
@@ -39,9 +41,14 @@ public:
     QRectF bbox(uint ucs4, qreal DPI_F) const;
     qreal advance(uint ucs4, qreal DPI_F) const;
 
+    //! NOTE The glyphs are placed one after another on the baseline
+    QRectF bbox(const std::vector<uint>& ucs4s, qreal DPI_F) const;
+
 private:
 
-    FTGlyphMetrics* glyphMetrics(uint ucs4) const;
+    uint glyphIndex(uint ucs4) const;
+    void loadGlyphBlock(size_t block) const;
+    const FTGlyphMetrics* glyphMetrics(uint ucs4) const;
 
     FTData* m_data = nullptr;
 };
@@ -0,0 +1,176 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "glyphatlas.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QPainter>
+#include <QPainterPath>
+#include <QPaintEngine>
+
+using namespace mu::draw;
+
+static constexpr int SCALE_BUCKETS_PER_OCTAVE = 32;
+static constexpr int MAX_GLYPH_PIXEL_SIZE = 256;
+static constexpr int MAX_CACHE_COST_KB = 32 * 1024;
+
+namespace mu::draw {
+uint qHash(const GlyphAtlas::Key& key, uint seed)
+{
+    return ::qHash(key.fontKey, seed) ^ ::qHash(key.ucs4Code) ^ ::qHash(key.scaleBucket << 8) ^ ::qHash(key.color);
+}
+}
+
+GlyphAtlas* GlyphAtlas::instance()
+{
+    static GlyphAtlas atlas;
+    return &atlas;
+}
+
+GlyphAtlas::GlyphAtlas()
+    : m_glyphs(MAX_CACHE_COST_KB)
+{
+}
+
+void GlyphAtlas::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_glyphs.clear();
+}
+
+bool GlyphAtlas::draw(QPainter* painter, const QString& fontKey, const PointF& point, uint ucs4Code)
+{
+    //! NOTE Printing, PDF and SVG keep the vectors
+    if (!painter->paintEngine() || painter->paintEngine()->type() != QPaintEngine::Raster || painter->viewTransformEnabled()) {
+        return false;
+    }
+
+    if (painter->pen().style() == Qt::NoPen) {
+        return false;
+    }
+
+    const QTransform world = painter->worldTransform();
+    if (world.type() > QTransform::TxScale) {
+        return false;
+    }
+
+    const qreal devicePixelRatio = painter->device()->devicePixelRatioF();
+    const qreal scaling = world.m11() * devicePixelRatio;
+    if (scaling <= 0 || !qFuzzyCompare(scaling, world.m22() * devicePixelRatio)) {
+        return false;
+    }
+
+    Key key;
+    key.fontKey = fontKey;
+    key.ucs4Code = ucs4Code;
+    key.scaleBucket = static_cast<int>(std::lround(std::log2(scaling) * SCALE_BUCKETS_PER_OCTAVE));
+    key.color = painter->pen().color().rgba();
+
+    Glyph glyph;
+    bool found = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (const Glyph* cached = m_glyphs.object(key)) {
+            glyph = *cached;
+            found = true;
+        }
+    }
+
+    if (!found) {
+        const qreal bucketScaling = std::pow(2.0, static_cast<qreal>(key.scaleBucket) / SCALE_BUCKETS_PER_OCTAVE);
+        glyph = renderGlyph(painter->font(), ucs4Code, bucketScaling, painter->pen().color());
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_glyphs.insert(key, new Glyph(glyph), std::max(1, static_cast<int>(glyph.image.sizeInBytes() / 1024)));
+    }
+
+    if (glyph.isTooLarge) {
+        return false;
+    }
+
+    if (glyph.image.isNull()) {
+        return true;
+    }
+
+    //! NOTE The image is drawn in device pixels, scaled by what is left from the bucket
+    const qreal ratio = scaling / glyph.scaling;
+    QPointF devicePos = world.map(point.toQPointF()) * devicePixelRatio;
+    const bool isExact = qFuzzyCompare(ratio, 1.0);
+    if (isExact) {
+        devicePos = QPointF(std::round(devicePos.x()), std::round(devicePos.y()));
+    }
+
+    const QRectF target((devicePos.x() - glyph.origin.x() * ratio) / devicePixelRatio,
+                        (devicePos.y() - glyph.origin.y() * ratio) / devicePixelRatio,
+                        glyph.image.width() * ratio / devicePixelRatio,
+                        glyph.image.height() * ratio / devicePixelRatio);
+
+    const bool wasSmooth = painter->testRenderHint(QPainter::SmoothPixmapTransform);
+    if (!isExact && !wasSmooth) {
+        painter->setRenderHint(QPainter::SmoothPixmapTransform, true);
+    }
+
+    painter->setWorldTransform(QTransform());
+    painter->drawImage(target, glyph.image);
+    painter->setWorldTransform(world);
+
+    if (!isExact && !wasSmooth) {
+        painter->setRenderHint(QPainter::SmoothPixmapTransform, false);
+    }
+
+    return true;
+}
+
+GlyphAtlas::Glyph GlyphAtlas::renderGlyph(const QFont& font, uint ucs4Code, qreal scaling, const QColor& color)
+{
+    Glyph glyph;
+    glyph.scaling = scaling;
+
+    QPainterPath path;
+    path.setFillRule(Qt::WindingFill);
+    path.addText(QPointF(0, 0), font, QString::fromUcs4(&ucs4Code, 1));
+
+    const QRectF bounds = path.boundingRect();
+    if (bounds.isEmpty()) {
+        return glyph;
+    }
+
+    const QRect pixelRect = QRectF(bounds.topLeft() * scaling, bounds.bottomRight() * scaling).toAlignedRect().adjusted(-1, -1, 1, 1);
+    if (pixelRect.width() > MAX_GLYPH_PIXEL_SIZE || pixelRect.height() > MAX_GLYPH_PIXEL_SIZE) {
+        glyph.isTooLarge = true;
+        return glyph;
+    }
+
+    glyph.origin = -pixelRect.topLeft();
+    glyph.image = QImage(pixelRect.size(), QImage::Format_ARGB32_Premultiplied);
+    glyph.image.fill(Qt::transparent);
+
+    QPainter painter(&glyph.image);
+    painter.setRenderHint(QPainter::Antialiasing, true);
+    painter.translate(glyph.origin);
+    painter.scale(scaling, scaling);
+    painter.fillPath(path, color);
+    painter.end();
+
+    return glyph;
+}
@@ -0,0 +1,86 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_DRAW_GLYPHATLAS_H
+#define MU_DRAW_GLYPHATLAS_H
+
+#include <mutex>
+
+#include <QCache>
+#include <QImage>
+#include <QPoint>
+#include <QString>
+
+#include "geometry.h"
+
+class QPainter;
+class QFont;
+class QColor;
+
+namespace mu::draw {
+//! NOTE Raster images of the symbols of the music fonts, for painting on screen.
+//! A symbol is rendered once per font, zoom bucket and color and then only blitted,
+//! instead of being shaped and rasterized again every time it is painted.
+//! The atlas is shared by all the painting threads.
+class GlyphAtlas
+{
+public:
+    static GlyphAtlas* instance();
+
+    //! NOTE Returns false if the symbol cannot be drawn from the atlas with this painter
+    //! (not a raster device, rotated or too large), then it has to be drawn as text
+    bool draw(QPainter* painter, const QString& fontKey, const PointF& point, uint ucs4Code);
+
+    void clear();
+
+private:
+    GlyphAtlas();
+
+    struct Key {
+        QString fontKey;
+        uint ucs4Code = 0;
+        int scaleBucket = 0;
+        QRgb color = 0;
+
+        bool operator==(const Key& other) const
+        {
+            return ucs4Code == other.ucs4Code && scaleBucket == other.scaleBucket && color == other.color
+                   && fontKey == other.fontKey;
+        }
+    };
+
+    struct Glyph {
+        QImage image;       // null for a symbol without outline
+        QPoint origin;      // the position of the symbol origin in the image
+        qreal scaling = 1.0;
+        bool isTooLarge = false;
+    };
+
+    friend uint qHash(const Key& key, uint seed);
+
+    static Glyph renderGlyph(const QFont& font, uint ucs4Code, qreal scaling, const QColor& color);
+
+    QCache<Key, Glyph> m_glyphs;
+    std::mutex m_mutex;
+};
+}
+
+#endif // MU_DRAW_GLYPHATLAS_H
@@ -23,6 +23,8 @@
 #ifndef MU_DRAW_IFONTPROVIDER_H
 #define MU_DRAW_IFONTPROVIDER_H
 
+#include <vector>
+
 #include "framework/global/modularity/imoduleexport.h"
 
 #include "font.h"
@@ -60,6 +62,7 @@ public:
     // Score symbols
     virtual RectF symBBox(const Font& f, uint ucs4, qreal DPI_F) const = 0;
     virtual qreal symAdvance(const Font& f, uint ucs4, qreal DPI_F) const = 0;
+    virtual RectF symBBox(const Font& f, const std::vector<uint>& ucs4s, qreal DPI_F) const = 0;
 };
 }
 
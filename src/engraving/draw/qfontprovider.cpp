@@ -34,77 +34,154 @@ using namespace mu::draw;
 int QFontProvider::addApplicationFont(const QString& family, const QString& path)
 {
     m_paths[family] = path;
+    clearMetricsCache();
     return QFontDatabase::addApplicationFont(path);
 }
 
 void QFontProvider::insertSubstitution(const QString& familyName, const QString& substituteName)
 {
+    clearMetricsCache();
     QFont::insertSubstitution(familyName, substituteName);
 }
 
 qreal QFontProvider::lineSpacing(const Font& f) const
 {
-    return QFontMetricsF(toQFont(f), Ms::MScore::paintDevice()).lineSpacing();
+    return fontMetrics(f).lineSpacing();
 }
 
 qreal QFontProvider::xHeight(const Font& f) const
 {
-    return QFontMetricsF(toQFont(f), Ms::MScore::paintDevice()).xHeight();
+    return fontMetrics(f).xHeight();
 }
 
 qreal QFontProvider::height(const Font& f) const
 {
-    return QFontMetricsF(toQFont(f), Ms::MScore::paintDevice()).height();
+    return fontMetrics(f).height();
 }
 
 qreal QFontProvider::ascent(const Font& f) const
 {
-    return QFontMetricsF(toQFont(f), Ms::MScore::paintDevice()).ascent();
+    return fontMetrics(f).ascent();
 }
 
 qreal QFontProvider::descent(const Font& f) const
 {
-    return QFontMetricsF(toQFont(f), Ms::MScore::paintDevice()).descent();
+    return fontMetrics(f).descent();
 }
 
 bool QFontProvider::inFont(const Font& f, QChar ch) const
 {
-    return QFontMetricsF(toQFont(f), Ms::MScore::paintDevice()).inFont(ch);
+    return fontMetrics(f).inFont(ch);
 }
 
 bool QFontProvider::inFontUcs4(const Font& f, uint ucs4) const
 {
-    return QFontMetricsF(toQFont(f), Ms::MScore::paintDevice()).inFontUcs4(ucs4);
+    return fontMetrics(f).inFontUcs4(ucs4);
 }
 
 qreal QFontProvider::horizontalAdvance(const Font& f, const QString& string) const
 {
-    return QFontMetricsF(toQFont(f), Ms::MScore::paintDevice()).horizontalAdvance(string);
+    const CachedFont* font = cachedFont(f);
+    TextMetrics* m = textMetrics(font->id, string);
+    if (m->flags & TextMetrics::HasAdvance) {
+        ++m_cacheStats.textHits;
+    } else {
+        ++m_cacheStats.textMisses;
+        m->advance = font->metrics.horizontalAdvance(string);
+        m->flags |= TextMetrics::HasAdvance;
+    }
+    return m->advance;
 }
 
 qreal QFontProvider::horizontalAdvance(const Font& f, const QChar& ch) const
 {
-    return QFontMetricsF(toQFont(f), Ms::MScore::paintDevice()).horizontalAdvance(ch);
+    return fontMetrics(f).horizontalAdvance(ch);
 }
 
 RectF QFontProvider::boundingRect(const Font& f, const QString& string) const
 {
-    return RectF::fromQRectF(QFontMetricsF(toQFont(f), Ms::MScore::paintDevice()).boundingRect(string));
+    const CachedFont* font = cachedFont(f);
+    TextMetrics* m = textMetrics(font->id, string);
+    if (m->flags & TextMetrics::HasBoundingRect) {
+        ++m_cacheStats.textHits;
+    } else {
+        ++m_cacheStats.textMisses;
+        m->boundingRect = RectF::fromQRectF(font->metrics.boundingRect(string));
+        m->flags |= TextMetrics::HasBoundingRect;
+    }
+    return m->boundingRect;
 }
 
 RectF QFontProvider::boundingRect(const Font& f, const QChar& ch) const
 {
-    return RectF::fromQRectF(QFontMetricsF(toQFont(f), Ms::MScore::paintDevice()).boundingRect(ch));
+    return RectF::fromQRectF(fontMetrics(f).boundingRect(ch));
 }
 
 RectF QFontProvider::boundingRect(const Font& f, const RectF& r, int flags, const QString& string) const
 {
-    return RectF::fromQRectF(QFontMetricsF(toQFont(f), Ms::MScore::paintDevice()).boundingRect(r.toQRectF(), flags, string));
+    return RectF::fromQRectF(fontMetrics(f).boundingRect(r.toQRectF(), flags, string));
 }
 
 RectF QFontProvider::tightBoundingRect(const Font& f, const QString& string) const
 {
-    return RectF::fromQRectF(QFontMetricsF(toQFont(f), Ms::MScore::paintDevice()).tightBoundingRect(string));
+    const CachedFont* font = cachedFont(f);
+    TextMetrics* m = textMetrics(font->id, string);
+    if (m->flags & TextMetrics::HasTightBoundingRect) {
+        ++m_cacheStats.textHits;
+    } else {
+        ++m_cacheStats.textMisses;
+        m->tightBoundingRect = RectF::fromQRectF(font->metrics.tightBoundingRect(string));
+        m->flags |= TextMetrics::HasTightBoundingRect;
+    }
+    return m->tightBoundingRect;
+}
+
+QFontProvider::CacheStats QFontProvider::cacheStats() const
+{
+    return m_cacheStats;
+}
+
+void QFontProvider::resetCacheStats()
+{
+    m_cacheStats = CacheStats();
+}
+
+//! NOTE The returned entry is valid until the next call
+const QFontProvider::CachedFont* QFontProvider::cachedFont(const Font& f) const
+{
+    CachedFont* font = m_fonts.object(f);
+    if (font) {
+        ++m_cacheStats.fontHits;
+        return font;
+    }
+
+    ++m_cacheStats.fontMisses;
+    font = new CachedFont { m_nextFontId++, QFontMetricsF(toQFont(f), Ms::MScore::paintDevice()) };
+    m_fonts.insert(f, font);
+    return font;
+}
+
+const QFontMetricsF& QFontProvider::fontMetrics(const Font& f) const
+{
+    return cachedFont(f)->metrics;
+}
+
+//! NOTE The returned entry is valid until the next call
+QFontProvider::TextMetrics* QFontProvider::textMetrics(int fontId, const QString& string) const
+{
+    TextKey key { fontId, string };
+    TextMetrics* m = m_textMetrics.object(key);
+    if (!m) {
+        m = new TextMetrics();
+        m_textMetrics.insert(key, m);
+    }
+    return m;
+}
+
+void QFontProvider::clearMetricsCache()
+{
+    m_textMetrics.clear();
+    m_fonts.clear();
 }
 
 // Score symbols
@@ -126,6 +203,15 @@ qreal QFontProvider::symAdvance(const Font& f, uint ucs4, qreal DPI_F) const
     return engine->advance(ucs4, DPI_F);
 }
 
+RectF QFontProvider::symBBox(const Font& f, const std::vector<uint>& ucs4s, qreal DPI_F) const
+{
+    FontEngineFT* engine = symEngine(f);
+    if (!engine) {
+        return RectF();
+    }
+    return RectF::fromQRectF(engine->bbox(ucs4s, DPI_F));
+}
+
 FontEngineFT* QFontProvider::symEngine(const Font& f) const
 {
     QString path = m_paths.value(f.family());
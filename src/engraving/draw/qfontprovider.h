@@ -22,7 +22,10 @@
 #ifndef MU_DRAW_QFONTPROVIDER_H
 #define MU_DRAW_QFONTPROVIDER_H
 
+#include <QCache>
+#include <QFontMetricsF>
 #include <QHash>
+
 #include "ifontprovider.h"
 
 namespace mu::draw {
@@ -56,13 +59,67 @@ public:
     // Score symbols
     RectF symBBox(const Font& f, uint ucs4, qreal DPI_F) const override;
     qreal symAdvance(const Font& f, uint ucs4, qreal DPI_F) const override;
+    RectF symBBox(const Font& f, const std::vector<uint>& ucs4s, qreal DPI_F) const override;
+
+    struct CacheStats {
+        quint64 fontHits = 0;
+        quint64 fontMisses = 0;
+        quint64 textHits = 0;
+        quint64 textMisses = 0;
+    };
+
+    CacheStats cacheStats() const;
+    void resetCacheStats();
 
 private:
 
+    //! NOTE Metrics are cached on two levels: a QFontMetricsF for the most recently used
+    //! fonts, and the advance and bounding rects of the most recently measured (font, string)
+    //! pairs. A font gets a new id each time it enters the cache, so the texts measured with
+    //! an evicted font are never hit again and age out of their cache.
+    static constexpr int MAX_CACHED_FONTS = 256;
+    static constexpr int MAX_CACHED_TEXTS = 16384;
+
+    struct CachedFont {
+        int id = -1;
+        QFontMetricsF metrics;
+    };
+
+    struct TextKey {
+        int fontId = -1;
+        QString text;
+
+        bool operator==(const TextKey& other) const { return fontId == other.fontId && text == other.text; }
+    };
+    friend uint qHash(const TextKey& key, uint seed) { return ::qHash(key.text, seed) ^ uint(key.fontId); }
+
+    struct TextMetrics {
+        enum Flag {
+            HasAdvance = 1 << 0,
+            HasBoundingRect = 1 << 1,
+            HasTightBoundingRect = 1 << 2
+        };
+
+        int flags = 0;
+        qreal advance = 0.0;
+        RectF boundingRect;
+        RectF tightBoundingRect;
+    };
+
+    const CachedFont* cachedFont(const Font& f) const;
+    const QFontMetricsF& fontMetrics(const Font& f) const;
+    TextMetrics* textMetrics(int fontId, const QString& string) const;
+    void clearMetricsCache();
+
     FontEngineFT* symEngine(const Font& f) const;
 
     QHash<QString /*family*/, QString /*path*/> m_paths;
     mutable QHash<QString /*path*/, FontEngineFT*> m_symEngines;
+
+    mutable QCache<Font, CachedFont> m_fonts { MAX_CACHED_FONTS };
+    mutable int m_nextFontId = 0;
+    mutable QCache<TextKey, TextMetrics> m_textMetrics { MAX_CACHED_TEXTS };
+    mutable CacheStats m_cacheStats;
 };
 }
 
@@ -29,6 +29,7 @@
 #include <QStaticText>
 
 #include "fontcompat.h"
+#include "glyphatlas.h"
 #include "utils/drawlogger.h"
 #include "log.h"
 
@@ -61,6 +62,11 @@ IPaintProviderPtr QPainterProvider::make(QPainter* qp, bool overship)
     return std::make_shared<QPainterProvider>(qp, overship);
 }
 
+void QPainterProvider::setUseGlyphAtlas(bool arg)
+{
+    m_useGlyphAtlas = arg;
+}
+
 QPaintDevice* QPainterProvider::device() const
 {
     return m_painter->device();
@@ -125,6 +131,7 @@ void QPainterProvider::setFont(const Font& font)
     if (m_font != font) {
         m_painter->setFont(mu::draw::toQFont(font));
         m_font = font;
+        m_glyphAtlasFontKey.clear();
     }
 }
 
@@ -287,7 +294,18 @@ void QPainterProvider::drawTextWorkaround(const Font& f, const PointF& pos, cons
 
 void QPainterProvider::drawSymbol(const PointF& point, uint ucs4Code)
 {
-    static QHash<uint, QString> cache;
+    if (m_useGlyphAtlas) {
+        if (m_glyphAtlasFontKey.isEmpty()) {
+            m_glyphAtlasFontKey = m_painter->font().key() + QLatin1Char(':') + QString::number(m_painter->device()->logicalDpiY());
+        }
+
+        if (GlyphAtlas::instance()->draw(m_painter, m_glyphAtlasFontKey, point, ucs4Code)) {
+            return;
+        }
+    }
+
+    //! NOTE The pages may be painted on several threads
+    static thread_local QHash<uint, QString> cache;
     if (!cache.contains(ucs4Code)) {
         cache[ucs4Code] = QString::fromUcs4(&ucs4Code, 1);
     }
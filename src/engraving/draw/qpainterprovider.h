@@ -22,6 +22,8 @@
 #ifndef MU_DRAW_QPAINTERPROVIDER_H
 #define MU_DRAW_QPAINTERPROVIDER_H
 
+#include <QString>
+
 #include "ipaintprovider.h"
 
 class QPainter;
@@ -38,6 +40,9 @@ public:
     static IPaintProviderPtr make(QPaintDevice* dp);
     static IPaintProviderPtr make(QPainter* qp, bool overship = false);
 
+    //! NOTE For painting on screen, the symbols are blitted from GlyphAtlas when possible
+    void setUseGlyphAtlas(bool arg);
+
     QPaintDevice* device() const override;
     QPainter* qpainter() const override;
 
@@ -86,6 +91,8 @@ private:
     bool m_overship = false;
     DrawObjectsLogger* m_drawObjectsLogger = nullptr;
     Font m_font;
+    bool m_useGlyphAtlas = false;
+    QString m_glyphAtlasFontKey;
     Pen m_pen;
     Brush m_brush;
 
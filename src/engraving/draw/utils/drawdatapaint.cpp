@@ -0,0 +1,97 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "drawdatapaint.h"
+
+#include "../painter.h"
+
+using namespace mu::draw;
+
+void DrawDataPaint::paint(Painter* painter, const DrawData::Object& obj)
+{
+    IPaintProviderPtr provider = painter->provider();
+
+    const QTransform base = provider->transform();
+    const Pen pen = provider->pen();
+    const Brush brush = provider->brush();
+    const Font font = provider->font();
+    CompositionMode compositionMode = CompositionMode::SourceOver;
+
+    for (const DrawData::Data& d : obj.datas) {
+        const DrawData::State& st = d.state;
+        provider->setTransform(st.transform * base);
+        if (st.compositionMode != compositionMode) {
+            compositionMode = st.compositionMode;
+            provider->setCompositionMode(compositionMode);
+        }
+        provider->setFont(st.font);
+        provider->setPen(st.pen);
+        provider->setBrush(st.brush);
+
+        for (const DrawPath& path : d.paths) {
+            provider->setPen(path.pen);
+            provider->setBrush(path.brush);
+            provider->drawPath(path.path);
+        }
+
+        if (!d.paths.empty()) {
+            provider->setPen(st.pen);
+            provider->setBrush(st.brush);
+        }
+
+        for (const DrawPolygon& pl : d.polygons) {
+            if (pl.polygon.empty()) {
+                continue;
+            }
+            provider->drawPolygon(&pl.polygon[0], pl.polygon.size(), pl.mode);
+        }
+
+        for (const DrawText& t : d.texts) {
+            if (t.workaround) {
+                provider->drawTextWorkaround(st.font, t.pos, t.text);
+            } else if (t.ucs4Code) {
+                provider->drawSymbol(t.pos, t.ucs4Code);
+            } else {
+                provider->drawText(t.pos, t.text);
+            }
+        }
+
+        for (const DrawRectText& t : d.rectTexts) {
+            provider->drawText(t.rect, t.flags, t.text);
+        }
+
+        for (const DrawPixmap& px : d.pixmaps) {
+            provider->drawPixmap(px.pos, px.pm);
+        }
+
+        for (const DrawTiledPixmap& px : d.tiledPixmap) {
+            provider->drawTiledPixmap(px.rect, px.pm, px.offset);
+        }
+    }
+
+    if (compositionMode != CompositionMode::SourceOver) {
+        provider->setCompositionMode(CompositionMode::SourceOver);
+    }
+    provider->setTransform(base);
+    provider->setFont(font);
+    provider->setPen(pen);
+    provider->setBrush(brush);
+}
@@ -0,0 +1,43 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_DRAW_DRAWDATAPAINT_H
+#define MU_DRAW_DRAWDATAPAINT_H
+
+#include "../buffereddrawtypes.h"
+
+namespace mu::draw {
+class Painter;
+
+//! NOTE Replays recorded draw data on a painter.
+//! The data must be recorded by a painter without a base transform,
+//! then it is drawn with the current transform of the target painter.
+//! Within one state the recorded primitives are replayed by kind
+//! (paths, polygons, texts, pixmaps), not in the order they were drawn.
+//! Antialiasing is left as set on the target painter.
+class DrawDataPaint
+{
+public:
+    static void paint(Painter* painter, const DrawData::Object& obj);
+};
+}
+
+#endif // MU_DRAW_DRAWDATAPAINT_H
@@ -32,6 +32,7 @@
 #include "engraving/libmscore/scorefont.h"
 
 #include "notation/inotationconfiguration.h"
+#include "iglobalconfiguration.h"
 
 using namespace mu::engraving;
 using namespace mu::modularity;
@@ -63,6 +64,11 @@ void EngravingModule::registerUiTypes()
 
 void EngravingModule::onInit(const framework::IApplication::RunMode&)
 {
+    auto globalConfiguration = ioc()->resolve<framework::IGlobalConfiguration>(moduleName());
+    if (globalConfiguration) {
+        Ms::ScoreFont::setMetricsCacheDir(globalConfiguration->userAppDataPath().toQString() + "/score_fonts");
+    }
+
     Ms::MScore::init(); // initialize libmscore
 
     Ms::MScore::setNudgeStep(0.1); // cursor key (default 0.1)
@@ -0,0 +1,434 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "autosavejournal.h"
+
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+#include <QtConcurrent>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "score.h"
+#include "scoresnapshot.h"
+
+#include "dtl/dtl.hpp"
+
+#include "log.h"
+
+namespace Ms {
+static const quint32 JOURNAL_MAGIC = 0x4d53414a; // "MSAJ"
+static const quint32 JOURNAL_FORMAT_VERSION = 2;
+
+//---------------------------------------------------------
+//   syncToDisk
+//---------------------------------------------------------
+
+static bool syncToDisk(QFile& file)
+{
+    if (!file.flush()) {
+        return false;
+    }
+#ifdef Q_OS_WIN
+    return _commit(file.handle()) == 0;
+#else
+    return ::fsync(file.handle()) == 0;
+#endif
+}
+
+//---------------------------------------------------------
+//   AutosaveJournal
+//---------------------------------------------------------
+
+AutosaveJournal::AutosaveJournal(const QString& filePath, const QString& scorePath)
+    : _filePath(filePath), _scorePath(scorePath), _lock(lockFilePath(filePath))
+{
+    //! NOTE The lock is held for the whole session; it only becomes stale when its process is gone
+    _lock.setStaleLockTime(0);
+    if (!_lock.tryLock(0)) {
+        LOGW() << "autosave journal is locked by another instance: " << _filePath;
+    }
+}
+
+AutosaveJournal::~AutosaveJournal()
+{
+    flush();
+}
+
+//---------------------------------------------------------
+//   save
+//    Journal the current state of the score if it changed
+//    since the last call. Only the measures edited since
+//    are serialized here, see MasterScore::snapshot(); the
+//    rest is done in the thread pool. A new journal gets
+//    a snapshot of the whole score. If writing fails, the
+//    next call starts over with it.
+//---------------------------------------------------------
+
+void AutosaveJournal::save(MasterScore* score)
+{
+    //! NOTE The UI thread doesn't wait for a slow disk, the score stays dirty and is saved the next time
+    if (_worker.isRunning()) {
+        return;
+    }
+
+    if (!_journaled.isEmpty() && !score->autosaveDirty()) {
+        return;
+    }
+
+    //! NOTE Compacting writes the state as the journal base, which is then written without shared chunks
+    const bool compacting = _journaled.isEmpty() || _deltaCount + 1 >= MAX_DELTAS;
+    const ScoreSnapshotPtr snapshot = score->snapshot(!compacting);
+    score->setAutosaveDirty(false);
+
+    _worker = QtConcurrent::run([this, snapshot]() {
+        write(snapshot->mscxData());
+    });
+}
+
+//---------------------------------------------------------
+//   flush
+//    waits until the last saved state is on disk
+//---------------------------------------------------------
+
+void AutosaveJournal::flush()
+{
+    _worker.waitForFinished();
+}
+
+//---------------------------------------------------------
+//   write
+//    runs in the thread pool
+//---------------------------------------------------------
+
+void AutosaveJournal::write(const QByteArray& mscxData)
+{
+    QByteArray delta;
+    bool ok = true;
+
+    if (_journaled.isEmpty() || !makeDelta(_journaled, mscxData, delta)) {
+        ok = writeSnapshot(mscxData);
+        _deltaCount = 0;
+        _deltaBytes = 0;
+    } else if (!delta.isEmpty()) {
+        ok = appendDelta(delta);
+        ++_deltaCount;
+        _deltaBytes += delta.size();
+    }
+
+    if (!ok) {
+        LOGE() << "failed write autosave journal: " << _filePath;
+        _journaled.clear();
+        return;
+    }
+
+    _journaled = mscxData;
+
+    if (_deltaCount >= MAX_DELTAS || _deltaBytes > _journaled.size() / 4) {
+        if (!writeSnapshot(_journaled)) {
+            LOGE() << "failed compact autosave journal: " << _filePath;
+            _journaled.clear();
+        }
+        _deltaCount = 0;
+        _deltaBytes = 0;
+    }
+}
+
+//---------------------------------------------------------
+//   remove
+//    called after the score has been saved or closed
+//---------------------------------------------------------
+
+void AutosaveJournal::remove()
+{
+    flush();
+    QFile::remove(_filePath);
+    _journaled.clear();
+    _deltaCount = 0;
+    _deltaBytes = 0;
+}
+
+//---------------------------------------------------------
+//   isInUse
+//    true if the journal belongs to a running instance
+//---------------------------------------------------------
+
+bool AutosaveJournal::isInUse(const QString& filePath)
+{
+    QLockFile lock(lockFilePath(filePath));
+    lock.setStaleLockTime(0);
+    if (!lock.tryLock(0)) {
+        return true;
+    }
+    lock.unlock();
+    return false;
+}
+
+QString AutosaveJournal::lockFilePath(const QString& filePath)
+{
+    return filePath + ".lock";
+}
+
+//---------------------------------------------------------
+//   recover
+//---------------------------------------------------------
+
+bool AutosaveJournal::recover(const QString& filePath, QByteArray& mscxData, QString* scorePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_9);
+
+    quint32 magic = 0;
+    quint32 formatVersion = 0;
+    QString path;
+    in >> magic >> formatVersion >> path;
+    if (magic != JOURNAL_MAGIC || formatVersion != JOURNAL_FORMAT_VERSION) {
+        LOGE() << "unknown autosave journal format: " << filePath;
+        return false;
+    }
+
+    QByteArray state;
+    int deltas = 0;
+    while (!in.atEnd()) {
+        quint8 type = 0;
+        QByteArray payload;
+        quint16 checksum = 0;
+        in >> type >> payload >> checksum;
+        if (in.status() != QDataStream::Ok || checksum != qChecksum(payload.constData(), uint(payload.size()))) {
+            //! NOTE The last record may be incomplete if we crashed while writing it
+            LOGW() << "damaged autosave journal record, recovered up to delta " << deltas;
+            break;
+        }
+
+        if (RecordType(type) == RecordType::SNAPSHOT) {
+            state = qUncompress(payload);
+            deltas = 0;
+        } else {
+            QByteArray next;
+            if (state.isEmpty() || !applyDelta(state, payload, next)) {
+                LOGW() << "inconsistent autosave journal, recovered up to delta " << deltas;
+                break;
+            }
+            state = next;
+            ++deltas;
+        }
+    }
+
+    if (state.isEmpty()) {
+        return false;
+    }
+
+    mscxData = state;
+    if (scorePath) {
+        *scorePath = path;
+    }
+    return true;
+}
+
+//---------------------------------------------------------
+//   makeDelta
+//    Line diff of two MSCX texts. Edits are usually local,
+//    so the common head and tail are skipped before
+//    running the diff. Returns false if the changed part is
+//    too large to diff cheaply; a snapshot is written then.
+//    An empty delta means there is no change.
+//---------------------------------------------------------
+
+bool AutosaveJournal::makeDelta(const QByteArray& from, const QByteArray& to, QByteArray& delta)
+{
+    const QList<QByteArray> a = from.split('\n');
+    const QList<QByteArray> b = to.split('\n');
+
+    int head = 0;
+    while (head < a.size() && head < b.size() && a.at(head) == b.at(head)) {
+        ++head;
+    }
+    int tail = 0;
+    while (tail < a.size() - head && tail < b.size() - head && a.at(a.size() - 1 - tail) == b.at(b.size() - 1 - tail)) {
+        ++tail;
+    }
+
+    delta.clear();
+    if (head == a.size() && head == b.size()) {
+        return true;
+    }
+
+    const std::vector<QByteArray> midA(a.begin() + head, a.end() - tail);
+    const std::vector<QByteArray> midB(b.begin() + head, b.end() - tail);
+    if (int(midA.size()) > MAX_DIFF_LINES || int(midB.size()) > MAX_DIFF_LINES) {
+        return false;
+    }
+
+    struct Hunk {
+        qint32 start = -1;          // first replaced line of the old text
+        qint32 removed = 0;
+        QList<QByteArray> inserted;
+    };
+    std::vector<Hunk> hunks;
+
+    if (midA.empty() || midB.empty()) {
+        Hunk hunk;
+        hunk.start = head;
+        hunk.removed = qint32(midA.size());
+        hunk.inserted = QList<QByteArray>(midB.begin(), midB.end());
+        hunks.push_back(hunk);
+    } else {
+        dtl::Diff<QByteArray, std::vector<QByteArray> > diff(midA, midB);
+        diff.compose();
+
+        Hunk hunk;
+        qint32 line = head;
+        for (const auto& ch : diff.getSes().getSequence()) {
+            switch (ch.second.type) {
+            case dtl::SES_COMMON:
+                if (hunk.start != -1) {
+                    hunks.push_back(hunk);
+                    hunk = Hunk();
+                }
+                ++line;
+                break;
+            case dtl::SES_DELETE:
+                if (hunk.start == -1) {
+                    hunk.start = line;
+                }
+                ++hunk.removed;
+                ++line;
+                break;
+            case dtl::SES_ADD:
+                if (hunk.start == -1) {
+                    hunk.start = line;
+                }
+                hunk.inserted.append(ch.first);
+                break;
+            }
+        }
+        if (hunk.start != -1) {
+            hunks.push_back(hunk);
+        }
+    }
+
+    QDataStream out(&delta, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_5_9);
+    out << qint32(a.size()) << qint32(b.size()) << qint32(hunks.size());
+    for (const Hunk& hunk : hunks) {
+        out << hunk.start << hunk.removed << hunk.inserted;
+    }
+    return true;
+}
+
+//---------------------------------------------------------
+//   applyDelta
+//---------------------------------------------------------
+
+bool AutosaveJournal::applyDelta(const QByteArray& from, const QByteArray& delta, QByteArray& to)
+{
+    const QList<QByteArray> a = from.split('\n');
+
+    QDataStream in(delta);
+    in.setVersion(QDataStream::Qt_5_9);
+    qint32 oldSize = 0;
+    qint32 newSize = 0;
+    qint32 hunkCount = 0;
+    in >> oldSize >> newSize >> hunkCount;
+    if (in.status() != QDataStream::Ok || oldSize != a.size()) {
+        return false;
+    }
+
+    QList<QByteArray> b;
+    b.reserve(newSize);
+    int pos = 0;
+    for (int i = 0; i < hunkCount; ++i) {
+        qint32 start = 0;
+        qint32 removed = 0;
+        QList<QByteArray> inserted;
+        in >> start >> removed >> inserted;
+        if (in.status() != QDataStream::Ok || start < pos || removed < 0 || start + removed > a.size()) {
+            return false;
+        }
+        for (; pos < start; ++pos) {
+            b.append(a.at(pos));
+        }
+        b.append(inserted);
+        pos += removed;
+    }
+    for (; pos < a.size(); ++pos) {
+        b.append(a.at(pos));
+    }
+
+    if (b.size() != newSize) {
+        return false;
+    }
+
+    to = b.join('\n');
+    return true;
+}
+
+//---------------------------------------------------------
+//   writeSnapshot
+//    replaces the journal by a single snapshot record
+//---------------------------------------------------------
+
+bool AutosaveJournal::writeSnapshot(const QByteArray& mscxData)
+{
+    QSaveFile file(_filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    const QByteArray payload = qCompress(mscxData);
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_9);
+    out << JOURNAL_MAGIC << JOURNAL_FORMAT_VERSION << _scorePath;
+    out << quint8(RecordType::SNAPSHOT) << payload << qChecksum(payload.constData(), uint(payload.size()));
+
+    // QSaveFile syncs the data to disk before renaming it over the old journal
+    return out.status() == QDataStream::Ok && file.commit();
+}
+
+//---------------------------------------------------------
+//   appendDelta
+//---------------------------------------------------------
+
+bool AutosaveJournal::appendDelta(const QByteArray& delta)
+{
+    QFile file(_filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        return false;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_9);
+    out << quint8(RecordType::DELTA) << delta << qChecksum(delta.constData(), uint(delta.size()));
+
+    return out.status() == QDataStream::Ok && syncToDisk(file);
+}
+}
@@ -0,0 +1,96 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __AUTOSAVEJOURNAL_H__
+#define __AUTOSAVEJOURNAL_H__
+
+#include <QByteArray>
+#include <QFuture>
+#include <QLockFile>
+#include <QString>
+
+namespace Ms {
+class MasterScore;
+
+//---------------------------------------------------------
+//   AutosaveJournal
+//    Append-only autosave file. It starts with the path of
+//    the score and a full snapshot of the score in MSCX
+//    format, followed by line deltas against the previously
+//    journaled state. Every record is synced to disk. When
+//    the deltas grow too large the journal is rewritten as
+//    a single snapshot.
+//    Only the measures edited since the last save are
+//    serialized in save(), see ScoreSnapshot; joining the
+//    text, diffing, compression and disk I/O run in the
+//    thread pool.
+//    The journal is locked while it is in use, so another
+//    instance does not offer to recover it.
+//    recover() replays the deltas on top of the snapshot,
+//    ignoring a trailing record damaged by a crash.
+//---------------------------------------------------------
+
+class AutosaveJournal
+{
+public:
+    AutosaveJournal(const QString& filePath, const QString& scorePath = QString());
+    AutosaveJournal(const AutosaveJournal&) = delete;
+    ~AutosaveJournal();
+
+    const QString& filePath() const { return _filePath; }
+    const QString& scorePath() const { return _scorePath; }
+    int deltaCount() const { return _deltaCount; }   // valid after flush()
+
+    void save(MasterScore* score);
+    void flush();
+    void remove();
+
+    static bool recover(const QString& filePath, QByteArray& mscxData, QString* scorePath = nullptr);
+    static bool isInUse(const QString& filePath);
+
+private:
+    enum class RecordType : quint8 {
+        SNAPSHOT,
+        DELTA
+    };
+
+    static constexpr int MAX_DELTAS = 64;
+    static constexpr int MAX_DIFF_LINES = 20000;
+
+    static bool makeDelta(const QByteArray& from, const QByteArray& to, QByteArray& delta);
+    static bool applyDelta(const QByteArray& from, const QByteArray& delta, QByteArray& to);
+    static QString lockFilePath(const QString& filePath);
+
+    void write(const QByteArray& mscxData);
+    bool writeSnapshot(const QByteArray& mscxData);
+    bool appendDelta(const QByteArray& delta);
+
+    QString _filePath;
+    QString _scorePath;
+    QLockFile _lock;
+    QByteArray _journaled;        // score state the journal replays to, owned by the worker
+    int _deltaCount { 0 };
+    qint64 _deltaBytes { 0 };
+    QFuture<void> _worker;
+};
+}     // namespace Ms
+#endif
@@ -0,0 +1,398 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "binaryxml.h"
+
+#include <cstring>
+
+#include <QHash>
+
+namespace Ms {
+//---------------------------------------------------------
+//   Layout of the data:
+//    magic, format version, byte order of the text,
+//    number of names, the names,
+//    the tokens up to the end of the data.
+//    Numbers are variable length, 7 bits per byte.
+//    Strings are a number of UTF-16 code units followed
+//    by the code units.
+//---------------------------------------------------------
+
+static const char BINARY_XML_MAGIC[] = "MSBX";
+static const int BINARY_XML_MAGIC_SIZE = 4;
+static const char BINARY_XML_VERSION = 1;
+static const char BINARY_XML_LITTLE_ENDIAN = Q_BYTE_ORDER == Q_LITTLE_ENDIAN;
+
+enum BinaryXmlToken : char {
+    START_ELEMENT = 1,        // name, number of attributes, name and value of each
+    END_ELEMENT,
+    CHARACTERS,               // text
+    WHITESPACE,               // text of white space only
+};
+
+//---------------------------------------------------------
+//   writeNumber
+//---------------------------------------------------------
+
+static void writeNumber(QByteArray& data, int n)
+{
+    unsigned v = unsigned(n);
+    while (v >= 0x80) {
+        data.append(char((v & 0x7f) | 0x80));
+        v >>= 7;
+    }
+    data.append(char(v));
+}
+
+//---------------------------------------------------------
+//   writeString
+//---------------------------------------------------------
+
+static void writeString(QByteArray& data, const QStringRef& s)
+{
+    writeNumber(data, s.size());
+    data.append(reinterpret_cast<const char*>(s.unicode()), s.size() * int(sizeof(QChar)));
+}
+
+//---------------------------------------------------------
+//   fromXml
+//    returns an empty array if the XML is not well-formed
+//---------------------------------------------------------
+
+QByteArray BinaryXmlReader::fromXml(const QByteArray& xml)
+{
+    QHash<QString, int> nameIndexes;
+    QVector<QString> names;
+    auto writeName = [&nameIndexes, &names](QByteArray& data, const QStringRef& name) {
+        const QString s = name.toString();
+        auto it = nameIndexes.constFind(s);
+        if (it == nameIndexes.constEnd()) {
+            it = nameIndexes.insert(s, names.size());
+            names.append(s);
+        }
+        writeNumber(data, it.value());
+    };
+
+    QByteArray tokens;
+    tokens.reserve(xml.size());
+    QXmlStreamReader r(xml);
+    while (!r.atEnd()) {
+        switch (r.readNext()) {
+        case QXmlStreamReader::StartElement: {
+            tokens.append(START_ELEMENT);
+            writeName(tokens, r.name());
+            const QXmlStreamAttributes attributes = r.attributes();
+            writeNumber(tokens, attributes.size());
+            for (const QXmlStreamAttribute& a : attributes) {
+                writeName(tokens, a.qualifiedName());
+                writeString(tokens, a.value());
+            }
+            break;
+        }
+        case QXmlStreamReader::EndElement:
+            tokens.append(END_ELEMENT);
+            break;
+        case QXmlStreamReader::Characters:
+            tokens.append(r.isWhitespace() ? WHITESPACE : CHARACTERS);
+            writeString(tokens, r.text());
+            break;
+        default:
+            break;
+        }
+    }
+    if (r.hasError()) {
+        qDebug("BinaryXmlReader::fromXml: %s", qPrintable(r.errorString()));
+        return QByteArray();
+    }
+
+    QByteArray data;
+    data.reserve(tokens.size() + 16 * names.size());
+    data.append(BINARY_XML_MAGIC, BINARY_XML_MAGIC_SIZE);
+    data.append(BINARY_XML_VERSION);
+    data.append(BINARY_XML_LITTLE_ENDIAN);
+    writeNumber(data, names.size());
+    for (const QString& name : names) {
+        writeString(data, QStringRef(&name));
+    }
+    data.append(tokens);
+    return data;
+}
+
+//---------------------------------------------------------
+//   BinaryXmlReader
+//    not valid if the data was written by another format
+//    version or on a machine of another byte order
+//---------------------------------------------------------
+
+BinaryXmlReader::BinaryXmlReader(const QByteArray& data)
+    : _data(data)
+{
+    _pos = _data.constData();
+    _end = _pos + _data.size();
+
+    if (_data.size() < BINARY_XML_MAGIC_SIZE + 2
+        || std::memcmp(_pos, BINARY_XML_MAGIC, BINARY_XML_MAGIC_SIZE) != 0
+        || _pos[BINARY_XML_MAGIC_SIZE] != BINARY_XML_VERSION
+        || _pos[BINARY_XML_MAGIC_SIZE + 1] != BINARY_XML_LITTLE_ENDIAN) {
+        malformed();
+        return;
+    }
+    _pos += BINARY_XML_MAGIC_SIZE + 2;
+
+    int n = 0;
+    if (!readNumber(n)) {
+        malformed();
+        return;
+    }
+    _names.resize(n);
+    for (QString& name : _names) {
+        if (!readString(name)) {
+            malformed();
+            return;
+        }
+    }
+    _valid = true;
+}
+
+//---------------------------------------------------------
+//   readNumber
+//---------------------------------------------------------
+
+bool BinaryXmlReader::readNumber(int& n)
+{
+    unsigned v = 0;
+    for (int shift = 0; shift < 32; shift += 7) {
+        if (_pos == _end) {
+            return false;
+        }
+        const unsigned char c = static_cast<unsigned char>(*_pos++);
+        v |= unsigned(c & 0x7f) << shift;
+        if (!(c & 0x80)) {
+            n = int(v);
+            return n >= 0;
+        }
+    }
+    return false;
+}
+
+//---------------------------------------------------------
+//   readString
+//---------------------------------------------------------
+
+bool BinaryXmlReader::readString(QString& s)
+{
+    int n = 0;
+    if (!readNumber(n) || n > (_end - _pos) / int(sizeof(QChar))) {
+        return false;
+    }
+    s.resize(n);
+    std::memcpy(s.data(), _pos, n * sizeof(QChar));
+    _pos += n * sizeof(QChar);
+    return true;
+}
+
+//---------------------------------------------------------
+//   malformed
+//---------------------------------------------------------
+
+QXmlStreamReader::TokenType BinaryXmlReader::malformed()
+{
+    raiseError("Malformed binary XML data", QXmlStreamReader::NotWellFormedError);
+    return _type;
+}
+
+//---------------------------------------------------------
+//   raiseError
+//---------------------------------------------------------
+
+void BinaryXmlReader::raiseError(const QString& message, QXmlStreamReader::Error error)
+{
+    _error = error;
+    _errorString = message;
+    _type = QXmlStreamReader::Invalid;
+}
+
+//---------------------------------------------------------
+//   readNext
+//    the same tokens QXmlStreamReader reads from the XML,
+//    without comments and processing instructions
+//---------------------------------------------------------
+
+QXmlStreamReader::TokenType BinaryXmlReader::readNext()
+{
+    if (_type == QXmlStreamReader::EndElement) {
+        _elements.pop_back();
+    }
+
+    switch (_type) {
+    case QXmlStreamReader::Invalid:
+        return _type;
+    case QXmlStreamReader::NoToken:
+        return _type = QXmlStreamReader::StartDocument;
+    case QXmlStreamReader::EndDocument:
+        return _type = QXmlStreamReader::Invalid;
+    default:
+        break;
+    }
+
+    if (_pos == _end) {
+        if (!_elements.empty()) {
+            raiseError("Premature end of binary XML data", QXmlStreamReader::PrematureEndOfDocumentError);
+            return _type;
+        }
+        return _type = QXmlStreamReader::EndDocument;
+    }
+
+    switch (*_pos++) {
+    case START_ELEMENT: {
+        int name = 0;
+        int count = 0;
+        if (!readNumber(name) || name >= _names.size() || !readNumber(count)) {
+            return malformed();
+        }
+        _attributes.clear();
+        for (int i = 0; i < count; ++i) {
+            int attributeName = 0;
+            if (!readNumber(attributeName) || attributeName >= _names.size() || !readString(_text)) {
+                return malformed();
+            }
+            _attributes.append(_names.at(attributeName), _text);
+        }
+        _elements.push_back(name);
+        return _type = QXmlStreamReader::StartElement;
+    }
+    case END_ELEMENT:
+        if (_elements.empty()) {
+            return malformed();
+        }
+        return _type = QXmlStreamReader::EndElement;
+    case CHARACTERS:
+    case WHITESPACE:
+        _whitespace = _pos[-1] == WHITESPACE;
+        if (!readString(_text)) {
+            return malformed();
+        }
+        return _type = QXmlStreamReader::Characters;
+    default:
+        return malformed();
+    }
+}
+
+//---------------------------------------------------------
+//   tokenString
+//---------------------------------------------------------
+
+QString BinaryXmlReader::tokenString() const
+{
+    switch (_type) {
+    case QXmlStreamReader::NoToken: return "NoToken";
+    case QXmlStreamReader::Invalid: return "Invalid";
+    case QXmlStreamReader::StartDocument: return "StartDocument";
+    case QXmlStreamReader::EndDocument: return "EndDocument";
+    case QXmlStreamReader::StartElement: return "StartElement";
+    case QXmlStreamReader::EndElement: return "EndElement";
+    case QXmlStreamReader::Characters: return "Characters";
+    default: return QString();
+    }
+}
+
+//---------------------------------------------------------
+//   name
+//---------------------------------------------------------
+
+QStringRef BinaryXmlReader::name() const
+{
+    if (_type != QXmlStreamReader::StartElement && _type != QXmlStreamReader::EndElement) {
+        return QStringRef();
+    }
+    return QStringRef(&_names.at(_elements.back()));
+}
+
+//---------------------------------------------------------
+//   readNextStartElement
+//    as QXmlStreamReader::readNextStartElement()
+//---------------------------------------------------------
+
+bool BinaryXmlReader::readNextStartElement()
+{
+    while (readNext() != QXmlStreamReader::Invalid) {
+        if (_type == QXmlStreamReader::EndElement) {
+            return false;
+        } else if (_type == QXmlStreamReader::StartElement) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//---------------------------------------------------------
+//   skipCurrentElement
+//    as QXmlStreamReader::skipCurrentElement()
+//---------------------------------------------------------
+
+void BinaryXmlReader::skipCurrentElement()
+{
+    int depth = 1;
+    while (depth && readNext() != QXmlStreamReader::Invalid) {
+        if (_type == QXmlStreamReader::EndElement) {
+            --depth;
+        } else if (_type == QXmlStreamReader::StartElement) {
+            ++depth;
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   readElementText
+//    as QXmlStreamReader::readElementText()
+//---------------------------------------------------------
+
+QString BinaryXmlReader::readElementText(QXmlStreamReader::ReadElementTextBehaviour behaviour)
+{
+    if (_type != QXmlStreamReader::StartElement) {
+        return QString();
+    }
+
+    QString result;
+    for (;;) {
+        switch (readNext()) {
+        case QXmlStreamReader::Characters:
+            result += _text;
+            break;
+        case QXmlStreamReader::EndElement:
+            return result;
+        case QXmlStreamReader::StartElement:
+            if (behaviour == QXmlStreamReader::SkipChildElements) {
+                skipCurrentElement();
+                break;
+            } else if (behaviour == QXmlStreamReader::IncludeChildElements) {
+                result += readElementText(behaviour);
+                break;
+            }
+            raiseError("Expected character data.", QXmlStreamReader::UnexpectedElementError);
+            return result;
+        default:
+            return result;
+        }
+    }
+}
+}
@@ -0,0 +1,97 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __BINARYXML_H__
+#define __BINARYXML_H__
+
+#include <vector>
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include <QXmlStreamReader>
+
+namespace Ms {
+//---------------------------------------------------------
+//   BinaryXmlReader
+//    Reads an XML document from the binary form written by
+//    fromXml(): a stream of element, attribute and text
+//    tokens, with every element and attribute name stored
+//    once and text stored as UTF-16. Reading it needs no
+//    text parsing, entity resolving or decoding.
+//    XmlReader reads through it when it is given one; the
+//    staff list is put on the clipboard in this form too,
+//    so the same version pastes it without parsing XML.
+//    Comments and processing instructions are not kept,
+//    the element readers skip them anyway.
+//---------------------------------------------------------
+
+class BinaryXmlReader
+{
+public:
+    explicit BinaryXmlReader(const QByteArray& data);
+
+    static QByteArray fromXml(const QByteArray& xml);
+
+    bool isValid() const { return _valid; }
+
+    QXmlStreamReader::TokenType readNext();
+    QXmlStreamReader::TokenType tokenType() const { return _type; }
+    QString tokenString() const;
+    bool atEnd() const { return _type == QXmlStreamReader::EndDocument || _type == QXmlStreamReader::Invalid; }
+    bool isWhitespace() const { return _type == QXmlStreamReader::Characters && _whitespace; }
+
+    bool readNextStartElement();
+    void skipCurrentElement();
+    QString readElementText(QXmlStreamReader::ReadElementTextBehaviour behaviour);
+
+    QStringRef name() const;
+    QXmlStreamAttributes attributes() const { return _attributes; }
+    QStringRef text() const { return QStringRef(&_text); }
+
+    QXmlStreamReader::Error error() const { return _error; }
+    QString errorString() const { return _errorString; }
+    void raiseError(const QString& message, QXmlStreamReader::Error error = QXmlStreamReader::CustomError);
+
+private:
+    bool readNumber(int& n);
+    bool readString(QString& s);
+    QXmlStreamReader::TokenType malformed();
+
+    QByteArray _data;
+    const char* _pos = nullptr;
+    const char* _end = nullptr;
+    bool _valid = false;
+
+    QVector<QString> _names;
+    std::vector<int> _elements;             // names of the open elements
+
+    QXmlStreamReader::TokenType _type = QXmlStreamReader::NoToken;
+    QXmlStreamAttributes _attributes;
+    QString _text;
+    bool _whitespace = false;
+
+    QXmlStreamReader::Error _error = QXmlStreamReader::NoError;
+    QString _errorString;
+};
+}     // namespace Ms
+#endif
@@ -244,6 +244,17 @@ void Score::startCmd()
 
     cmdState().reset();
 
+    // edits are propagated through links, so lazily
+    // loaded part scores must be read before any change
+    masterScore()->loadExcerpts();
+
+    // finish a progressive layout, edits expect all pages to be laid out
+    for (Score* s : scoreList()) {
+        if (s->layoutPending()) {
+            s->doLayoutPages(-1);
+        }
+    }
+
     // Start collecting low-level undo operations for a
     // user-visible undo action.
     if (undoStack()->active()) {
@@ -268,6 +279,7 @@ void Score::undoRedo(bool undo, EditData* ed)
     } else {
         undoStack()->redo(ed);
     }
+    masterScore()->addSnapshotEdit(cmdState());
     update(false);
     masterScore()->setPlaylistDirty();    // TODO: flag all individual operations
     updateSelection();
@@ -295,6 +307,10 @@ void Score::endCmd(bool rollback)
         undoStack()->current()->unwind();
     }
 
+    if (!undoStack()->current()->empty()) {
+        masterScore()->addSnapshotEdit(cmdState());
+    }
+
     update(false);
 
     LOGD() << "Undo stack current macro child count: " << undoStack()->current()->childCount();
@@ -335,6 +351,9 @@ void Score::update(bool resetCmdState)
     for (MasterScore* ms : *movements()) {
         CmdState& cs = ms->cmdState();
         ms->deletePostponed();
+        for (Score* s : ms->scoreList()) {
+            s->invalidateNoteTable();
+        }
         if (cs.layoutRange()) {
             for (Score* s : ms->scoreList()) {
                 s->doLayoutRange(cs.startTick(), cs.endTick());
@@ -908,9 +927,9 @@ Segment* Score::setNoteRest(Segment* segment, int track, NoteVal nval, Fraction
             is.slur()->undoChangeProperty(Pid::SPANNER_TICKS, chord->tick() - is.slur()->tick());
             for (ScoreElement* se : is.slur()->linkList()) {
                 Slur* slur = toSlur(se);
-                for (ScoreElement* ee : chord->linkList()) {
+                for (ScoreElement* ee : chord->linkedInScore(slur->score())) {
                     Element* e = static_cast<Element*>(ee);
-                    if (e->score() == slur->score() && e->track() == slur->track2()) {
+                    if (e->track() == slur->track2()) {
                         slur->score()->undo(new ChangeSpannerElements(slur, slur->startElement(), e));
                         break;
                     }
@@ -3113,14 +3132,15 @@ void Score::cmdExplode()
             lastStaff = qMin(nstaves(), srcStaff + n);
         }
 
-        const QByteArray mimeData(selection().mimeData());
+        // pasted once per staff: the binary staff list is read without parsing the XML again
+        const QByteArray mimeData(BinaryXmlReader::fromXml(selection().mimeData()));
         // copy to all destination staves
         Segment* firstCRSegment = startMeasure->tick2segment(startMeasure->tick());
         for (int i = 1; srcStaff + i < lastStaff; ++i) {
             int track = (srcStaff + i) * VOICES;
             ChordRest* cr = toChordRest(firstCRSegment->element(track));
             if (cr) {
-                XmlReader e(mimeData);
+                XmlReader e(std::make_unique<BinaryXmlReader>(mimeData));
                 e.setPasteMode(true);
                 pasteStaff(e, cr->segment(), cr->staffIdx());
             }
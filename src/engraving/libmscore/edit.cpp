@@ -1604,9 +1604,9 @@ void Score::regroupNotesAndRests(const Fraction& startTick, const Fraction& endT
                         _is.slur()->undoChangeProperty(Pid::SPANNER_TICKS, nchord->tick() - _is.slur()->tick());
                         for (ScoreElement* e : _is.slur()->linkList()) {
                             Slur* slur = toSlur(e);
-                            for (ScoreElement* ee : nchord->linkList()) {
+                            for (ScoreElement* ee : nchord->linkedInScore(slur->score())) {
                                 Element* e1 = static_cast<Element*>(ee);
-                                if (e1->score() == slur->score() && e1->track() == slur->track2()) {
+                                if (e1->track() == slur->track2()) {
                                     slur->score()->undo(new ChangeSpannerElements(slur, slur->startElement(), e1));
                                     break;
                                 }
@@ -2245,12 +2245,11 @@ void Score::deleteItem(Element* el)
 
             Tuplet* tuplet = chord->tuplet();
             if (tuplet) {
-                QList<ScoreElement*> tl = tuplet->linkList();
                 for (ScoreElement* e : rest->linkList()) {
                     DurationElement* de = toDurationElement(e);
-                    for (ScoreElement* ee : qAsConst(tl)) {
+                    for (ScoreElement* ee : tuplet->linkedInScore(de->score())) {
                         Tuplet* t = toTuplet(ee);
-                        if (t->score() == de->score() && t->track() == de->track()) {
+                        if (t->track() == de->track()) {
                             de->setTuplet(t);
                             t->add(de);
                             break;
@@ -3063,7 +3062,7 @@ void Score::cmdDeleteSelection()
             // these are the linked elements we are about to delete
             QList<ScoreElement*> links;
             if (e->links()) {
-                links = *e->links();
+                links = e->links()->elements();
             }
 
             // find location of element to select after deleting notes
@@ -3106,7 +3105,7 @@ void Score::cmdDeleteSelection()
                     } else {
                         QList<ScoreElement*> linkedSpanners;
                         if (spanner->links()) {
-                            linkedSpanners = *spanner->links();
+                            linkedSpanners = spanner->links()->elements();
                         } else {
                             linkedSpanners.append(spanner);
                         }
@@ -4477,6 +4476,151 @@ void Score::undoChangePitch(Note* note, int pitch, int tpc1, int tpc2)
     }
 }
 
+//---------------------------------------------------------
+//   startBatch
+//    Start a batch edit for bulk changes of properties and
+//    pitches. The changes are applied immediately and kept
+//    in a single undo command; the linked elements are
+//    changed once in endBatch(). Properties with side effects
+//    are changed with undoChangeProperty() as usual. A command is started if
+//    none is active, so the score is laid out once at the end.
+//---------------------------------------------------------
+
+void Score::startBatch()
+{
+    if (_batch) {
+        qWarning("batch already active");
+        return;
+    }
+    _batchStartedCmd = !undoStack()->active();
+    if (_batchStartedCmd) {
+        startCmd();
+    }
+    _batch = new ChangeBatch();
+}
+
+//---------------------------------------------------------
+//   isBatchableProperty
+//    properties that undoChangeProperty() only sets, on
+//    elements that don't override it; all the others are
+//    changed with undoChangeProperty() also in a batch
+//---------------------------------------------------------
+
+static bool isBatchableProperty(const ScoreElement* e, Pid id)
+{
+    switch (e->type()) {
+    case ElementType::NOTE:
+    case ElementType::REST:
+    case ElementType::NOTEDOT:
+    case ElementType::ACCIDENTAL:
+    case ElementType::STEM:
+    case ElementType::HOOK:
+    case ElementType::ARTICULATION:
+    case ElementType::MEASURE:
+        break;
+    default:
+        return false;
+    }
+
+    switch (id) {
+    case Pid::COLOR:
+    case Pid::VISIBLE:
+    case Pid::SMALL:
+    case Pid::FIXED:
+    case Pid::FIXED_LINE:
+    case Pid::HEAD_TYPE:
+    case Pid::HEAD_GROUP:
+    case Pid::HEAD_SCHEME:
+    case Pid::VELO_TYPE:
+    case Pid::VELO_OFFSET:
+    case Pid::MIRROR_HEAD:
+    case Pid::DOT_POSITION:
+    case Pid::TUNING:
+    case Pid::GHOST:
+    case Pid::PLAY:
+    case Pid::LEADING_SPACE:
+    case Pid::USER_STRETCH:
+        return true;
+    default:
+        return false;
+    }
+}
+
+//---------------------------------------------------------
+//   batchChangeProperty
+//---------------------------------------------------------
+
+void Score::batchChangeProperty(ScoreElement* e, Pid id, const QVariant& v, PropertyFlags ps)
+{
+    if (!_batch || !isBatchableProperty(e, id)) {
+        e->undoChangeProperty(id, v, ps);
+        return;
+    }
+
+    const QVariant oldValue = e->getProperty(id);
+    const PropertyFlags oldFlags = e->propertyFlags(id);
+    if (oldValue == v && oldFlags == ps) {
+        return;
+    }
+
+    _batch->addProperty(e, id, oldValue, oldFlags);
+    e->setProperty(id, v);
+    e->setPropertyFlags(id, ps);
+
+    // as in ScoreElement::undoChangeProperty()
+    if (id != Pid::GENERATED && e->isElement() && toElement(e)->generated()) {
+        _batch->addProperty(e, Pid::GENERATED, true, e->propertyFlags(Pid::GENERATED));
+        e->setProperty(Pid::GENERATED, false);
+    }
+}
+
+//---------------------------------------------------------
+//   batchChangePitch
+//---------------------------------------------------------
+
+void Score::batchChangePitch(Note* note, int pitch, int tpc1, int tpc2)
+{
+    if (!_batch) {
+        undoChangePitch(note, pitch, tpc1, tpc2);
+        return;
+    }
+
+    if (note->pitch() == pitch && note->tpc1() == tpc1 && note->tpc2() == tpc2) {
+        return;
+    }
+
+    _batch->addPitch(note, note->pitch(), note->tpc1(), note->tpc2());
+    note->setPitch(pitch, tpc1, tpc2);
+    note->triggerLayout();
+}
+
+//---------------------------------------------------------
+//   endBatch
+//---------------------------------------------------------
+
+void Score::endBatch()
+{
+    if (!_batch) {
+        qWarning("no active batch");
+        return;
+    }
+
+    ChangeBatch* batch = _batch;
+    _batch = nullptr;
+
+    batch->applyToLinked();
+    if (batch->empty()) {
+        delete batch;
+    } else {
+        undoStack()->push1(batch);
+    }
+
+    if (_batchStartedCmd) {
+        _batchStartedCmd = false;
+        endCmd();
+    }
+}
+
 //---------------------------------------------------------
 //   undoChangeFretting
 //
@@ -4729,7 +4873,7 @@ static Element* findLinkedVoiceElement(Element* e, Staff* nstaff)
         QList<int> l = de->tracks().values(strack);
         if (l.isEmpty()) {
             // simply return the first linked element whose staff is equal to nstaff
-            for (ScoreElement* ee : e->linkList()) {
+            for (ScoreElement* ee : e->linkedInScore(nstaff->score())) {
                 Element* el = toElement(ee);
                 if (el->staff() == nstaff) {
                     return el;
@@ -4772,7 +4916,7 @@ static Chord* findLinkedChord(Chord* c, Staff* nstaff)
         QList<int> l = de->tracks().values(strack);
         if (l.isEmpty()) {
             // simply return the first linked chord whose staff is equal to nstaff
-            for (ScoreElement* ee : c->linkList()) {
+            for (ScoreElement* ee : c->linkedInScore(nstaff->score())) {
                 Chord* ch = toChord(ee);
                 if (ch->staff() == nstaff) {
                     return ch;
@@ -5814,9 +5958,9 @@ void Score::undoChangeSpannerElements(Spanner* spanner, Element* startElement, E
                 int newTrack = sp->startElement() ? sp->startElement()->track() + startDeltaTrack : sp->track();
                 // look in elements linked to new start element for an element with
                 // same score as linked spanner and appropriate track
-                for (ScoreElement* ee : startElement->linkList()) {
+                for (ScoreElement* ee : startElement->linkedInScore(sp->score())) {
                     Element* e = toElement(ee);
-                    if (e->score() == sp->score() && e->track() == newTrack) {
+                    if (e->track() == newTrack) {
                         newStartElement = e;
                         break;
                     }
@@ -5825,9 +5969,9 @@ void Score::undoChangeSpannerElements(Spanner* spanner, Element* startElement, E
             // similarly to determine the 'parallel' end element
             if (endElement) {
                 int newTrack = sp->endElement() ? sp->endElement()->track() + endDeltaTrack : sp->track2();
-                for (ScoreElement* ee : endElement->linkList()) {
+                for (ScoreElement* ee : endElement->linkedInScore(sp->score())) {
                     Element* e = toElement(ee);
-                    if (e->score() == sp->score() && e->track() == newTrack) {
+                    if (e->track() == newTrack) {
                         newEndElement = e;
                         break;
                     }
@@ -248,6 +248,7 @@ Element::Element(const Element& e)
     _offsetChanged = e._offsetChanged;
     _minDistance   = e._minDistance;
     itemDiscovered = false;
+    paintIndex     = -1;
 
 #ifdef USE_SCORE_ACCESSIBLE_TREE
     m_accessible = e.m_accessible->clone(this);
@@ -1325,24 +1326,22 @@ Element* Element::name2Element(const QStringRef& s, Score* sc)
 
 //---------------------------------------------------------
 //   elementLessThan
+//    bottom to top: by z, then the selected elements over the others
+//    and the visible over the invisible ones, then from the last track
 //---------------------------------------------------------
 
 bool elementLessThan(const Element* const e1, const Element* const e2)
 {
-    if (e1->z() == e2->z()) {
-        if (e1->selected()) {
-            return false;
-        } else if (e2->selected()) {
-            return true;
-        } else if (!e1->visible()) {
-            return true;
-        } else if (!e2->visible()) {
-            return false;
-        } else {
-            return e1->track() > e2->track();
-        }
+    if (e1->z() != e2->z()) {
+        return e1->z() < e2->z();
+    }
+    if (e1->selected() != e2->selected()) {
+        return e2->selected();
+    }
+    if (e1->visible() != e2->visible()) {
+        return e2->visible();
     }
-    return e1->z() <= e2->z();
+    return e1->track() > e2->track();
 }
 
 //---------------------------------------------------------
@@ -1368,26 +1367,19 @@ void paintElement(mu::draw::Painter& painter, const Element* element)
 void paintElements(mu::draw::Painter& painter, const QList<Element*>& elements)
 {
     QList<Ms::Element*> sortedElements = elements;
+    sortElementsForPaint(sortedElements);
 
-    std::sort(sortedElements.begin(), sortedElements.end(), [](Ms::Element* e1, Ms::Element* e2) {
-        if (e1->z() == e2->z()) {
-            if (e1->selected()) {
-                return false;
-            } else if (e2->selected()) {
-                return true;
-            } else if (!e1->visible()) {
-                return true;
-            } else if (!e2->visible()) {
-                return false;
-            }
-
-            return e1->track() > e2->track();
-        }
+    paintSortedElements(painter, sortedElements);
+}
 
-        return e1->z() <= e2->z();
-    });
+//---------------------------------------------------------
+//   paintSortedElements
+//    the elements are in paint order already, e.g. from Page::items()
+//---------------------------------------------------------
 
-    for (const Element* element : sortedElements) {
+void paintSortedElements(mu::draw::Painter& painter, const QList<Element*>& elements)
+{
+    for (const Element* element : elements) {
         if (!element->isInteractionAvailable()) {
             continue;
         }
@@ -1396,6 +1388,16 @@ void paintElements(mu::draw::Painter& painter, const QList<Element*>& elements)
     }
 }
 
+//---------------------------------------------------------
+//   sortElementsForPaint
+//    bottom to top
+//---------------------------------------------------------
+
+void sortElementsForPaint(QList<Element*>& elements)
+{
+    std::sort(elements.begin(), elements.end(), elementLessThan);
+}
+
 //---------------------------------------------------------
 //   autoplace
 //---------------------------------------------------------
@@ -2060,7 +2062,7 @@ bool Element::isUserModified() const
                 return true;
             }
         } else {
-            if (getProperty(pid) != propertyDefault(pid)) {
+            if (val != defaultValue) {
                 return true;
             }
         }
@@ -2809,7 +2811,16 @@ bool Element::selected() const
 
 void Element::setSelected(bool f)
 {
+    const bool changed = selected() != f;
     setFlag(ElementFlag::SELECTED, f);
+
+    // the selected elements are painted over the others,
+    // the page sorts its paint order again once before painting
+    if (changed && paintIndex >= 0) {
+        if (Page* page = toPage(findAncestor(ElementType::PAGE))) {
+            page->invalidatePaintOrderSort();
+        }
+    }
 #ifdef USE_SCORE_ACCESSIBLE_TREE
     if (f) {
         m_accessible->focused();
@@ -476,6 +476,7 @@ public:
     virtual bool mousePress(EditData&) { return false; }
 
     mutable bool itemDiscovered      { false };       ///< helper flag for bsp
+    mutable int paintIndex           { -1 };          ///< helper for Page, position in its paint order
 
     void scanElements(void* data, void (* func)(void*, Element*), bool all=true) override;
 
@@ -665,6 +666,8 @@ extern void collectElements(void* data, Element* e);
 
 extern void paintElement(mu::draw::Painter& painter, const Element* element);
 extern void paintElements(mu::draw::Painter& painter, const QList<Element*>& elements);
+extern void paintSortedElements(mu::draw::Painter& painter, const QList<Element*>& elements);
+extern void sortElementsForPaint(QList<Element*>& elements);
 
 template<typename T> std::shared_ptr<T> makeElement(Ms::Score* score)
 {
@@ -23,6 +23,7 @@
 #include "excerpt.h"
 
 #include <QRegularExpression>
+#include <QXmlStreamWriter>
 
 #include "barline.h"
 #include "beam.h"
@@ -67,7 +68,8 @@ namespace Ms {
 Excerpt::Excerpt(const Excerpt& ex, bool copyPartScore)
     : QObject(), _oscore(ex._oscore), _title(ex._title), _parts(ex._parts), _tracks(ex._tracks)
 {
-    _partScore = (copyPartScore && ex._partScore) ? ex._partScore->clone() : nullptr;
+    Score* partScore = copyPartScore ? ex.partScore() : nullptr;
+    _partScore = partScore ? partScore->clone() : nullptr;
 
     if (_partScore) {
         _partScore->setExcerpt(this);
@@ -83,6 +85,19 @@ Excerpt::~Excerpt()
     delete _partScore;
 }
 
+//---------------------------------------------------------
+//   partScore
+//    a lazily loaded part score is read on first access
+//---------------------------------------------------------
+
+Score* Excerpt::partScore() const
+{
+    if (!isPartScoreLoaded()) {
+        const_cast<Excerpt*>(this)->loadPartScore();
+    }
+    return _partScore;
+}
+
 bool Excerpt::containsPart(const Part* part) const
 {
     for (Part* _part : _parts) {
@@ -109,6 +124,9 @@ int Excerpt::nstaves() const
 
 bool Excerpt::isEmpty() const
 {
+    if (!isPartScoreLoaded()) {
+        return _parts.empty();
+    }
     return partScore() ? partScore()->parts().empty() : true;
 }
 
@@ -128,6 +146,171 @@ void Excerpt::removePart(const QString& id)
     partScore()->undoRemovePart(partScore()->parts().at(index));
 }
 
+//---------------------------------------------------------
+//   readDeferred
+//    keep the <Score> element of a part score unparsed,
+//    only the title, the track list and the linked parts
+//    are picked up on the way
+//---------------------------------------------------------
+
+void Excerpt::readDeferred(XmlReader& e)
+{
+    _masterLinks = e.staffLinkedElements();
+    _partScoreData.clear();
+    _parts.clear();
+    _tracks.clear();
+
+    QXmlStreamWriter writer(&_partScoreData);
+    QString title;
+    int depth = 0;
+    bool titleTag = false;
+    bool linkedToTag = false;
+
+    while (!e.atEnd()) {
+        writer.writeCurrentToken(e);
+        if (e.isStartElement()) {
+            ++depth;
+            const QStringRef& tag(e.name());
+            titleTag = (depth == 2) && (tag == "name");
+            linkedToTag = (depth == 4) && (tag == "linkedTo");
+            if ((depth == 2) && (tag == "Tracklist")) {
+                int strack = e.intAttribute("sTrack",   -1);
+                int dtrack = e.intAttribute("dstTrack", -1);
+                if (strack != -1 && dtrack != -1) {
+                    _tracks.insert(strack, dtrack);
+                }
+            }
+        } else if (e.isEndElement()) {
+            titleTag = false;
+            linkedToTag = false;
+            if (--depth == 0) {
+                break;
+            }
+        } else if (e.isCharacters()) {
+            if (titleTag) {
+                title += e.text();
+            } else if (linkedToTag) {
+                Staff* staff = _oscore->staff(e.text().toInt() - 1);
+                if (staff && !_parts.contains(staff->part())) {
+                    _parts.append(staff->part());
+                }
+            }
+        }
+        e.readNext();
+    }
+    _title = title;
+}
+
+//---------------------------------------------------------
+//   writeDeferred
+//    write a part score not read yet as it was read,
+//    the master score it is linked to is unchanged
+//---------------------------------------------------------
+
+void Excerpt::writeDeferred(XmlWriter& xml) const
+{
+    xml.writeElementData(_partScoreData);
+}
+
+//---------------------------------------------------------
+//   loadPartScore
+//    read, link and layout a part score
+//    kept unparsed by readDeferred()
+//---------------------------------------------------------
+
+void Excerpt::loadPartScore()
+{
+    if (isPartScoreLoaded()) {
+        return;
+    }
+
+    // reset first: reading the part score may access it again
+    QByteArray data;
+    data.swap(_partScoreData);
+    QMap<int, QList<QPair<LinkedElements*, Location> > > masterLinks;
+    masterLinks.swap(_masterLinks);
+
+    ScoreLoad sl;
+    MasterScore* m = _oscore;
+    Score* s = new Score(m, MScore::baseStyle());
+    int defaultsVersion = m->style().defaultStyleVersion();
+    s->setStyle(*MStyle::resolveStyleDefaults(defaultsVersion));
+    s->style().setDefaultStyleVersion(defaultsVersion);
+    setPartScore(s);
+
+    XmlReader e(data);
+    e.setDocName(m->fileInfo()->completeBaseName());
+    e.staffLinkedElements() = masterLinks;
+    if (e.readNextStartElement()) {
+        s->read(e);
+    }
+    s->linkMeasures(m);
+
+    _parts.clear();
+    setTracks(e.tracks());
+    updatePartsFromPartScore();
+
+    s->setPlaylistDirty();
+    s->addLayoutFlags(LayoutFlag::FIX_PITCH_VELO);
+    s->setLayoutAll();
+    s->doLayout();
+}
+
+//---------------------------------------------------------
+//   updatePartsFromPartScore
+//    collect the master score parts the staves of
+//    the part score are linked to
+//---------------------------------------------------------
+
+void Excerpt::updatePartsFromPartScore()
+{
+    Score* score = partScore();
+
+    int nstaves { 1 }; // Initialise to 1 to force writing of the first part.
+    for (Staff* s : score->staves()) {
+        const LinkedElements* ls = s->links();
+        if (ls == 0) {
+            continue;
+        }
+
+        for (auto le : *ls) {
+            if (le->score() != _oscore) {
+                continue;
+            }
+
+            // For instruments with multiple staves, every staff will point to the
+            // same part. To prevent adding the same part several times to the excerpt,
+            // add only the part of the first staff pointing to the part.
+            Staff* ps = toStaff(le);
+            if (!(--nstaves)) {
+                _parts.append(ps->part());
+                nstaves = ps->part()->nstaves();
+            }
+            break;
+        }
+    }
+
+    if (_tracks.isEmpty()) {   // SHOULDN'T HAPPEN, protected in the UI, but it happens during read-in!!!
+        QMultiMap<int, int> tracks;
+        for (Staff* s : score->staves()) {
+            const LinkedElements* ls = s->links();
+            if (ls == 0) {
+                continue;
+            }
+            for (auto le : *ls) {
+                Staff* ps = toStaff(le);
+                if (ps->primaryStaff()) {
+                    for (int i = 0; i < VOICES; i++) {
+                        tracks.insert(ps->idx() * VOICES + i % VOICES, s->idx() * VOICES + i % VOICES);
+                    }
+                    break;
+                }
+            }
+        }
+        _tracks = tracks;
+    }
+}
+
 //---------------------------------------------------------
 //   read
 //---------------------------------------------------------
@@ -203,6 +386,41 @@ bool Excerpt::operator==(const Excerpt& e) const
 //---------------------------------------------------------
 
 void Excerpt::createExcerpt(Excerpt* excerpt)
+{
+    fillPartScore(excerpt);
+
+    MasterScore* oscore = excerpt->oscore();
+    oscore->rebuildMidiMapping();
+    oscore->updateChannel();
+
+    layoutPartScore(excerpt);
+}
+
+//---------------------------------------------------------
+//   layoutPartScore
+//    lay out the part score again after filling it, only its
+//    first maxPages pages if maxPages > 0, see Score::doLayoutPages()
+//---------------------------------------------------------
+
+void Excerpt::layoutPartScore(Excerpt* excerpt, int maxPages)
+{
+    Score* score = excerpt->partScore();
+    score->setPlaylistDirty();
+    score->setLayoutAll();
+    if (maxPages > 0) {
+        score->doLayoutPages(maxPages);
+    } else {
+        score->doLayout();
+    }
+}
+
+//---------------------------------------------------------
+//   fillPartScore
+//    clone the staves of the excerpt into its part score,
+//    layoutPartScore() lays it out again afterwards
+//---------------------------------------------------------
+
+void Excerpt::fillPartScore(Excerpt* excerpt)
 {
     MasterScore* oscore = excerpt->oscore();
     Score* score        = excerpt->partScore();
@@ -363,14 +581,6 @@ void Excerpt::createExcerpt(Excerpt* excerpt)
         //score->spatiumChanged(oscore->spatium(), score->spatium());
         score->styleChanged();
     }
-
-    // second layout of score
-    score->setPlaylistDirty();
-    oscore->rebuildMidiMapping();
-    oscore->updateChannel();
-
-    score->setLayoutAll();
-    score->doLayout();
 }
 
 //---------------------------------------------------------
@@ -432,16 +642,54 @@ void MasterScore::deleteExcerpt(Excerpt* excerpt)
 
 void MasterScore::initExcerpt(Excerpt* excerpt, bool fakeUndo)
 {
-    Score* score = new Score(masterScore());
-    excerpt->setPartScore(score);
-    score->style().set(Sid::createMultiMeasureRests, true);
-    auto excerptCmd = new AddExcerpt(excerpt);
-    if (fakeUndo) {
-        excerptCmd->redo(nullptr);
-    } else {
-        score->undo(excerptCmd);
+    initExcerpts({ excerpt }, fakeUndo);
+}
+
+//---------------------------------------------------------
+//   initExcerpts
+//---------------------------------------------------------
+
+void MasterScore::initExcerpts(const QList<Excerpt*>& excerpts, bool fakeUndo, int layoutPages)
+{
+    if (excerpts.isEmpty()) {
+        return;
+    }
+
+    //! NOTE The part scores are filled one after another, as the cloning links the new elements
+    //! to the ones in this score and records the undo commands here. This score is updated once
+    //! for all of them afterwards, then the part scores are laid out. With layoutPages > 0 only
+    //! their first pages are, the views lay out the others progressively.
+    for (Excerpt* excerpt : excerpts) {
+        Score* score = new Score(masterScore());
+        excerpt->setPartScore(score);
+        score->style().set(Sid::createMultiMeasureRests, true);
+        auto excerptCmd = new AddExcerpt(excerpt);
+        if (fakeUndo) {
+            excerptCmd->redo(nullptr);
+        } else {
+            score->undo(excerptCmd);
+        }
+        Excerpt::fillPartScore(excerpt);
+    }
+
+    rebuildMidiMapping();
+    updateChannel();
+
+    for (Excerpt* excerpt : excerpts) {
+        Excerpt::layoutPartScore(excerpt, layoutPages);
+    }
+}
+
+//---------------------------------------------------------
+//   loadExcerpts
+//    read all part scores kept unparsed on file load
+//---------------------------------------------------------
+
+void MasterScore::loadExcerpts()
+{
+    for (Excerpt* excerpt : excerpts()) {
+        excerpt->loadPartScore();
     }
-    Excerpt::createExcerpt(excerpt);
 }
 
 //---------------------------------------------------------
@@ -468,24 +716,24 @@ static void cloneSpanner(Spanner* s, Score* score, int dstTrack, int dstTrack2)
         ns->setStartElement(0);
         ns->setEndElement(0);
         if (cr1 && cr1->links()) {
-            for (ScoreElement* e : *cr1->links()) {
+            for (ScoreElement* e : cr1->linkedInScore(score)) {
                 ChordRest* cr = toChordRest(e);
                 if (cr == cr1) {
                     continue;
                 }
-                if ((cr->score() == score) && (cr->tick() == ns->tick()) && cr->track() == dstTrack) {
+                if ((cr->tick() == ns->tick()) && cr->track() == dstTrack) {
                     ns->setStartElement(cr);
                     break;
                 }
             }
         }
         if (cr2 && cr2->links()) {
-            for (ScoreElement* e : *cr2->links()) {
+            for (ScoreElement* e : cr2->linkedInScore(score)) {
                 ChordRest* cr = toChordRest(e);
                 if (cr == cr2) {
                     continue;
                 }
-                if ((cr->score() == score) && (cr->tick() == ns->tick2()) && cr->track() == dstTrack2) {
+                if ((cr->tick() == ns->tick2()) && cr->track() == dstTrack2) {
                     ns->setEndElement(cr);
                     break;
                 }
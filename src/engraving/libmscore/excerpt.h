@@ -24,8 +24,10 @@
 #define __EXCERPT_H__
 
 #include <QMultiMap>
+#include <QPair>
 
 #include "fraction.h"
+#include "location.h"
 
 namespace Ms {
 class MasterScore;
@@ -35,6 +37,7 @@ class Measure;
 class XmlWriter;
 class Staff;
 class XmlReader;
+class LinkedElements;
 
 //---------------------------------------------------------
 //   @@ Excerpt
@@ -49,6 +52,11 @@ class Excerpt : public QObject
     QList<Part*> _parts;
     QMultiMap<int, int> _tracks;
 
+    // unparsed <Score> element of a lazily loaded part score,
+    // together with the link targets of the master score
+    QByteArray _partScoreData;
+    QMap<int, QList<QPair<LinkedElements*, Location> > > _masterLinks;
+
 public:
     Excerpt(MasterScore* s = 0) { _oscore = s; }
     Excerpt(const Excerpt& ex, bool copyPartScore = true);
@@ -70,10 +78,15 @@ public:
     void setTracks(const QMultiMap<int, int>& t) { _tracks = t; }
 
     MasterScore* oscore() const { return _oscore; }
-    Score* partScore() const { return _partScore; }
+    Score* partScore() const;
     void setPartScore(Score* s);
+    bool isPartScoreLoaded() const { return _partScoreData.isEmpty(); }
+    void loadPartScore();
 
     void read(XmlReader&);
+    void readDeferred(XmlReader&);
+    void writeDeferred(XmlWriter&) const;
+    void updatePartsFromPartScore();
 
     bool operator!=(const Excerpt&) const;
     bool operator==(const Excerpt&) const;
@@ -85,6 +98,8 @@ public:
     static Excerpt* createExcerptFromPart(Part* part);
 
     static void createExcerpt(Excerpt*);
+    static void fillPartScore(Excerpt*);
+    static void layoutPartScore(Excerpt*, int maxPages = -1);
     static void cloneStaves(Score* oscore, Score* score, const QList<int>& sourceStavesIndexes, QMultiMap<int, int>& allTracks);
     static void cloneStaff(Staff* ostaff, Staff* nstaff);
     static void cloneStaff2(Staff* ostaff, Staff* nstaff, const Fraction& startTick, const Fraction& endTick);
@@ -2150,6 +2150,11 @@ System* Score::getNextSystem(LayoutContext& lc)
     } else {
         system = lc.systemList.takeFirst();
         lc.systemOldMeasure = system->measures().empty() ? 0 : system->measures().back();
+        // elements of the system are deleted while laying it out again,
+        // the page must not refer to them until it is laid out
+        if (system->page()) {
+            system->page()->rebuildBspTree();
+        }
         system->clear();       // remove measures from system
     }
     _systems.append(system);
@@ -5209,7 +5214,7 @@ public:
 //   doLayoutRange
 //---------------------------------------------------------
 
-void Score::doLayoutRange(const Fraction& st, const Fraction& et)
+void Score::doLayoutRange(const Fraction& st, const Fraction& et, int maxPages)
 {
     CmdStateLocker cmdStateLocker(this);
     LayoutContext lc(this);
@@ -5220,11 +5225,14 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
 
     if (!last() || (lineMode() && !firstMeasure())) {
         qDebug("empty score");
+        nextLayoutGeneration();
         qDeleteAll(_systems);
         _systems.clear();
         qDeleteAll(pages());
         pages().clear();
         lc.getNextPage();
+        _pendingLayoutTick = Fraction(-1, 1);
+        _paintDamage.all = true;
         return;
     }
 //      if (!_systems.isEmpty())
@@ -5237,6 +5245,12 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
         etick = last()->endTick();
     }
 
+    if (layoutAll) {
+        _paintDamage.all = true;
+    } else {
+        _paintDamage.addLayoutRange(stick, etick);
+    }
+
     lc.endTick = etick;
     _scoreFont = ScoreFont::fontByName(style().value(Sid::MusicalSymbolFont).toString());
     _noteHeadWidth = _scoreFont->width(SymId::noteheadBlack, spatium() / SPATIUM20);
@@ -5288,6 +5302,7 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
         lc.prevMeasure = 0;
         lc.nextMeasure = m;         //_showVBox ? first() : firstMeasure();
         lc.startTick   = m->tick();
+        _pendingLayoutTick = Fraction(-1, 1);
         layoutLinear(layoutAll, lc);
         return;
     }
@@ -5301,6 +5316,10 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
         }
         lc.curSystem   = system;
         lc.systemList  = _systems.mid(systemIndex);
+        // the first measure is laid out before its system is taken, see getNextSystem()
+        if (lc.page) {
+            lc.page->rebuildBspTree();
+        }
 
         if (systemIndex == 0) {
             lc.nextMeasure = _showVBox ? first() : firstMeasure();
@@ -5355,6 +5374,7 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
                 toMeasure(mb)->mmRest()->setSystem(0);
             }
         }
+        nextLayoutGeneration();
         qDeleteAll(_systems);
         _systems.clear();
 
@@ -5369,7 +5389,38 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
     getNextMeasure(lc);
     lc.curSystem = collectSystem(lc);
 
+    lc.maxPages = maxPages;
     lc.layout();
+
+    if (lc.pageLimitReached) {
+        // the system collected for the next page is not placed,
+        // it is collected again when the layout continues
+        _pendingLayoutTick = lc.curSystem->first()->tick();
+        nextLayoutGeneration();
+        _systems.removeOne(lc.curSystem);
+        delete lc.curSystem;
+        lc.curSystem = nullptr;
+    } else if (layoutAll || !lc.curSystem) {
+        _pendingLayoutTick = Fraction(-1, 1);
+    }
+}
+
+//---------------------------------------------------------
+//   doLayoutPages
+//    progressive layout: lay out at most maxPages pages,
+//    starting at the beginning of the score or where the
+//    previous call stopped
+//    return true if the score is completely laid out
+//---------------------------------------------------------
+
+bool Score::doLayoutPages(int maxPages)
+{
+    if (layoutPending()) {
+        doLayoutRange(_pendingLayoutTick, Fraction(-1, 1), maxPages);
+    } else {
+        doLayoutRange(Fraction(0, 1), Fraction(-1, 1), maxPages);
+    }
+    return !layoutPending();
 }
 
 //---------------------------------------------------------
@@ -5378,6 +5429,7 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
 
 void LayoutContext::layout()
 {
+    const int startPage = curPage;
     MeasureBase* lmb;
     do {
         getNextPage();
@@ -5389,6 +5441,14 @@ void LayoutContext::layout()
             lmb = nullptr;
         }
 
+        // progressive layout: the next system is collected but not placed,
+        // layout continues from its first measure (see Score::doLayoutPages())
+        if (maxPages > 0 && curSystem && (curPage - startPage) >= maxPages
+            && curSystem->first()->tick() > Fraction(0, 1)) {
+            pageLimitReached = true;
+            break;
+        }
+
         // we can stop collecting pages when:
         // 1) we reach the end of score (curSystem is nullptr)
         // or
@@ -5403,6 +5463,9 @@ void LayoutContext::layout()
 
     if (!curSystem) {
         // The end of the score. The remaining systems are not needed...
+        if (!systemList.isEmpty() || score->npages() > curPage) {
+            score->nextLayoutGeneration();
+        }
         qDeleteAll(systemList);
         systemList.clear();
         // ...and the remaining pages too
@@ -117,6 +117,9 @@ struct LayoutContext {
     Fraction startTick;
     Fraction endTick;
 
+    int maxPages             { -1 };      // stop after this many pages, -1 for no limit
+    bool pageLimitReached    { false };
+
     LayoutContext(Score* s);
     LayoutContext(const LayoutContext&) = delete;
     LayoutContext& operator=(const LayoutContext&) = delete;
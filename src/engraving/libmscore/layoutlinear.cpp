@@ -66,6 +66,7 @@ void Score::resetSystems(bool layoutAll, LayoutContext& lc)
                 ss->setParent(0);
             }
         }
+        nextLayoutGeneration();
         qDeleteAll(_systems);
         _systems.clear();
         qDeleteAll(pages());
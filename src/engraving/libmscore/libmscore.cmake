@@ -29,6 +29,8 @@ set(LIBMSCORE_SRC
     ${CMAKE_CURRENT_LIST_DIR}/articulation.h
     ${CMAKE_CURRENT_LIST_DIR}/audio.cpp
     ${CMAKE_CURRENT_LIST_DIR}/audio.h
+    ${CMAKE_CURRENT_LIST_DIR}/autosavejournal.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/autosavejournal.h
     ${CMAKE_CURRENT_LIST_DIR}/bagpembell.cpp
     ${CMAKE_CURRENT_LIST_DIR}/bagpembell.h
     ${CMAKE_CURRENT_LIST_DIR}/barline.cpp
@@ -37,6 +39,8 @@ set(LIBMSCORE_SRC
     ${CMAKE_CURRENT_LIST_DIR}/beam.h
     ${CMAKE_CURRENT_LIST_DIR}/bend.cpp
     ${CMAKE_CURRENT_LIST_DIR}/bend.h
+    ${CMAKE_CURRENT_LIST_DIR}/binaryxml.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/binaryxml.h
     ${CMAKE_CURRENT_LIST_DIR}/box.cpp
     ${CMAKE_CURRENT_LIST_DIR}/box.h
     ${CMAKE_CURRENT_LIST_DIR}/bracket.cpp
@@ -186,6 +190,8 @@ set(LIBMSCORE_SRC
     ${CMAKE_CURRENT_LIST_DIR}/noteentry.cpp
     ${CMAKE_CURRENT_LIST_DIR}/noteevent.cpp
     ${CMAKE_CURRENT_LIST_DIR}/noteevent.h
+    ${CMAKE_CURRENT_LIST_DIR}/notetable.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/notetable.h
     ${CMAKE_CURRENT_LIST_DIR}/note.h
     ${CMAKE_CURRENT_LIST_DIR}/noteline.cpp
     ${CMAKE_CURRENT_LIST_DIR}/noteline.h
@@ -243,6 +249,8 @@ set(LIBMSCORE_SRC
     ${CMAKE_CURRENT_LIST_DIR}/scoreorder.cpp
     ${CMAKE_CURRENT_LIST_DIR}/scoreorder.h
     ${CMAKE_CURRENT_LIST_DIR}/score.h
+    ${CMAKE_CURRENT_LIST_DIR}/scoresnapshot.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/scoresnapshot.h
     ${CMAKE_CURRENT_LIST_DIR}/scoretree.cpp
     ${CMAKE_CURRENT_LIST_DIR}/segment.cpp
     ${CMAKE_CURRENT_LIST_DIR}/segment.h
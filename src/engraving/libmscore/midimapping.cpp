@@ -152,6 +152,9 @@ int MasterScore::getNextFreeDrumMidiMapping()
 void MasterScore::rebuildExcerptsMidiMapping()
 {
     for (Excerpt* ex : excerpts()) {
+        if (!ex->isPartScoreLoaded()) {
+            continue;           // mapping is rebuilt when the part score is read
+        }
         for (Part* p : ex->partScore()->parts()) {
             const Part* masterPart = p->masterPart();
             if (!masterPart->score()->isMaster()) {
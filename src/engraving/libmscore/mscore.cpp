@@ -129,6 +129,7 @@ int MScore::sampleRate  = 44100;
 int MScore::mtcType;
 
 bool MScore::noExcerpts = false;
+bool MScore::lazyExcerpts = true;
 bool MScore::noImages = false;
 bool MScore::pdfPrinting = false;
 bool MScore::svgPrinting = false;
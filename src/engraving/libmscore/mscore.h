@@ -125,6 +125,7 @@ static const int SHADOW_NOTE_LIGHT       = 135;
 static const char mimeSymbolFormat[]      = "application/musescore/symbol";
 static const char mimeSymbolListFormat[]  = "application/musescore/symbollist";
 static const char mimeStaffListFormat[]   = "application/musescore/stafflist";
+static const char mimeStaffListBinaryFormat[] = "application/musescore/stafflist-binary";   // see BinaryXmlReader
 
 static const int VISUAL_STRING_NONE      = -100;      // no ordinal for the visual repres. of string (topmost in TAB
                                                       // varies according to visual order and presence of bass strings)
@@ -417,6 +418,7 @@ public:
     static bool noGui;
 
     static bool noExcerpts;
+    static bool lazyExcerpts;           // read part scores on first access, see Excerpt::readDeferred()
     static bool noImages;
 
     static bool pdfPrinting;
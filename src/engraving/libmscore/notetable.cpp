@@ -0,0 +1,131 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "notetable.h"
+
+#include "chord.h"
+#include "note.h"
+#include "score.h"
+#include "segment.h"
+#include "staff.h"
+
+namespace Ms {
+struct NoteTableRow {
+    Note* note;
+    int tick;
+    int duration;
+    int velocity;
+    unsigned char flags;
+};
+
+//---------------------------------------------------------
+//   appendChord
+//---------------------------------------------------------
+
+static void appendChord(std::vector<NoteTableRow>& rows, Chord* chord, int velocity, unsigned char flags)
+{
+    const int tick = chord->tick().ticks();
+    const int duration = chord->actualTicks().ticks();
+    for (Note* note : chord->notes()) {
+        int noteFlags = flags;
+        if (note->tieFor()) {
+            noteFlags |= NoteTable::TIE_FOR;
+        }
+        if (note->tieBack()) {
+            noteFlags |= NoteTable::TIE_BACK;
+        }
+        rows.push_back({ note, tick, duration, note->customizeVelocity(velocity), static_cast<unsigned char>(noteFlags) });
+    }
+}
+
+//---------------------------------------------------------
+//   NoteTable
+//    the chords are collected in one pass over the segments,
+//    per track, and the tracks are joined afterwards
+//---------------------------------------------------------
+
+NoteTable::NoteTable(Score* score)
+{
+    const int tracks = score->ntracks();
+    std::vector<std::vector<NoteTableRow> > rows(tracks);
+
+    for (Segment* s = score->firstSegment(SegmentType::ChordRest); s; s = s->next1(SegmentType::ChordRest)) {
+        for (int track = 0; track < tracks; ++track) {
+            Element* e = s->element(track);
+            if (!e || !e->isChord()) {
+                continue;
+            }
+            Chord* chord = toChord(e);
+            const int velocity = chord->staff()->velocities().val(chord->tick());
+            for (Chord* grace : chord->graceNotesBefore()) {
+                appendChord(rows[track], grace, velocity, GRACE);
+            }
+            appendChord(rows[track], chord, velocity, 0);
+            for (Chord* grace : chord->graceNotesAfter()) {
+                appendChord(rows[track], grace, velocity, GRACE);
+            }
+        }
+    }
+
+    size_t n = 0;
+    for (const std::vector<NoteTableRow>& trackRows : rows) {
+        n += trackRows.size();
+    }
+    _ticks.reserve(n);
+    _durations.reserve(n);
+    _tracks.reserve(n);
+    _pitches.reserve(n);
+    _tpcs.reserve(n);
+    _velocities.reserve(n);
+    _flags.reserve(n);
+    _notes.reserve(n);
+    _trackStarts.reserve(tracks + 1);
+
+    for (int track = 0; track < tracks; ++track) {
+        _trackStarts.push_back(_notes.size());
+        for (const NoteTableRow& row : rows[track]) {
+            _ticks.push_back(row.tick);
+            _durations.push_back(row.duration);
+            _tracks.push_back(track);
+            _pitches.push_back(row.note->pitch());
+            _tpcs.push_back(row.note->tpc());
+            _velocities.push_back(row.velocity);
+            _flags.push_back(row.flags);
+            _notes.push_back(row.note);
+        }
+    }
+    _trackStarts.push_back(_notes.size());
+}
+
+//---------------------------------------------------------
+//   trackRows
+//    the rows [first, last) of the notes in the track
+//---------------------------------------------------------
+
+std::pair<size_t, size_t> NoteTable::trackRows(int track) const
+{
+    if (track < 0 || track + 1 >= int(_trackStarts.size())) {
+        return { 0, 0 };
+    }
+    return { _trackStarts[track], _trackStarts[track + 1] };
+}
+}
@@ -0,0 +1,85 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __NOTETABLE_H__
+#define __NOTETABLE_H__
+
+#include <utility>
+#include <vector>
+
+namespace Ms {
+class Note;
+class Score;
+
+//---------------------------------------------------------
+//   NoteTable
+//    Read-only table of all notes of a score, kept in
+//    columns for passes over the whole score which only
+//    need the musical data. The rows are sorted by track
+//    and then by tick, grace notes are in the order they
+//    are played. The velocity is the one of the staff
+//    velocity map, customized by the note as in playback.
+//    Use Score::noteTable(), it is cached until the score
+//    is updated after the next edit.
+//---------------------------------------------------------
+
+class NoteTable
+{
+public:
+    enum Flag : unsigned char {
+        TIE_FOR  = 1,
+        TIE_BACK = 2,
+        GRACE    = 4
+    };
+
+    NoteTable() = default;
+    explicit NoteTable(Score* score);
+
+    size_t size() const { return _notes.size(); }
+    bool empty() const { return _notes.empty(); }
+
+    const std::vector<int>& ticks() const { return _ticks; }
+    const std::vector<int>& durations() const { return _durations; }
+    const std::vector<int>& tracks() const { return _tracks; }
+    const std::vector<int>& pitches() const { return _pitches; }
+    const std::vector<int>& tpcs() const { return _tpcs; }
+    const std::vector<int>& velocities() const { return _velocities; }
+    const std::vector<unsigned char>& flags() const { return _flags; }
+
+    //! NOTE The notes are only valid as long as the table itself
+    const std::vector<Note*>& notes() const { return _notes; }
+
+    std::pair<size_t, size_t> trackRows(int track) const;
+
+private:
+    std::vector<int> _ticks;
+    std::vector<int> _durations;
+    std::vector<int> _tracks;
+    std::vector<int> _pitches;
+    std::vector<int> _tpcs;
+    std::vector<int> _velocities;
+    std::vector<unsigned char> _flags;
+    std::vector<Note*> _notes;
+    std::vector<size_t> _trackStarts;     // first row of each track, and the size at the end
+};
+}     // namespace Ms
+#endif
@@ -22,6 +22,8 @@
 
 #include "page.h"
 
+#include <algorithm>
+
 #include <QDateTime>
 
 #include "score.h"
@@ -58,6 +60,8 @@ Page::Page(Score* s)
     : Element(s, ElementFlag::NOT_SELECTABLE), _no(0)
 {
     bspTreeValid = false;
+    paintOrderValid = false;
+    paintOrderSorted = false;
 }
 
 Page::~Page()
@@ -508,6 +512,59 @@ QList<Element*> Page::elements() const
     return el;
 }
 
+//---------------------------------------------------------
+//   paintOrder
+//---------------------------------------------------------
+
+const QList<Element*>& Page::paintOrder() const
+{
+    if (!paintOrderValid) {
+        doRebuildPaintOrder();
+    } else if (!paintOrderSorted) {
+        doSortPaintOrder();
+    }
+    return _paintOrder;
+}
+
+//---------------------------------------------------------
+//   sortInPaintOrder
+//    sort some elements of this page, e.g. from items(),
+//    for painting
+//---------------------------------------------------------
+
+void Page::sortInPaintOrder(QList<Element*>& elements) const
+{
+    paintOrder();
+    std::sort(elements.begin(), elements.end(), [](const Element* e1, const Element* e2) {
+        return e1->paintIndex < e2->paintIndex;
+    });
+}
+
+//---------------------------------------------------------
+//   doRebuildPaintOrder
+//---------------------------------------------------------
+
+void Page::doRebuildPaintOrder() const
+{
+    _paintOrder = elements();
+    paintOrderValid = true;
+    doSortPaintOrder();
+}
+
+//---------------------------------------------------------
+//   doSortPaintOrder
+//---------------------------------------------------------
+
+void Page::doSortPaintOrder() const
+{
+    std::stable_sort(_paintOrder.begin(), _paintOrder.end(), elementLessThan);
+
+    for (int i = 0; i < _paintOrder.size(); ++i) {
+        _paintOrder[i]->paintIndex = i;
+    }
+    paintOrderSorted = true;
+}
+
 //---------------------------------------------------------
 //   tm
 //---------------------------------------------------------
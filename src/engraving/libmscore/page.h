@@ -50,6 +50,12 @@ class Page final : public Element
 #endif
     bool bspTreeValid;
 
+    mutable QList<Element*> _paintOrder;    // the visible elements, bottom to top
+    mutable bool paintOrderValid;
+    mutable bool paintOrderSorted;          // false after a selection change
+    void doRebuildPaintOrder() const;
+    void doSortPaintOrder() const;
+
     QString replaceTextMacros(const QString&) const;
     void drawHeaderFooter(mu::draw::Painter*, int area, const QString&) const;
 
@@ -86,7 +92,10 @@ public:
 
     QList<Element*> items(const mu::RectF& r);
     QList<Element*> items(const mu::PointF& p);
-    void rebuildBspTree() { bspTreeValid = false; }
+    void rebuildBspTree() { bspTreeValid = false; paintOrderValid = false; }
+    const QList<Element*>& paintOrder() const;  ///< elements() in paint order
+    void sortInPaintOrder(QList<Element*>& elements) const;
+    void invalidatePaintOrderSort() { paintOrderSorted = false; }
     mu::PointF pagePos() const override { return mu::PointF(); }       ///< position in page coordinates
     QList<Element*> elements() const;           ///< list of visible elements
     mu::RectF tbbox();                             // tight bounding box, excluding white space
@@ -20,6 +20,8 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <memory>
+
 #include <QMimeData>
 #include <QBuffer>
 
@@ -88,6 +90,28 @@ static void transposeChord(Chord* c, Interval srcTranspose, const Fraction& tick
     }
 }
 
+//---------------------------------------------------------
+//   staffListReader
+//    reads the binary staff list if it was written by this
+//    version, the XML otherwise
+//---------------------------------------------------------
+
+static std::unique_ptr<XmlReader> staffListReader(const QMimeData* ms)
+{
+    if (ms->hasFormat(mimeStaffListBinaryFormat)) {
+        std::unique_ptr<BinaryXmlReader> binary = std::make_unique<BinaryXmlReader>(ms->data(mimeStaffListBinaryFormat));
+        if (binary->isValid()) {
+            return std::make_unique<XmlReader>(std::move(binary));
+        }
+    }
+
+    QByteArray data(ms->data(mimeStaffListFormat));
+    if (MScore::debugMode) {
+        qDebug("paste <%s>", data.data());
+    }
+    return std::make_unique<XmlReader>(data);
+}
+
 //---------------------------------------------------------
 //   pasteStaff
 //    return false if paste fails
@@ -1100,7 +1124,8 @@ void Score::cmdPaste(const QMimeData* ms, MuseScoreView* view, Fraction scale)
                 delete nel;
             }
         }
-    } else if ((_selection.isRange() || _selection.isList()) && ms->hasFormat(mimeStaffListFormat)) {
+    } else if ((_selection.isRange() || _selection.isList())
+               && (ms->hasFormat(mimeStaffListFormat) || ms->hasFormat(mimeStaffListBinaryFormat))) {
         ChordRest* cr = 0;
         if (_selection.isRange()) {
             cr = _selection.firstChordRest();
@@ -1123,13 +1148,9 @@ void Score::cmdPaste(const QMimeData* ms, MuseScoreView* view, Fraction scale)
             MScore::setError(MsError::DEST_TUPLET);
             return;
         } else {
-            QByteArray data(ms->data(mimeStaffListFormat));
-            if (MScore::debugMode) {
-                qDebug("paste <%s>", data.data());
-            }
-            XmlReader e(data);
-            e.setPasteMode(true);
-            if (!pasteStaff(e, cr->segment(), cr->staffIdx(), scale)) {
+            std::unique_ptr<XmlReader> e = staffListReader(ms);
+            e->setPasteMode(true);
+            if (!pasteStaff(*e, cr->segment(), cr->staffIdx(), scale)) {
                 return;
             }
         }
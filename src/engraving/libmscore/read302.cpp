@@ -175,6 +175,10 @@ bool Score::read(XmlReader& e)
         } else if (tag == "Score") {            // recursion
             if (MScore::noExcerpts) {
                 e.skipCurrentElement();
+            } else if (MScore::lazyExcerpts) {
+                Excerpt* ex = new Excerpt(masterScore());
+                ex->readDeferred(e);
+                excerpts().append(ex);
             } else {
                 e.tracks().clear();             // ???
                 MasterScore* m = masterScore();
@@ -45,6 +45,8 @@
 #include "xml.h"
 #include "text.h"
 #include "note.h"
+#include "notetable.h"
+#include "scoresnapshot.h"
 #include "chord.h"
 #include "rest.h"
 #include "slur.h"
@@ -406,6 +408,8 @@ Score::~Score()
 //      qDeleteAll(_pages);         // TODO: check
     _masterScore = 0;
 
+    delete _noteTable;
+
     imageStore.clearUnused();
 
 #ifdef USE_SCORE_ACCESSIBLE_TREE
@@ -413,6 +417,30 @@ Score::~Score()
 #endif
 }
 
+//---------------------------------------------------------
+//   noteTable
+//    built on demand, the table is kept until the score
+//    is updated after an edit
+//---------------------------------------------------------
+
+const NoteTable& Score::noteTable()
+{
+    if (!_noteTable) {
+        _noteTable = new NoteTable(this);
+    }
+    return *_noteTable;
+}
+
+//---------------------------------------------------------
+//   invalidateNoteTable
+//---------------------------------------------------------
+
+void Score::invalidateNoteTable()
+{
+    delete _noteTable;
+    _noteTable = nullptr;
+}
+
 //---------------------------------------------------------
 //   Score::clone
 //         To create excerpt clone to show when changing PageSettings
@@ -732,6 +760,7 @@ void Score::dragPosition(const PointF& p, int* rst, Segment** seg, qreal spacing
 void Score::setShowInvisible(bool v)
 {
     _showInvisible = v;
+    _paintDamage.all = true;
     // BSP tree does not include elements which are not
     // displayed, so we need to refresh it to get
     // invisible elements displayed or properly hidden.
@@ -745,6 +774,7 @@ void Score::setShowInvisible(bool v)
 void Score::setShowUnprintable(bool v)
 {
     _showUnprintable = v;
+    _paintDamage.all = true;
 }
 
 //---------------------------------------------------------
@@ -754,6 +784,7 @@ void Score::setShowUnprintable(bool v)
 void Score::setShowFrames(bool v)
 {
     _showFrames = v;
+    _paintDamage.all = true;
 }
 
 //---------------------------------------------------------
@@ -772,6 +803,7 @@ void Score::setShowPageborders(bool v)
 void Score::setMarkIrregularMeasures(bool v)
 {
     _markIrregularMeasures = v;
+    _paintDamage.all = true;
 }
 
 //---------------------------------------------------------
@@ -2040,51 +2072,7 @@ void Score::setMetaTag(const QString& tag, const QString& val)
 
 void MasterScore::addExcerpt(Excerpt* ex, int index)
 {
-    Score* score = ex->partScore();
-
-    int nstaves { 1 }; // Initialise to 1 to force writing of the first part.
-    for (Staff* s : score->staves()) {
-        const LinkedElements* ls = s->links();
-        if (ls == 0) {
-            continue;
-        }
-
-        for (auto le : *ls) {
-            if (le->score() != this) {
-                continue;
-            }
-
-            // For instruments with multiple staves, every staff will point to the
-            // same part. To prevent adding the same part several times to the excerpt,
-            // add only the part of the first staff pointing to the part.
-            Staff* ps = toStaff(le);
-            if (!(--nstaves)) {
-                ex->parts().append(ps->part());
-                nstaves = ps->part()->nstaves();
-            }
-            break;
-        }
-    }
-
-    if (ex->tracks().isEmpty()) {   // SHOULDN'T HAPPEN, protected in the UI, but it happens during read-in!!!
-        QMultiMap<int, int> tracks;
-        for (Staff* s : score->staves()) {
-            const LinkedElements* ls = s->links();
-            if (ls == 0) {
-                continue;
-            }
-            for (auto le : *ls) {
-                Staff* ps = toStaff(le);
-                if (ps->primaryStaff()) {
-                    for (int i = 0; i < VOICES; i++) {
-                        tracks.insert(ps->idx() * VOICES + i % VOICES, s->idx() * VOICES + i % VOICES);
-                    }
-                    break;
-                }
-            }
-        }
-        ex->setTracks(tracks);
-    }
+    ex->updatePartsFromPartScore();
     excerpts().insert(index < 0 ? excerpts().size() : index, ex);
     setExcerptsChanged(true);
 }
@@ -2858,6 +2846,7 @@ void Score::cmdRemoveStaff(int staffIdx)
 
 void Score::sortStaves(QList<int>& dst)
 {
+    nextLayoutGeneration();
     qDeleteAll(systems());
     systems().clear();    //??
     _parts.clear();
@@ -4100,7 +4089,8 @@ QList<Score*> Score::scoreList()
     Score* root = masterScore();
     scores.append(root);
     for (const Excerpt* ex : root->excerpts()) {
-        if (ex->partScore()) {
+        // part scores which are not read yet have nothing to update
+        if (ex->isPartScoreLoaded() && ex->partScore()) {
             scores.append(ex->partScore());
         }
     }
@@ -5339,6 +5329,57 @@ void MasterScore::removeOmr()
     _omr = 0;
 }
 
+//---------------------------------------------------------
+//   snapshot
+//    shares the chunks of the last snapshot for the
+//    measures not edited since. Nothing is shared while a
+//    command is active, its edits are not known yet.
+//---------------------------------------------------------
+
+std::shared_ptr<const ScoreSnapshot> MasterScore::snapshot(bool shareChunks)
+{
+    const bool active = undoStack()->active();
+    const bool share = shareChunks && !active && !_snapshotOutdated && !prev() && !next();
+
+    std::shared_ptr<const ScoreSnapshot> snapshot = ScoreSnapshot::take(this, share ? _snapshot : nullptr, _snapshotEdits);
+    if (!active) {
+        _snapshot = snapshot;
+        _snapshotEdits.clear();
+        _snapshotOutdated = false;
+    }
+    return snapshot;
+}
+
+//---------------------------------------------------------
+//   addSnapshotEdit
+//    called for every finished command, undo and redo.
+//    The range laid out again is the range edited.
+//---------------------------------------------------------
+
+void MasterScore::addSnapshotEdit(const CmdState& cs)
+{
+    static constexpr size_t MAX_SNAPSHOT_EDITS = 256;
+
+    if (!cs.layoutRange() || cs.startTick() < Fraction(0, 1)) {
+        _snapshotOutdated = true;
+        return;
+    }
+
+    if (_snapshotEdits.size() >= MAX_SNAPSHOT_EDITS) {
+        Fraction start = cs.startTick();
+        Fraction end = cs.endTick();
+        for (const auto& range : _snapshotEdits) {
+            start = std::min(start, range.first);
+            end = std::max(end, range.second);
+        }
+        _snapshotEdits.clear();
+        _snapshotEdits.push_back({ start, end });
+        return;
+    }
+
+    _snapshotEdits.push_back({ cs.startTick(), cs.endTick() });
+}
+
 //---------------------------------------------------------
 //   setName
 //---------------------------------------------------------
@@ -5374,9 +5415,137 @@ QString Score::title() const
 void Score::addRefresh(const mu::RectF& r)
 {
     _updateState.refresh.unite(r);
+    _paintDamage.refresh.unite(r);
     cmdState().setUpdateMode(UpdateMode::Update);
 }
 
+//---------------------------------------------------------
+//   takePaintDamage
+//---------------------------------------------------------
+
+PaintDamage Score::takePaintDamage()
+{
+    PaintDamage damage = _paintDamage;
+    _paintDamage = PaintDamage();
+    return damage;
+}
+
+//---------------------------------------------------------
+//   PaintDamage::addLayoutRange
+//---------------------------------------------------------
+
+void PaintDamage::addLayoutRange(const Fraction& stick, const Fraction& etick)
+{
+    if (startTick < Fraction(0, 1)) {
+        startTick = stick;
+        endTick = etick;
+        return;
+    }
+
+    startTick = qMin(startTick, stick);
+    endTick = qMax(endTick, etick);
+}
+
+//---------------------------------------------------------
+//   systemsBand
+//    the band of the page between the systems around the
+//    given ones, elements like lyrics or dynamics may reach
+//    out of the bounding rects of their systems
+//---------------------------------------------------------
+
+static RectF systemsBand(const Page* page, int first, int last)
+{
+    const QList<System*>& systems = page->systems();
+    first = std::max(first, 0);
+    last = std::min(last, systems.size() - 1);
+
+    const RectF pageRect = page->bbox();
+    qreal top = pageRect.top();
+    qreal bottom = pageRect.bottom();
+    if (first > 0) {
+        const System* system = systems.at(first - 1);
+        top = system->pos().y() + system->bbox().bottom();
+    }
+    if (last + 1 < systems.size()) {
+        const System* system = systems.at(last + 1);
+        bottom = system->pos().y() + system->bbox().top();
+    }
+
+    return RectF(pageRect.left(), top, pageRect.width(), bottom - top);
+}
+
+//---------------------------------------------------------
+//   laidOutSystems
+//    first and last system of the page in the tick range,
+//    -1 if there is none
+//---------------------------------------------------------
+
+static void laidOutSystems(const Page* page, const Fraction& startTick, const Fraction& endTick, int& first, int& last)
+{
+    first = -1;
+    last = -1;
+    if (startTick < Fraction(0, 1)) {
+        return;
+    }
+
+    const QList<System*>& systems = page->systems();
+    for (int i = 0; i < systems.size(); ++i) {
+        const System* system = systems.at(i);
+        if (system->measures().empty()) {
+            continue;
+        }
+        if (system->measures().front()->tick() <= endTick && startTick <= system->measures().back()->endTick()) {
+            first = first < 0 ? i : first;
+            last = i;
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   PaintDamage::pageDamage
+//    what of the page may paint differently, in page
+//    coordinates; null if nothing
+//---------------------------------------------------------
+
+RectF PaintDamage::pageDamage(const QList<Page*>& pages, int pageIdx) const
+{
+    const Page* page = pages.at(pageIdx);
+    if (all) {
+        return page->bbox();
+    }
+
+    RectF damage;
+    int first = -1;
+    int last = -1;
+    laidOutSystems(page, startTick, endTick, first, last);
+    if (first >= 0) {
+        //! NOTE Spanner segments and cross staff beams can change in the systems around the laid out ones
+        damage = systemsBand(page, first - 1, last + 1);
+    }
+
+    //! NOTE Spanners can reach over a page break, so the neighbours of a laid out page are damaged too
+    const int lastSystem = page->systems().size() - 1;
+    if (lastSystem >= 0 && pageIdx > 0) {
+        laidOutSystems(pages.at(pageIdx - 1), startTick, endTick, first, last);
+        if (first >= 0) {
+            damage = damage.united(systemsBand(page, 0, 0));
+        }
+    }
+    if (lastSystem >= 0 && pageIdx + 1 < pages.size()) {
+        laidOutSystems(pages.at(pageIdx + 1), startTick, endTick, first, last);
+        if (first >= 0) {
+            damage = damage.united(systemsBand(page, lastSystem, lastSystem));
+        }
+    }
+
+    const RectF pageRect = page->canvasBoundingRect();
+    if (!refresh.isNull() && refresh.intersects(pageRect)) {
+        damage = damage.united(refresh.intersected(pageRect).translated(-page->pos()));
+    }
+
+    return damage;
+}
+
 //---------------------------------------------------------
 //   staffIdx
 //
@@ -5413,6 +5582,9 @@ Staff* Score::staff(const QString& staffId) const
 void MasterScore::setUpdateAll()
 {
     _cmdState.setUpdateMode(UpdateMode::UpdateAll);
+    for (Score* s : scoreList()) {
+        s->paintDamage().all = true;
+    }
 }
 
 //---------------------------------------------------------
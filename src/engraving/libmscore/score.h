@@ -92,11 +92,13 @@ class Part;
 class RepeatList;
 class Rest;
 class Revisions;
+class ScoreSnapshot;
 class ScoreFont;
 class Segment;
 class Selection;
 class SigEvent;
 class Slur;
+class SnapshotWriter;
 class Spanner;
 class Staff;
 class System;
@@ -111,6 +113,8 @@ class UndoStack;
 class Volta;
 class XmlWriter;
 class Channel;
+class ChangeBatch;
+class NoteTable;
 struct Interval;
 struct TEvent;
 struct LayoutContext;
@@ -351,6 +355,25 @@ public:
     QList<ScoreElement*> _deleteList;
 };
 
+//---------------------------------------------------------
+//   PaintDamage
+//    what may paint differently since it was last taken,
+//    lets views keep the recorded painting of the rest
+//---------------------------------------------------------
+
+class PaintDamage
+{
+public:
+    bool all = false;
+    Fraction startTick { -1, 1 };      ///< laid out range
+    Fraction endTick { -1, 1 };
+    mu::RectF refresh;                 ///< canvas coordinates
+
+    bool empty() const { return !all && startTick < Fraction(0, 1) && refresh.isNull(); }
+    void addLayoutRange(const Fraction& stick, const Fraction& etick);
+    mu::RectF pageDamage(const QList<Page*>& pages, int pageIdx) const;
+};
+
 //---------------------------------------------------------
 //   ScoreContentState
 //---------------------------------------------------------
@@ -470,6 +493,8 @@ private:
     int _pageNumberOffset { 0 };          ///< Offset for page numbers.
 
     UpdateState _updateState;
+    PaintDamage _paintDamage;
+    int _layoutGeneration { 0 };          ///< changes when pages or systems are deleted
 
     MeasureBaseList _measures;            // here are the notes
     QList<Part*> _parts;
@@ -521,7 +546,13 @@ private:
     Audio* _audio { 0 };
     PlayMode _playMode { PlayMode::SYNTHESIZER };
 
+    ChangeBatch* _batch { nullptr };      // active batch edit, see startBatch()
+    bool _batchStartedCmd { false };
+
+    NoteTable* _noteTable { nullptr };    // cached, see noteTable()
+
     qreal _noteHeadWidth { 0.0 };         // cached value
+    Fraction _pendingLayoutTick { -1, 1 };  // start of the part not laid out yet, see doLayoutPages()
     QString accInfo;                      ///< information about selected element(s) for use by screen-readers
     QString accMessage;                   ///< temporary status message for use by screen-readers
 
@@ -552,6 +583,9 @@ private:
     void checkSlurs();
     void checkScore();
 
+    bool transposeSelection(TransposeMode mode, TransposeDirection, Key transposeKey, int transposeInterval, bool trKeys,
+                            bool transposeChordNames, bool useDoubleSharpsFlats);
+
     bool rewriteMeasures(Measure* fm, Measure* lm, const Fraction&, int staffIdx);
     bool rewriteMeasures(Measure* fm, const Fraction& ns, int staffIdx);
     void swingAdjustParams(Chord*, int&, int&, int, int);
@@ -712,6 +746,12 @@ public:
     void undoChangeSpannerElements(Spanner* spanner, Element* startElement, Element* endElement);
     void undoChangeElement(Element* oldElement, Element* newElement);
     void undoChangePitch(Note* note, int pitch, int tpc1, int tpc2);
+
+    void startBatch();
+    void batchChangeProperty(ScoreElement* e, Pid id, const QVariant& v, PropertyFlags ps = PropertyFlags::NOSTYLE);
+    void batchChangePitch(Note* note, int pitch, int tpc1, int tpc2);
+    void endBatch();
+    bool batchActive() const { return _batch != nullptr; }
     void undoChangeFretting(Note* note, int pitch, int string, int fret, int tpc1, int tpc2);
     void spellNotelist(std::vector<Note*>& notes);
     void undoChangeTpc(Note* note, int tpc);
@@ -825,6 +865,10 @@ public:
     virtual inline void addLayoutFlags(LayoutFlags);
     virtual inline void setInstrumentsChanged(bool);
     void addRefresh(const mu::RectF&);
+    PaintDamage& paintDamage() { return _paintDamage; }
+    PaintDamage takePaintDamage();
+    int layoutGeneration() const { return _layoutGeneration; }
+    void nextLayoutGeneration() { ++_layoutGeneration; }
 
     void cmdRelayout();
     void cmdToggleAutoplace(bool all);
@@ -864,7 +908,7 @@ public:
     void setShowInstrumentNames(bool v) { _showInstrumentNames = v; }
     void setShowVBox(bool v) { _showVBox = v; }
 
-    bool writeScore(QIODevice* f, bool msczFormat, bool onlySelection = false);
+    bool writeScore(QIODevice* f, bool msczFormat, bool onlySelection = false, SnapshotWriter* snapshotWriter = nullptr);
     bool writeMscz(mu::engraving::MsczWriter& msczWriter, bool onlySelection = false, bool createThumbnail = true);
     bool writeMscz(const QString& filePath, bool onlySelection = false, bool createThumbnail = true); // to file
     bool writeMscz(QIODevice* device, const QString& fileName, bool onlySelection = false, bool createThumbnail = true); // to device (file or buffer)
@@ -951,9 +995,9 @@ public:
     Spatium  styleS(Sid idx) const { Q_ASSERT(!strcmp(MStyle::valueType(idx), "Ms::Spatium")); return style().value(idx).value<Spatium>(); }
     qreal    styleP(Sid idx) const { Q_ASSERT(!strcmp(MStyle::valueType(idx), "Ms::Spatium")); return style().pvalue(idx); }
     QString  styleSt(Sid idx) const { Q_ASSERT(!strcmp(MStyle::valueType(idx), "QString")); return style().value(idx).toString(); }
-    bool     styleB(Sid idx) const { Q_ASSERT(!strcmp(MStyle::valueType(idx), "bool")); return style().value(idx).toBool(); }
-    qreal    styleD(Sid idx) const { Q_ASSERT(!strcmp(MStyle::valueType(idx), "double")); return style().value(idx).toDouble(); }
-    int      styleI(Sid idx) const { Q_ASSERT(!strcmp(MStyle::valueType(idx), "int")); return style().value(idx).toInt(); }
+    bool     styleB(Sid idx) const { Q_ASSERT(!strcmp(MStyle::valueType(idx), "bool")); return style().boolValue(idx); }
+    qreal    styleD(Sid idx) const { Q_ASSERT(!strcmp(MStyle::valueType(idx), "double")); return style().doubleValue(idx); }
+    int      styleI(Sid idx) const { Q_ASSERT(!strcmp(MStyle::valueType(idx), "int")); return style().intValue(idx); }
 
     void setStyleValue(Sid sid, QVariant value) { style().set(sid, value); }
     QString getTextStyleUserName(Tid tid);
@@ -1121,7 +1165,12 @@ public:
     void removeAudio();
 
     void doLayout();
-    void doLayoutRange(const Fraction&, const Fraction&);
+    void doLayoutRange(const Fraction&, const Fraction&, int maxPages = -1);
+    bool doLayoutPages(int maxPages);
+    bool layoutPending() const { return _pendingLayoutTick >= Fraction(0, 1); }
+
+    const NoteTable& noteTable();
+    void invalidateNoteTable();
     void layoutLinear(bool layoutAll, LayoutContext& lc);
 
     void layoutChords1(Segment* segment, int staffIdx);
@@ -1362,6 +1411,10 @@ class MasterScore : public Score
 
     std::shared_ptr<Avs::AvsOmr> _avsOmr { nullptr };
 
+    std::shared_ptr<const ScoreSnapshot> _snapshot;                   // the next snapshot shares its chunks
+    std::vector<std::pair<Fraction, Fraction> > _snapshotEdits;       // tick ranges edited since, see snapshot()
+    bool _snapshotOutdated  { false };                                // edited outside of tick ranges
+
     Fraction _pos[3];                      ///< 0 - current, 1 - left loop, 2 - right loop
 
     int _midiPortCount      { 0 };                    // A count of ALSA midi out ports
@@ -1462,6 +1515,9 @@ public:
     std::shared_ptr<Avs::AvsOmr> avsOmr() const { return _avsOmr; }
     void setAvsOmr(std::shared_ptr<Avs::AvsOmr> omr) { _avsOmr = omr; }
 
+    std::shared_ptr<const ScoreSnapshot> snapshot(bool shareChunks = true);
+    void addSnapshotEdit(const CmdState& cs);
+
     int midiPortCount() const { return _midiPortCount; }
     void setMidiPortCount(int val) { _midiPortCount = val; }
     std::vector<MidiMapping>& midiMapping() { return _midiMapping; }
@@ -1489,6 +1545,8 @@ public:
     void removeExcerpt(Excerpt*);
     void deleteExcerpt(Excerpt*);
     void initExcerpt(Excerpt*, bool);
+    void initExcerpts(const QList<Excerpt*>&, bool, int layoutPages = -1);
+    void loadExcerpts();
 
     void setPlaybackScore(Score*);
     Score* playbackScore() { return _playbackScore; }
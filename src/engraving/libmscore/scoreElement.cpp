@@ -671,13 +671,47 @@ QList<ScoreElement*> ScoreElement::linkList() const
 {
     QList<ScoreElement*> el;
     if (_links) {
-        el = *_links;
+        el = _links->elements();
     } else {
         el.append(const_cast<ScoreElement*>(this));
     }
     return el;
 }
 
+//---------------------------------------------------------
+//   linkedInScore
+//    the elements linked to this one (including this one)
+//    which belong to the given score
+//---------------------------------------------------------
+
+QList<ScoreElement*> ScoreElement::linkedInScore(const Score* score) const
+{
+    if (_links) {
+        return _links->elementsInScore(score);
+    }
+    QList<ScoreElement*> el;
+    if (_score == score) {
+        el.append(const_cast<ScoreElement*>(this));
+    }
+    return el;
+}
+
+//---------------------------------------------------------
+//   setScore
+//---------------------------------------------------------
+
+void ScoreElement::setScore(Score* s)
+{
+    if (_score == s) {
+        return;
+    }
+    Score* oldScore = _score;
+    _score = s;
+    if (_links) {
+        _links->changeScore(this, oldScore);
+    }
+}
+
 //---------------------------------------------------------
 //   LinkedElements
 //---------------------------------------------------------
@@ -705,6 +739,55 @@ void LinkedElements::setLid(Score* score, int id)
     score->linkId(id);
 }
 
+//---------------------------------------------------------
+//   append
+//---------------------------------------------------------
+
+void LinkedElements::append(ScoreElement* e)
+{
+    QList<ScoreElement*>::append(e);
+    _scoreIndex.insert(e->score(), e);
+}
+
+//---------------------------------------------------------
+//   removeOne
+//---------------------------------------------------------
+
+bool LinkedElements::removeOne(ScoreElement* e)
+{
+    if (!QList<ScoreElement*>::removeOne(e)) {
+        return false;
+    }
+    _scoreIndex.remove(e->score(), e);
+    return true;
+}
+
+//---------------------------------------------------------
+//   changeScore
+//    reindex an element which is moved to another score
+//---------------------------------------------------------
+
+void LinkedElements::changeScore(ScoreElement* e, const Score* oldScore)
+{
+    if (_scoreIndex.remove(oldScore, e)) {
+        _scoreIndex.insert(e->score(), e);
+    }
+}
+
+//---------------------------------------------------------
+//   elementsInScore
+//---------------------------------------------------------
+
+QList<ScoreElement*> LinkedElements::elementsInScore(const Score* score) const
+{
+    QList<ScoreElement*> el;
+    // values() lists the most recently added element first
+    for (auto it = _scoreIndex.find(score); it != _scoreIndex.end() && it.key() == score; ++it) {
+        el.prepend(it.value());
+    }
+    return el;
+}
+
 //---------------------------------------------------------
 //   mainElement
 //    Returns "main" linked element which is expected to
@@ -23,6 +23,8 @@
 #ifndef __SCORE_ELEMENT_H__
 #define __SCORE_ELEMENT_H__
 
+#include <QMultiHash>
+
 #include "types.h"
 #include "style.h"
 
@@ -153,11 +155,14 @@ enum class PropertyFlags : char;
 
 //---------------------------------------------------------
 //   LinkedElements
+//    the list is read-only outside of this class, so that
+//    the score index is kept up to date
 //---------------------------------------------------------
 
-class LinkedElements : public QList<ScoreElement*>
+class LinkedElements : private QList<ScoreElement*>
 {
     int _lid;           // unique id for every linked list
+    QMultiHash<const Score*, ScoreElement*> _scoreIndex;   // the elements by their score
 
 public:
     LinkedElements(Score*);
@@ -167,6 +172,22 @@ public:
     int lid() const { return _lid; }
 
     ScoreElement* mainElement();
+
+    const QList<ScoreElement*>& elements() const { return *this; }
+    QList<ScoreElement*>::const_iterator begin() const { return QList<ScoreElement*>::cbegin(); }
+    QList<ScoreElement*>::const_iterator end() const { return QList<ScoreElement*>::cend(); }
+    ScoreElement* front() const { return QList<ScoreElement*>::front(); }
+    using QList<ScoreElement*>::size;
+    using QList<ScoreElement*>::isEmpty;
+    using QList<ScoreElement*>::empty;
+    using QList<ScoreElement*>::contains;
+
+    void append(ScoreElement* e);
+    void push_back(ScoreElement* e) { append(e); }
+    bool removeOne(ScoreElement* e);
+    void changeScore(ScoreElement* e, const Score* oldScore);
+
+    QList<ScoreElement*> elementsInScore(const Score* score) const;
 };
 
 //---------------------------------------------------------
@@ -240,7 +261,7 @@ public:
 
     Score* score() const { return _score; }
     MasterScore* masterScore() const;
-    virtual void setScore(Score* s) { _score = s; }
+    virtual void setScore(Score* s);
     const char* name() const;
     virtual QString userName() const;
     virtual ElementType type() const = 0;
@@ -251,6 +272,9 @@ public:
 
     virtual void scanElements(void* data, void (* func)(void*, Element*), bool all=true);
 
+    // The property API is QVariant based, a typed value would have to be taken by
+    // every override. Code reading numeric style values in layout should use the
+    // typed Score::styleP/styleB/styleI/styleD instead of styleValue().
     virtual QVariant getProperty(Pid) const = 0;
     virtual bool setProperty(Pid, const QVariant&) = 0;
     virtual QVariant propertyDefault(Pid) const;
@@ -292,6 +316,7 @@ public:
     void writeStyledProperties(XmlWriter&) const;
 
     QList<ScoreElement*> linkList() const;
+    QList<ScoreElement*> linkedInScore(const Score* score) const;
 
     void linkTo(ScoreElement*);
     void unlink();
@@ -51,6 +51,7 @@
 #include "stafftype.h"
 #include "sym.h"
 #include "scoreorder.h"
+#include "scoresnapshot.h"
 
 #include "preferences.h"
 #include "utils.h"
@@ -124,6 +125,12 @@ void Score::writeMovement(XmlWriter& xml, bool selectionOnly)
         }
     }
 
+    SnapshotWriter* snapshotWriter = selectionOnly ? nullptr : xml.snapshotWriter();
+    if (snapshotWriter && unhide) {
+        // the multimeasure rests are laid out again
+        snapshotWriter->invalidate();
+    }
+
     xml.stag(this);
     if (excerpt()) {
         Excerpt* e = excerpt();
@@ -241,6 +248,9 @@ void Score::writeMovement(XmlWriter& xml, bool selectionOnly)
 
     xml.setCurTrack(0);
     xml.setTrackDiff(-staffStart * VOICES);
+    if (snapshotWriter) {
+        snapshotWriter->beginMeasures(xml, this);
+    }
     if (measureStart) {
         for (int staffIdx = staffStart; staffIdx < staffEnd; ++staffIdx) {
             xml.stag(staff(staffIdx), QString("id=\"%1\"").arg(staffIdx + 1 - staffStart));
@@ -260,7 +270,13 @@ void Score::writeMovement(XmlWriter& xml, bool selectionOnly)
                         forceTimeSig = false;
                     }
                 }
+                if (snapshotWriter && snapshotWriter->writeShared(xml, m, staffIdx)) {
+                    continue;
+                }
                 writeMeasure(xml, m, staffIdx, writeSystemElements, forceTimeSig);
+                if (snapshotWriter) {
+                    snapshotWriter->endMeasure(xml, m, staffIdx);
+                }
             }
             xml.etag();
         }
@@ -269,7 +285,9 @@ void Score::writeMovement(XmlWriter& xml, bool selectionOnly)
     if (isMaster()) {
         if (!selectionOnly) {
             for (const Excerpt* excerpt : excerpts()) {
-                if (excerpt->partScore() != this) {
+                if (!excerpt->isPartScoreLoaded()) {
+                    excerpt->writeDeferred(xml);                             // not read since load
+                } else if (excerpt->partScore() != this) {
                     excerpt->partScore()->write(xml, false);                 // recursion
                 }
             }
@@ -645,10 +663,11 @@ bool Score::saveStyle(const QString& name)
 //extern QString revision;
 static QString revision;
 
-bool Score::writeScore(QIODevice* f, bool msczFormat, bool onlySelection)
+bool Score::writeScore(QIODevice* f, bool msczFormat, bool onlySelection, SnapshotWriter* snapshotWriter)
 {
     XmlWriter xml(this, f);
     xml.setWriteOmr(msczFormat);
+    xml.setSnapshotWriter(snapshotWriter);
     xml.header();
 
     xml.stag("museScore version=\"" MSC_VERSION "\"");
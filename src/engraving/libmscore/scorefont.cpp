@@ -21,11 +21,18 @@
  */
 #include "scorefont.h"
 
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonParseError>
+#include <QSaveFile>
 
+#include "config.h"
 #include "log.h"
 
 #include "draw/painter.h"
@@ -54,6 +61,11 @@ std::vector<ScoreFont> ScoreFont::s_scoreFonts {
 
 std::array<uint, size_t(SymId::lastSym) + 1> ScoreFont::s_mainSymCodeTable { { 0 } };
 
+QString ScoreFont::s_metricsCacheDir;
+
+static constexpr quint32 METRICS_CACHE_MAGIC = 0x534d4643; // "SMFC"
+static constexpr qint32 METRICS_CACHE_VERSION = 1;
+
 // =============================================
 // ScoreFont
 // =============================================
@@ -220,6 +232,18 @@ const char* ScoreFont::fallbackTextFont()
     return "Bravura Text";
 }
 
+//---------------------------------------------------------
+//   setMetricsCacheDir
+//    metrics of loaded fonts are kept in this directory,
+//    so that later runs don't have to probe every glyph
+//    and parse metadata.json again; empty disables it
+//---------------------------------------------------------
+
+void ScoreFont::setMetricsCacheDir(const QString& dirPath)
+{
+    s_metricsCacheDir = dirPath;
+}
+
 // =============================================
 // Load
 // =============================================
@@ -238,6 +262,11 @@ void ScoreFont::load()
     m_font.setNoFontMerging(true);
     m_font.setHinting(mu::draw::Font::Hinting::PreferVerticalHinting);
 
+    if (readMetricsCache()) {
+        m_loaded = true;
+        return;
+    }
+
     for (size_t id = 0; id < s_mainSymCodeTable.size(); ++id) {
         uint code = s_mainSymCodeTable[id];
         if (code == 0) {
@@ -269,6 +298,8 @@ void ScoreFont::load()
 
     m_loaded = true;
 
+    writeMetricsCache();
+
 #if 0
     // check for missing symbols
     ScoreFont* fallback = ScoreFont::fallbackFont();
@@ -562,17 +593,201 @@ void ScoreFont::computeMetrics(Sym* sym, int code)
     sym->setAdvance(advance);
 }
 
+// =============================================
+// Metrics cache
+// =============================================
+
+QString ScoreFont::metricsCacheFilePath() const
+{
+    if (s_metricsCacheDir.isEmpty()) {
+        return QString();
+    }
+
+    return s_metricsCacheDir + "/" + m_name.toLower() + ".smufl";
+}
+
+//---------------------------------------------------------
+//   metricsCacheKey
+//    the metrics are computed by this build from the font
+//    file and its metadata, the cache is outdated when
+//    any of them changed
+//---------------------------------------------------------
+
+QString ScoreFont::metricsCacheKey() const
+{
+    QString key = QString("%1-%2-%3").arg(VERSION, MUSESCORE_REVISION, BUILD_NUMBER);
+    for (const QString& path : { m_fontPath + m_filename, m_fontPath + "metadata.json" }) {
+        QFileInfo fileInfo(path);
+        key += QString("|%1|%2|%3").arg(fileInfo.absoluteFilePath()).arg(fileInfo.size())
+               .arg(fileInfo.lastModified().toMSecsSinceEpoch());
+    }
+    return key;
+}
+
+//---------------------------------------------------------
+//   readMetricsCache
+//    the file holds every symbol of the font in SymId order,
+//    followed by the engraving defaults; it is mapped and
+//    read in a single pass
+//---------------------------------------------------------
+
+bool ScoreFont::readMetricsCache()
+{
+    QString filePath = metricsCacheFilePath();
+    if (filePath.isEmpty()) {
+        return false;
+    }
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const uchar* data = file.map(0, file.size());
+    if (!data) {
+        return false;
+    }
+
+    QDataStream in(QByteArray::fromRawData(reinterpret_cast<const char*>(data), int(file.size())));
+    in.setVersion(QDataStream::Qt_5_9);
+
+    quint32 magic = 0;
+    qint32 version = 0;
+    QString key;
+    quint32 symCount = 0;
+    in >> magic >> version >> key >> symCount;
+    if (magic != METRICS_CACHE_MAGIC || version != METRICS_CACHE_VERSION
+        || key != metricsCacheKey()
+        || symCount != m_symbols.size()) {
+        LOGD() << "outdated metrics cache: " << filePath;
+        return false;
+    }
+
+    std::vector<Sym> symbols(m_symbols.size());
+    for (Sym& sym : symbols) {
+        qint32 code = 0;
+        double x = 0, y = 0, w = 0, h = 0, advance = 0;
+        quint8 anchorCount = 0;
+        in >> code >> x >> y >> w >> h >> advance >> anchorCount;
+
+        sym.setCode(code);
+        sym.setBbox(RectF(x, y, w, h));
+        sym.setAdvance(advance);
+
+        for (quint8 i = 0; i < anchorCount; ++i) {
+            quint8 anchorId = 0;
+            double ax = 0, ay = 0;
+            in >> anchorId >> ax >> ay;
+            sym.setSmuflAnchor(SmuflAnchorId(anchorId), PointF(ax, ay));
+        }
+
+        quint16 subSymbolCount = 0;
+        in >> subSymbolCount;
+        if (subSymbolCount) {
+            std::vector<SymId> subSymbolIds(subSymbolCount);
+            for (SymId& subSymbolId : subSymbolIds) {
+                qint32 id = 0;
+                in >> id;
+                subSymbolId = SymId(id);
+            }
+            sym.setSubSymbols(subSymbolIds);
+        }
+    }
+
+    std::list<std::pair<Sid, QVariant> > engravingDefaults;
+    quint32 defaultsCount = 0;
+    in >> defaultsCount;
+    for (quint32 i = 0; i < defaultsCount; ++i) {
+        qint32 sid = 0;
+        double value = 0;
+        in >> sid >> value;
+        engravingDefaults.push_back({ Sid(sid), value });
+    }
+    engravingDefaults.push_back({ Sid::MusicalTextFont, QString("%1 Text").arg(m_family) });
+
+    double textEnclosureThickness = 0;
+    in >> textEnclosureThickness;
+
+    if (in.status() != QDataStream::Ok) {
+        LOGW() << "corrupted metrics cache: " << filePath;
+        return false;
+    }
+
+    m_symbols = std::move(symbols);
+    m_engravingDefaults = std::move(engravingDefaults);
+    m_textEnclosureThickness = textEnclosureThickness;
+
+    return true;
+}
+
+void ScoreFont::writeMetricsCache() const
+{
+    QString filePath = metricsCacheFilePath();
+    if (filePath.isEmpty()) {
+        return;
+    }
+
+    QDir().mkpath(QFileInfo(filePath).absolutePath());
+
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        LOGW() << "failed to write metrics cache: " << filePath;
+        return;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_9);
+    out << METRICS_CACHE_MAGIC << METRICS_CACHE_VERSION
+        << metricsCacheKey()
+        << quint32(m_symbols.size());
+
+    for (const Sym& sym : m_symbols) {
+        const RectF bbox = sym.bbox();
+        out << qint32(sym.code()) << double(bbox.x()) << double(bbox.y()) << double(bbox.width()) << double(bbox.height())
+            << double(sym.advance());
+
+        out << quint8(sym.smuflAnchors().size());
+        for (const auto& anchor : sym.smuflAnchors()) {
+            out << quint8(anchor.first) << double(anchor.second.x()) << double(anchor.second.y());
+        }
+
+        out << quint16(sym.subSymbols().size());
+        for (SymId subSymbolId : sym.subSymbols()) {
+            out << qint32(subSymbolId);
+        }
+    }
+
+    std::vector<std::pair<Sid, double> > defaults;
+    for (const auto& engravingDefault : m_engravingDefaults) {
+        if (engravingDefault.first != Sid::MusicalTextFont) {
+            defaults.push_back({ engravingDefault.first, engravingDefault.second.toDouble() });
+        }
+    }
+
+    out << quint32(defaults.size());
+    for (const auto& engravingDefault : defaults) {
+        out << qint32(engravingDefault.first) << engravingDefault.second;
+    }
+    out << double(m_textEnclosureThickness);
+
+    if (out.status() != QDataStream::Ok || !file.commit()) {
+        LOGW() << "failed to write metrics cache: " << filePath;
+    }
+}
+
 // =============================================
 // Symbol properties
 // =============================================
 
-Sym ScoreFont::sym(SymId id) const
+const Sym& ScoreFont::sym(SymId id) const
 {
+    static const Sym NO_SYM;
+
     size_t index = static_cast<size_t>(id);
     if (index < m_symbols.size()) {
         return m_symbols[index];
     }
-    return Sym();
+    return NO_SYM;
 }
 
 uint ScoreFont::symCode(SymId id) const
@@ -633,13 +848,39 @@ const RectF ScoreFont::bbox(const std::vector<SymId>& s, qreal mag) const
     return bbox(s, SizeF(mag, mag));
 }
 
+//---------------------------------------------------------
+//   bbox
+//    the glyphs of this font are measured by the font
+//    engine in one query, a sequence with fallback or
+//    composed symbols is measured symbol by symbol
+//---------------------------------------------------------
+
 const RectF ScoreFont::bbox(const std::vector<SymId>& s, const SizeF& mag) const
 {
+    std::vector<uint> codes;
+    codes.reserve(s.size());
+    for (SymId id : s) {
+        const Sym& symbol = sym(id);
+        if (!symbol.isValid() || !symbol.subSymbols().empty()) {
+            codes.clear();
+            break;
+        }
+        codes.push_back(uint(symbol.code()));
+    }
+
+    if (!codes.empty()) {
+        const RectF b = fontProvider()->symBBox(m_font, codes, DPI_F);
+        return RectF(b.x() * mag.width(), b.y() * mag.height(), b.width() * mag.width(), b.height() * mag.height());
+    }
+
     RectF r;
-    PointF pos;
+    qreal x = 0.0;
     for (SymId id : s) {
-        r.unite(bbox(id, mag).translated(pos));
-        pos.rx() += advance(id, mag.width());
+        const Sym& symbol = useFallbackFont(id) ? fallbackFont()->sym(id) : sym(id);
+        const RectF b = symbol.bbox();
+        r.unite(RectF(x + b.x() * mag.width(), b.y() * mag.height(),
+                      b.width() * mag.width(), b.height() * mag.height()));
+        x += symbol.advance() * mag.width();
     }
     return r;
 }
@@ -33,6 +33,8 @@ namespace mu::draw {
 class Painter;
 }
 
+class TestScoreFont;
+
 namespace Ms {
 enum class SmuflAnchorId;
 class Sym;
@@ -63,7 +65,9 @@ public:
     static ScoreFont* fallbackFont();
     static const char* fallbackTextFont();
 
-    Sym sym(SymId id) const;
+    static void setMetricsCacheDir(const QString& dirPath);
+
+    const Sym& sym(SymId id) const;
     uint symCode(SymId id) const;
     QString toString(SymId id) const;
 
@@ -93,6 +97,8 @@ public:
     void draw(const std::vector<SymId>&, mu::draw::Painter*, const mu::SizeF& mag, const mu::PointF& pos, qreal scale) const;
 
 private:
+    friend class ::TestScoreFont;
+
     static QJsonObject initGlyphNamesJson();
 
     void load();
@@ -102,6 +108,11 @@ private:
     void loadEngravingDefaults(const QJsonObject& engravingDefaultsObject);
     void computeMetrics(Sym* sym, int code);
 
+    QString metricsCacheFilePath() const;
+    QString metricsCacheKey() const;
+    bool readMetricsCache();
+    void writeMetricsCache() const;
+
     bool m_loaded = false;
     std::vector<Sym> m_symbols;
     mutable mu::draw::Font m_font;
@@ -115,6 +126,7 @@ private:
     double m_textEnclosureThickness = 0;
 
     static std::vector<ScoreFont> s_scoreFonts;
+    static QString s_metricsCacheDir;
     static std::array<uint, size_t(SymId::lastSym) + 1> s_mainSymCodeTable;
 };
 }
@@ -0,0 +1,286 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "scoresnapshot.h"
+
+#include <algorithm>
+
+#include "measure.h"
+#include "score.h"
+#include "xml.h"
+
+namespace Ms {
+//---------------------------------------------------------
+//   mscxData
+//---------------------------------------------------------
+
+QByteArray ScoreSnapshot::mscxData() const
+{
+    int size = 0;
+    for (const std::shared_ptr<const QByteArray>& chunk : _chunks) {
+        size += chunk->size();
+    }
+
+    QByteArray data;
+    data.reserve(size);
+    for (const std::shared_ptr<const QByteArray>& chunk : _chunks) {
+        data.append(*chunk);
+    }
+    return data;
+}
+
+//---------------------------------------------------------
+//   endTick
+//    a multimeasure rest is written with its first measure
+//---------------------------------------------------------
+
+Fraction ScoreSnapshot::endTick(const MeasureBase* m)
+{
+    const Measure* mmRest = m->isMeasure() ? toMeasure(m)->mmRest() : nullptr;
+    return mmRest ? std::max(m->endTick(), mmRest->endTick()) : m->endTick();
+}
+
+//---------------------------------------------------------
+//   isValid
+//    whether the chunk was written for this measure, at
+//    the same position and with the same multimeasure rest,
+//    which layout creates outside of commands
+//---------------------------------------------------------
+
+bool ScoreSnapshot::isValid(const MeasureChunk& chunk, const MeasureBase* m)
+{
+    const Measure* mmRest = m->isMeasure() ? toMeasure(m)->mmRest() : nullptr;
+    return chunk.tick == m->tick()
+           && chunk.ticks == m->ticks()
+           && chunk.mmRest == mmRest
+           && (!mmRest || chunk.mmRestTicks == mmRest->ticks());
+}
+
+//---------------------------------------------------------
+//   take
+//    edited are the tick ranges changed since previous
+//    was taken. A measure which is not valid anymore in
+//    one score is written again in all of them: linked
+//    elements refer to the elements of the same measure
+//    in the other scores.
+//---------------------------------------------------------
+
+ScoreSnapshotPtr ScoreSnapshot::take(MasterScore* score, const Ptr& previous,
+                                     const std::vector<std::pair<Fraction, Fraction> >& edited)
+{
+    std::vector<std::pair<Fraction, Fraction> > ranges = edited;
+    if (previous) {
+        for (Score* s : score->scoreList()) {
+            for (const MeasureBase* m = s->first(); m; m = m->next()) {
+                auto it = previous->_measures.find(MeasureKey(s, m, 0));
+                if (it == previous->_measures.end() || !isValid(it->second, m)) {
+                    ranges.push_back({ m->tick(), endTick(m) });
+                }
+            }
+        }
+    }
+
+    // writing marks the score as saved by this version, which a snapshot must not do
+    const int mscVersion = score->mscVersion();
+    const QString mscoreVersion = score->mscoreVersion();
+    const int mscoreRevision = score->mscoreRevision();
+
+    Ptr snapshot;
+    Ptr base = previous;
+    while (!snapshot) {
+        SnapshotWriter writer(base, ranges);
+        score->writeScore(writer.device(), false, false, &writer);
+        if (writer.restartNeeded()) {
+            base = nullptr;
+        } else {
+            snapshot = writer.finish();
+        }
+    }
+
+    score->setMscVersion(mscVersion);
+    score->setMscoreVersion(mscoreVersion);
+    score->setMscoreRevision(mscoreRevision);
+
+    return snapshot;
+}
+
+//---------------------------------------------------------
+//   SnapshotWriter
+//---------------------------------------------------------
+
+SnapshotWriter::SnapshotWriter(const ScoreSnapshotPtr& previous, const std::vector<std::pair<Fraction, Fraction> >& edited)
+    : _previous(previous), _snapshot(std::make_shared<ScoreSnapshot>())
+{
+    std::vector<std::pair<Fraction, Fraction> > ranges = edited;
+    std::sort(ranges.begin(), ranges.end());
+    for (const auto& range : ranges) {
+        if (!_edited.empty() && range.first <= _edited.back().second) {
+            _edited.back().second = std::max(_edited.back().second, range.second);
+        } else {
+            _edited.push_back(range);
+        }
+    }
+
+    _buffer.setBuffer(&_data);
+    _buffer.open(QIODevice::WriteOnly);
+}
+
+//---------------------------------------------------------
+//   cut
+//    the text written since the last cut
+//---------------------------------------------------------
+
+std::shared_ptr<const QByteArray> SnapshotWriter::cut(XmlWriter* xml)
+{
+    if (xml) {
+        xml->flush();
+    }
+    std::shared_ptr<const QByteArray> chunk = std::make_shared<const QByteArray>(_data.mid(_cutPos));
+    _cutPos = _data.size();
+    return chunk;
+}
+
+//---------------------------------------------------------
+//   isEdited
+//---------------------------------------------------------
+
+bool SnapshotWriter::isEdited(const MeasureBase* m) const
+{
+    const Fraction start = m->tick();
+    const Fraction end = ScoreSnapshot::endTick(m);
+    for (const auto& range : _edited) {
+        if (range.first > end) {
+            break;
+        }
+        if (start <= range.second) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//---------------------------------------------------------
+//   beginMeasures
+//    The text before the first measure of a score holds
+//    its style, parts and staves. If it changed, the
+//    measures may be written differently, so none of the
+//    previous chunks are taken.
+//---------------------------------------------------------
+
+void SnapshotWriter::beginMeasures(XmlWriter& xml, const Score* score)
+{
+    std::shared_ptr<const QByteArray> header = cut(&xml);
+    _snapshot->_chunks.push_back(header);
+    _snapshot->_headers[score] = header;
+
+    if (_previous) {
+        auto it = _previous->_headers.find(score);
+        if (it == _previous->_headers.end() || *it->second != *header) {
+            invalidate();
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   writeShared
+//    takes the chunk of the previous snapshot for the
+//    measure if it was not edited, returns false if the
+//    measure has to be written
+//---------------------------------------------------------
+
+bool SnapshotWriter::writeShared(XmlWriter& xml, const MeasureBase* m, int staffIdx)
+{
+    std::shared_ptr<const QByteArray> text = cut(&xml);
+    if (!text->isEmpty()) {
+        _snapshot->_chunks.push_back(text);
+    }
+
+    if (!_share || !_previous || isEdited(m)) {
+        return false;
+    }
+
+    const ScoreSnapshot::MeasureKey key(m->score(), m, staffIdx);
+    auto it = _previous->_measures.find(key);
+    if (it == _previous->_measures.end() || !ScoreSnapshot::isValid(it->second, m)) {
+        return false;
+    }
+
+    _snapshot->_chunks.push_back(it->second.data);
+    _snapshot->_measures.emplace(key, it->second);
+    ++_snapshot->_sharedMeasureCount;
+    _shared = true;
+
+    // as if the measure had been written
+    xml.setCurTick(m->endTick());
+    return true;
+}
+
+//---------------------------------------------------------
+//   endMeasure
+//    the written measure becomes a chunk of its own
+//---------------------------------------------------------
+
+void SnapshotWriter::endMeasure(XmlWriter& xml, const MeasureBase* m, int staffIdx)
+{
+    const Measure* mmRest = m->isMeasure() ? toMeasure(m)->mmRest() : nullptr;
+
+    ScoreSnapshot::MeasureChunk chunk;
+    chunk.tick = m->tick();
+    chunk.ticks = m->ticks();
+    chunk.mmRest = mmRest;
+    chunk.mmRestTicks = mmRest ? mmRest->ticks() : Fraction(0, 1);
+    chunk.data = cut(&xml);
+
+    _snapshot->_chunks.push_back(chunk.data);
+    _snapshot->_measures[ScoreSnapshot::MeasureKey(m->score(), m, staffIdx)] = chunk;
+}
+
+//---------------------------------------------------------
+//   invalidate
+//    the measures of the score being written can't be
+//    shared. If some were shared already, the snapshot has
+//    to be written again without sharing: the measures of
+//    other scores may refer to them.
+//---------------------------------------------------------
+
+void SnapshotWriter::invalidate()
+{
+    if (_shared) {
+        _restartNeeded = true;
+    }
+    _share = false;
+}
+
+//---------------------------------------------------------
+//   finish
+//    called after the score is written
+//---------------------------------------------------------
+
+ScoreSnapshotPtr SnapshotWriter::finish()
+{
+    std::shared_ptr<const QByteArray> text = cut(nullptr);
+    if (!text->isEmpty()) {
+        _snapshot->_chunks.push_back(text);
+    }
+    return _snapshot;
+}
+}
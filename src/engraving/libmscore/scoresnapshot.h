@@ -0,0 +1,131 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SCORESNAPSHOT_H__
+#define __SCORESNAPSHOT_H__
+
+#include <map>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include <QBuffer>
+#include <QByteArray>
+
+#include "fraction.h"
+
+namespace Ms {
+class MasterScore;
+class Measure;
+class MeasureBase;
+class Score;
+class XmlWriter;
+
+//---------------------------------------------------------
+//   ScoreSnapshot
+//    Immutable copy of a master score and its part scores
+//    in MSCX format. The text is kept in chunks: one per
+//    measure and staff, and the text between them.
+//    A snapshot shares the chunks of the measures which
+//    were not edited since the previous snapshot with it,
+//    so taking it costs about as much as writing the
+//    edited measures. Nothing is changed after a snapshot
+//    is taken, so it can be read on any thread.
+//    Use MasterScore::snapshot(), it knows the edits.
+//---------------------------------------------------------
+
+class ScoreSnapshot
+{
+public:
+    using Ptr = std::shared_ptr<const ScoreSnapshot>;
+
+    QByteArray mscxData() const;
+
+    int chunkCount() const { return int(_chunks.size()); }
+    int sharedMeasureCount() const { return _sharedMeasureCount; }
+
+    static Ptr take(MasterScore* score, const Ptr& previous, const std::vector<std::pair<Fraction, Fraction> >& edited);
+
+private:
+    friend class SnapshotWriter;
+
+    struct MeasureChunk {
+        Fraction tick;
+        Fraction ticks;
+        const Measure* mmRest = nullptr;
+        Fraction mmRestTicks;
+        std::shared_ptr<const QByteArray> data;
+    };
+    using MeasureKey = std::tuple<const Score*, const MeasureBase*, int>;
+
+    static Fraction endTick(const MeasureBase* m);
+    static bool isValid(const MeasureChunk& chunk, const MeasureBase* m);
+
+    std::vector<std::shared_ptr<const QByteArray> > _chunks;     // in document order
+    std::map<MeasureKey, MeasureChunk> _measures;
+    std::map<const Score*, std::shared_ptr<const QByteArray> > _headers;
+    int _sharedMeasureCount = 0;
+};
+
+using ScoreSnapshotPtr = ScoreSnapshot::Ptr;
+
+//---------------------------------------------------------
+//   SnapshotWriter
+//    Cuts the text written by Score::writeScore() into
+//    the chunks of a new snapshot. Score::writeMovement()
+//    asks it for each measure whether the chunk of the
+//    previous snapshot can be taken instead of writing it.
+//---------------------------------------------------------
+
+class SnapshotWriter
+{
+public:
+    SnapshotWriter(const ScoreSnapshotPtr& previous, const std::vector<std::pair<Fraction, Fraction> >& edited);
+
+    QIODevice* device() { return &_buffer; }
+
+    void beginMeasures(XmlWriter& xml, const Score* score);
+    bool writeShared(XmlWriter& xml, const MeasureBase* m, int staffIdx);
+    void endMeasure(XmlWriter& xml, const MeasureBase* m, int staffIdx);
+    void invalidate();
+
+    bool restartNeeded() const { return _restartNeeded; }
+    ScoreSnapshotPtr finish();
+
+private:
+    std::shared_ptr<const QByteArray> cut(XmlWriter* xml);
+    bool isEdited(const MeasureBase* m) const;
+
+    ScoreSnapshotPtr _previous;
+    std::vector<std::pair<Fraction, Fraction> > _edited;       // sorted, not overlapping
+
+    QByteArray _data;
+    QBuffer _buffer;
+    int _cutPos = 0;
+
+    std::shared_ptr<ScoreSnapshot> _snapshot;
+    bool _share = true;
+    bool _shared = false;
+    bool _restartNeeded = false;
+};
+}     // namespace Ms
+#endif
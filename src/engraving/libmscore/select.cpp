@@ -25,6 +25,8 @@
  Implementation of class Selection plus other selection related functions.
 */
 
+#include <array>
+
 #include <QBuffer>
 
 #include "log.h"
@@ -504,14 +506,10 @@ bool SelectionFilter::canSelectVoice(int track) const
 //   appendFiltered
 //---------------------------------------------------------
 
-void Selection::appendFiltered(Element* e)
+void Selection::appendFiltered(QList<Element*>& list, Element* e, const SelectionFilter& filter)
 {
-    IF_ASSERT_FAILED(!isLocked()) {
-        LOGE() << "selection locked, reason: " << lockReason();
-        return;
-    }
-    if (selectionFilter().canSelect(e)) {
-        _el.append(e);
+    if (filter.canSelect(e)) {
+        list.append(e);
     }
 }
 
@@ -519,48 +517,46 @@ void Selection::appendFiltered(Element* e)
 //   appendChord
 //---------------------------------------------------------
 
-void Selection::appendChord(Chord* chord)
+void Selection::appendChord(QList<Element*>& list, Chord* chord, const SelectionFilter& filter, const Fraction& tickEnd,
+                            QSet<const Beam*>& beams)
 {
-    IF_ASSERT_FAILED(!isLocked()) {
-        LOGE() << "selection locked, reason: " << lockReason();
-        return;
-    }
-    if (chord->beam() && !_el.contains(chord->beam())) {
-        _el.append(chord->beam());
+    if (chord->beam() && !beams.contains(chord->beam())) {
+        beams.insert(chord->beam());
+        list.append(chord->beam());
     }
     if (chord->stem()) {
-        _el.append(chord->stem());
+        list.append(chord->stem());
     }
     if (chord->hook()) {
-        _el.append(chord->hook());
+        list.append(chord->hook());
     }
     if (chord->arpeggio()) {
-        appendFiltered(chord->arpeggio());
+        appendFiltered(list, chord->arpeggio(), filter);
     }
     if (chord->stemSlash()) {
-        _el.append(chord->stemSlash());
+        list.append(chord->stemSlash());
     }
     if (chord->tremolo()) {
-        appendFiltered(chord->tremolo());
+        appendFiltered(list, chord->tremolo(), filter);
     }
     for (Note* note : chord->notes()) {
-        _el.append(note);
+        list.append(note);
         if (note->accidental()) {
-            _el.append(note->accidental());
+            list.append(note->accidental());
         }
         foreach (Element* el, note->el()) {
-            appendFiltered(el);
+            appendFiltered(list, el, filter);
         }
         for (NoteDot* dot : note->dots()) {
-            _el.append(dot);
+            list.append(dot);
         }
 
         if (note->tieFor() && (note->tieFor()->endElement() != 0)) {
             if (note->tieFor()->endElement()->isNote()) {
                 Note* endNote = toNote(note->tieFor()->endElement());
                 Segment* s = endNote->chord()->segment();
-                if (s->tick() < tickEnd()) {
-                    _el.append(note->tieFor());
+                if (s->tick() < tickEnd) {
+                    list.append(note->tieFor());
                 }
             }
         }
@@ -568,8 +564,8 @@ void Selection::appendChord(Chord* chord)
             if (sp->endElement()->isNote()) {
                 Note* endNote = toNote(sp->endElement());
                 Segment* s = endNote->chord()->segment();
-                if (s->tick() < tickEnd()) {
-                    _el.append(sp);
+                if (s->tick() < tickEnd) {
+                    list.append(sp);
                 }
             }
         }
@@ -631,56 +627,73 @@ void Selection::updateSelectedElements()
     int startTrack = _staffStart * VOICES;
     int endTrack   = _staffEnd * VOICES;
 
+    const SelectionFilter filter = selectionFilter();
+    const Fraction stick = startSegment() ? startSegment()->tick() : Fraction(0, 1);
+    const Fraction etick = tickEnd();
+
+    //! NOTE The segments are visited once for all the tracks, the elements are collected per track
+    //! and joined in track order afterwards, so they are listed in the same order as by a track-major walk
+    std::vector<QList<Element*> > trackElements(endTrack - startTrack);
+    std::vector<int> tracks;
     for (int st = startTrack; st < endTrack; ++st) {
-        if (!canSelectVoice(st)) {
+        if (canSelectVoice(st)) {
+            tracks.push_back(st);
+        }
+    }
+    QSet<const Beam*> beams;
+
+    for (Segment* s = tracks.empty() ? nullptr : _startSegment; s && (s != _endSegment); s = s->next1MM()) {
+        if (!s->enabled() || s->isEndBarLineType()) {      // do not select end bar line
             continue;
         }
-        for (Segment* s = _startSegment; s && (s != _endSegment); s = s->next1MM()) {
-            if (!s->enabled() || s->isEndBarLineType()) {      // do not select end bar line
+        for (Element* e : s->annotations()) {
+            const int track = e->track();
+            if (track < startTrack || track >= endTrack || !filter.canSelectVoice(track)) {
                 continue;
             }
-            for (Element* e : s->annotations()) {
-                if (e->track() != st) {
-                    continue;
-                }
-                appendFiltered(e);
-            }
+            appendFiltered(trackElements[track - startTrack], e, filter);
+        }
+        for (int st : tracks) {
             Element* e = s->element(st);
             if (!e || e->generated() || e->isTimeSig() || e->isKeySig()) {
                 continue;
             }
+            QList<Element*>& list = trackElements[st - startTrack];
             if (e->isChordRest()) {
                 ChordRest* cr = toChordRest(e);
                 for (Element* el : cr->lyrics()) {
                     if (el) {
-                        appendFiltered(el);
+                        appendFiltered(list, el, filter);
                     }
                 }
             }
             if (e->isChord()) {
                 Chord* chord = toChord(e);
                 for (Chord* graceNote : chord->graceNotes()) {
-                    if (canSelect(graceNote)) {
-                        appendChord(graceNote);
+                    if (filter.canSelect(graceNote)) {
+                        appendChord(list, graceNote, filter, etick, beams);
                     }
                 }
-                appendChord(chord);
+                appendChord(list, chord, filter, etick, beams);
                 for (Articulation* art : chord->articulations()) {
-                    appendFiltered(art);
+                    appendFiltered(list, art, filter);
                 }
             } else {
-                appendFiltered(e);
+                appendFiltered(list, e, filter);
                 if (e->isRest()) {
                     Rest* r = toRest(e);
                     for (int i = 0; i < r->dots(); ++i) {
-                        appendFiltered(r->dot(i));
+                        appendFiltered(list, r->dot(i), filter);
                     }
                 }
             }
         }
     }
-    Fraction stick = startSegment()->tick();
-    Fraction etick = tickEnd();
+
+    for (const QList<Element*>& list : trackElements) {
+        _el.append(list);
+    }
+
 
     for (auto i = _score->spanner().begin(); i != _score->spanner().end(); ++i) {
         Spanner* sp = (*i).second;
@@ -701,12 +714,12 @@ void Selection::updateSelectedElements()
                 continue;
             }
             if ((sp->tick() >= stick && sp->tick() < etick) || (sp->tick2() >= stick && sp->tick2() < etick)) {
-                if (canSelect(sp->startCR()) && canSelect(sp->endCR())) {
-                    appendFiltered(sp);               // slur with start or end in range selection
+                if (filter.canSelect(sp->startCR()) && filter.canSelect(sp->endCR())) {
+                    appendFiltered(_el, sp, filter);               // slur with start or end in range selection
                 }
             }
         } else if ((sp->tick() >= stick && sp->tick() < etick) && (sp->tick2() >= stick && sp->tick2() <= etick)) {
-            appendFiltered(sp);       // spanner with start and end in range selection
+            appendFiltered(_el, sp, filter);       // spanner with start and end in range selection
         }
     }
     update();
@@ -862,41 +875,36 @@ QByteArray Selection::mimeData() const
 }
 
 //---------------------------------------------------------
-//   hasElementInTrack
+//   firstElementTicks
+//    tick of the first element in each voice of a staff,
+//    -1 for the voices without elements
 //---------------------------------------------------------
 
-bool hasElementInTrack(Segment* startSeg, Segment* endSeg, int track)
+static std::array<Fraction, VOICES> firstElementTicks(Segment* startSeg, Segment* endSeg, int startTrack)
 {
-    for (Segment* seg = startSeg; seg != endSeg; seg = seg->next1MM()) {
+    std::array<Fraction, VOICES> ticks;
+    ticks.fill(Fraction(-1, 1));
+    int missing = VOICES;
+    for (Segment* seg = startSeg; seg != endSeg && missing > 0; seg = seg->next1MM()) {
         if (!seg->enabled()) {
             continue;
         }
-        if (seg->element(track)) {
-            return true;
-        }
-    }
-    return false;
-}
-
-//---------------------------------------------------------
-//   firstElementInTrack
-//---------------------------------------------------------
-
-static Fraction firstElementInTrack(Segment* startSeg, Segment* endSeg, int track)
-{
-    for (Segment* seg = startSeg; seg != endSeg; seg = seg->next1MM()) {
-        if (!seg->enabled()) {
-            continue;
-        }
-        if (seg->element(track)) {
-            return seg->tick();
+        for (int voice = 0; voice < VOICES; ++voice) {
+            if (ticks[voice] == Fraction(-1, 1) && seg->element(startTrack + voice)) {
+                ticks[voice] = seg->tick();
+                --missing;
+            }
         }
     }
-    return Fraction(-1, 1);
+    return ticks;
 }
 
 //---------------------------------------------------------
 //   staffMimeData
+//    the staff list is XML: Score::pasteStaff() reads it
+//    with the element readers, from the binary form made
+//    by BinaryXmlReader::fromXml() in the same version.
+//    See the copy and paste benchmarks in tst_copypaste.
 //---------------------------------------------------------
 
 QByteArray Selection::staffMimeData() const
@@ -939,10 +947,10 @@ QByteArray Selection::staffMimeData() const
             xml.tag("transposeDiatonic", interval.diatonic);
         }
         xml.stag("voiceOffset");
+        const std::array<Fraction, VOICES> firstTicks = firstElementTicks(seg1, seg2, startTrack);
         for (int voice = 0; voice < VOICES; voice++) {
-            if (hasElementInTrack(seg1, seg2, startTrack + voice)
-                && xml.canWriteVoice(voice)) {
-                Fraction offset = firstElementInTrack(seg1, seg2, startTrack + voice) - tickStart();
+            if (firstTicks[voice] != Fraction(-1, 1) && xml.canWriteVoice(voice)) {
+                Fraction offset = firstTicks[voice] - tickStart();
                 xml.tag(QString("voice id=\"%1\"").arg(voice), offset.ticks());
             }
         }
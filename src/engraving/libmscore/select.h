@@ -23,6 +23,8 @@
 #ifndef __SELECT_H__
 #define __SELECT_H__
 
+#include <QSet>
+
 #include "pitchspelling.h"
 #include "mscore.h"
 #include "durationtype.h"
@@ -37,6 +39,7 @@ class Segment;
 class Note;
 class Measure;
 class Chord;
+class Beam;
 
 //---------------------------------------------------------
 //   ElementPattern
@@ -178,8 +181,9 @@ class Selection
     SelectionFilter selectionFilter() const;
     bool canSelect(Element* e) const { return selectionFilter().canSelect(e); }
     bool canSelectVoice(int track) const { return selectionFilter().canSelectVoice(track); }
-    void appendFiltered(Element* e);
-    void appendChord(Chord* chord);
+    static void appendFiltered(QList<Element*>& list, Element* e, const SelectionFilter& filter);
+    static void appendChord(QList<Element*>& list, Chord* chord, const SelectionFilter& filter, const Fraction& tickEnd,
+                            QSet<const Beam*>& beams);
 
 public:
     Selection() { _score = 0; _state = SelState::NONE; }
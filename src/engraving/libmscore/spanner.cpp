@@ -790,8 +790,8 @@ Note* Spanner::startElementFromSpanner(Spanner* sp, Element* newEnd)
     int newTrack    = (newEnd->track() - oldEnd->track()) + oldStart->track();
     // look in notes linked to oldStart for a note with the
     // same score as new score and appropriate track
-    for (ScoreElement* newEl : oldStart->linkList()) {
-        if (toNote(newEl)->score() == score && toNote(newEl)->track() == newTrack) {
+    for (ScoreElement* newEl : oldStart->linkedInScore(score)) {
+        if (toNote(newEl)->track() == newTrack) {
             newStart = toNote(newEl);
             break;
         }
@@ -826,8 +826,8 @@ Note* Spanner::endElementFromSpanner(Spanner* sp, Element* newStart)
     int newTrack    = newStart->track() + (oldEnd->track() - oldStart->track());
     // look in notes linked to oldEnd for a note with the
     // same score as new score and appropriate track
-    for (ScoreElement* newEl : oldEnd->linkList()) {
-        if (toNote(newEl)->score() == score && toNote(newEl)->track() == newTrack) {
+    for (ScoreElement* newEl : oldEnd->linkedInScore(score)) {
+        if (toNote(newEl)->track() == newTrack) {
             newEnd = toNote(newEl);
             break;
         }
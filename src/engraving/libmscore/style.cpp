@@ -2753,6 +2753,31 @@ MStyle::MStyle()
     for (const StyleType& t : styleTypes) {
         _values[t.idx()] = t.defaultValue();
     }
+    precomputeValues();
+}
+
+//---------------------------------------------------------
+//   precomputeValue
+//    spatium values are kept in raster units, double, int
+//    and bool values unboxed, so reading them does not need
+//    a QVariant conversion
+//---------------------------------------------------------
+
+void MStyle::precomputeValue(int idx, qreal spatium)
+{
+    const char* type = styleTypes[idx].valueType();
+    const QVariant& val = _values[idx];
+    if (!strcmp(type, "Ms::Spatium")) {
+        _precomputedValues[idx] = val.value<Spatium>().val() * spatium;
+    } else if (!strcmp(type, "double")) {
+        _precomputedValues[idx] = val.toDouble();
+    } else if (!strcmp(type, "int")) {
+        _precomputedValues[idx] = val.toInt();
+    } else if (!strcmp(type, "bool")) {
+        _precomputedValues[idx] = val.toBool() ? 1.0 : 0.0;
+    } else {
+        _precomputedValues[idx] = 0.0;
+    }
 }
 
 //---------------------------------------------------------
@@ -2763,9 +2788,7 @@ void MStyle::precomputeValues()
 {
     qreal _spatium = value(Sid::spatium).toDouble();
     for (const StyleType& t : styleTypes) {
-        if (!strcmp(t.valueType(), "Ms::Spatium")) {
-            _precomputedValues[t.idx()] = _values[t.idx()].value<Spatium>().val() * _spatium;
-        }
+        precomputeValue(t.idx(), _spatium);
     }
 }
 
@@ -2842,10 +2865,7 @@ void MStyle::set(const Sid t, const QVariant& val)
     if (t == Sid::spatium) {
         precomputeValues();
     } else {
-        if (!strcmp(styleTypes[idx].valueType(), "Ms::Spatium")) {
-            qreal _spatium = value(Sid::spatium).toDouble();
-            _precomputedValues[idx] = _values[idx].value<Spatium>().val() * _spatium;
-        }
+        precomputeValue(idx, value(Sid::spatium).toDouble());
     }
 }
 
@@ -3113,6 +3133,7 @@ void MStyle::applyNewDefaults(const MStyle& other, const int defaultsVersion)
             _values.at(st.idx()) = other.value(st.styleIdx());
         }
     }
+    precomputeValues();
 }
 
 //---------------------------------------------------------
@@ -1483,12 +1483,17 @@ class MStyle
     bool _customChordList;          // if true, chordlist will be saved as part of score
     int _defaultStyleVersion = -1;
 
+    void precomputeValue(int idx, qreal spatium);
+
 public:
     MStyle();
 
     void precomputeValues();
     const QVariant& value(Sid idx) const;
     qreal pvalue(Sid idx) const { return _precomputedValues[int(idx)]; }
+    bool boolValue(Sid idx) const { return _precomputedValues[int(idx)] != 0.0; }
+    int intValue(Sid idx) const { return int(_precomputedValues[int(idx)]); }
+    qreal doubleValue(Sid idx) const { return _precomputedValues[int(idx)]; }
     void set(Sid idx, const QVariant& v);
     void set(Sid idx, const mu::PointF& v);
 
@@ -130,9 +130,10 @@ void Sym::setAdvance(qreal val)
     m_advance = val;
 }
 
-PointF Sym::smuflAnchor(SmuflAnchorId anchorId)
+PointF Sym::smuflAnchor(SmuflAnchorId anchorId) const
 {
-    return m_smuflAnchors[anchorId];
+    auto it = m_smuflAnchors.find(anchorId);
+    return it != m_smuflAnchors.end() ? it->second : PointF();
 }
 
 void Sym::setSmuflAnchor(SmuflAnchorId anchorId, const PointF& newValue)
@@ -140,6 +141,11 @@ void Sym::setSmuflAnchor(SmuflAnchorId anchorId, const PointF& newValue)
     m_smuflAnchors[anchorId] = newValue;
 }
 
+const std::map<SmuflAnchorId, PointF>& Sym::smuflAnchors() const
+{
+    return m_smuflAnchors;
+}
+
 // =============================================
 // Name <-> SymId conversions
 // =============================================
@@ -67,8 +67,9 @@ public:
     qreal advance() const;
     void setAdvance(qreal val);
 
-    mu::PointF smuflAnchor(SmuflAnchorId anchorId);
+    mu::PointF smuflAnchor(SmuflAnchorId anchorId) const;
     void setSmuflAnchor(SmuflAnchorId anchorId, const mu::PointF& newValue);
+    const std::map<SmuflAnchorId, mu::PointF>& smuflAnchors() const;
 
     static SymId name2id(const QString& s); // return noSym if not found
     static SymId oldName2id(const QString s);
@@ -20,6 +20,8 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <array>
+
 #include "utils.h"
 #include "score.h"
 #include "pitchspelling.h"
@@ -239,6 +241,48 @@ int transposeTpcDiatonicByKey(int tpc, int steps, Key key, bool keepAlteredDegre
     return newTpc;
 }
 
+//---------------------------------------------------------
+//   TpcTransposition
+//    transposeTpc() of every spelling for one interval,
+//    computed once when many notes are transposed by it
+//---------------------------------------------------------
+
+class TpcTransposition
+{
+public:
+    TpcTransposition(Interval interval, bool useDoubleSharpsFlats)
+    {
+        for (int tpc = Tpc::TPC_MIN; tpc <= Tpc::TPC_MAX; ++tpc) {
+            _tpcs[tpc - Tpc::TPC_MIN] = transposeTpc(tpc, interval, useDoubleSharpsFlats);
+        }
+    }
+
+    int operator()(int tpc) const
+    {
+        return tpcIsValid(tpc) ? _tpcs[tpc - Tpc::TPC_MIN] : tpc;
+    }
+
+private:
+    std::array<int, Tpc::TPC_MAX - Tpc::TPC_MIN + 1> _tpcs;
+};
+
+//---------------------------------------------------------
+//   transposeNote
+//    return false on failure
+//---------------------------------------------------------
+
+static bool transposeNote(Score* score, Note* n, const Interval& interval, const TpcTransposition& tpcTransposition)
+{
+    const int npitch = n->pitch() + interval.chromatic;
+    if (npitch > 127) {
+        return false;
+    }
+    const int ntpc1 = tpcTransposition(n->tpc1());
+    const int ntpc2 = n->transposition() ? tpcTransposition(n->tpc2()) : ntpc1;
+    score->batchChangePitch(n, npitch, ntpc1, ntpc2);
+    return true;
+}
+
 //---------------------------------------------------------
 //   transpose
 //    return false on failure
@@ -258,17 +302,38 @@ bool Score::transpose(Note* n, Interval interval, bool useDoubleSharpsFlats)
     if (npitch > 127) {
         return false;
     }
-    undoChangePitch(n, npitch, ntpc1, ntpc2);
+    batchChangePitch(n, npitch, ntpc1, ntpc2);
     return true;
 }
 
 //---------------------------------------------------------
 //   transpose
+//    The notes are changed in one batch edit, so they are
+//    kept in a single undo command and their linked notes
+//    are changed once at the end.
 //    return false on failure
 //---------------------------------------------------------
 
 bool Score::transpose(TransposeMode mode, TransposeDirection direction, Key trKey,
                       int transposeInterval, bool trKeys, bool transposeChordNames, bool useDoubleSharpsFlats)
+{
+    const bool startsBatch = !batchActive();
+    if (startsBatch) {
+        startBatch();
+    }
+    bool result = transposeSelection(mode, direction, trKey, transposeInterval, trKeys, transposeChordNames, useDoubleSharpsFlats);
+    if (startsBatch) {
+        endBatch();
+    }
+    return result;
+}
+
+//---------------------------------------------------------
+//   transposeSelection
+//---------------------------------------------------------
+
+bool Score::transposeSelection(TransposeMode mode, TransposeDirection direction, Key trKey,
+                               int transposeInterval, bool trKeys, bool transposeChordNames, bool useDoubleSharpsFlats)
 {
     bool rangeSelection = selection().isRange();
     int startStaffIdx   = 0;
@@ -335,6 +400,8 @@ bool Score::transpose(TransposeMode mode, TransposeDirection direction, Key trKe
         }
     }
 
+    const TpcTransposition tpcTransposition(interval, useDoubleSharpsFlats);
+
     if (_selection.isList()) {
         foreach (Element* e, _selection.uniqueElements()) {
             if (!e->staff() || e->staff()->staffType(e->tick())->group() == StaffGroup::PERCUSSION) {
@@ -345,7 +412,7 @@ bool Score::transpose(TransposeMode mode, TransposeDirection direction, Key trKe
                 if (mode == TransposeMode::DIATONICALLY) {
                     note->transposeDiatonic(transposeInterval, trKeys, useDoubleSharpsFlats);
                 } else {
-                    if (!transpose(note, interval, useDoubleSharpsFlats)) {
+                    if (!transposeNote(this, note, interval, tpcTransposition)) {
                         return false;
                     }
                 }
@@ -449,7 +516,7 @@ bool Score::transpose(TransposeMode mode, TransposeDirection direction, Key trKe
                     if (mode == TransposeMode::DIATONICALLY) {
                         n->transposeDiatonic(transposeInterval, trKeys, useDoubleSharpsFlats);
                     } else {
-                        if (!transpose(n, interval, useDoubleSharpsFlats)) {
+                        if (!transposeNote(this, n, interval, tpcTransposition)) {
                             return false;
                         }
                     }
@@ -459,7 +526,7 @@ bool Score::transpose(TransposeMode mode, TransposeDirection direction, Key trKe
                         if (mode == TransposeMode::DIATONICALLY) {
                             n->transposeDiatonic(transposeInterval, trKeys, useDoubleSharpsFlats);
                         } else {
-                            if (!transpose(n, interval, useDoubleSharpsFlats)) {
+                            if (!transposeNote(this, n, interval, tpcTransposition)) {
                                 return false;
                             }
                         }
@@ -755,7 +822,7 @@ void Note::transposeDiatonic(int interval, bool keepAlterations, bool useDoubleA
     }
 
     // store new data
-    score()->undoChangePitch(this, newPitch, newTpc1, newTpc2);
+    score()->batchChangePitch(this, newPitch, newTpc1, newTpc2);
 }
 
 //---------------------------------------------------------
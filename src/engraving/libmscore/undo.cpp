@@ -88,6 +88,12 @@
 #include "bracket.h"
 #include "fret.h"
 #include "textedit.h"
+#include "text.h"
+#include "lyrics.h"
+#include "stem.h"
+#include "hook.h"
+#include "notedot.h"
+#include "ledgerline.h"
 #include "textline.h"
 
 #include "log.h"
@@ -98,6 +104,65 @@ using namespace mu;
 namespace Ms {
 extern Measure* tick2measure(int tick);
 
+//---------------------------------------------------------
+//   elementMemoryUsage
+//    the object size of the element types which make up
+//    most of a score, the heap data they own is not
+//    counted
+//---------------------------------------------------------
+
+static size_t elementMemoryUsage(const ScoreElement* e)
+{
+    switch (e->type()) {
+    case ElementType::NOTE:         return sizeof(Note);
+    case ElementType::NOTEDOT:      return sizeof(NoteDot);
+    case ElementType::ACCIDENTAL:   return sizeof(Accidental);
+    case ElementType::CHORD:        return sizeof(Chord);
+    case ElementType::REST:         return sizeof(Rest);
+    case ElementType::STEM:         return sizeof(Stem);
+    case ElementType::HOOK:         return sizeof(Hook);
+    case ElementType::LEDGER_LINE:  return sizeof(LedgerLine);
+    case ElementType::BEAM:         return sizeof(Beam);
+    case ElementType::TUPLET:       return sizeof(Tuplet);
+    case ElementType::TIE:          return sizeof(Tie);
+    case ElementType::SLUR:         return sizeof(Slur);
+    case ElementType::ARTICULATION: return sizeof(Articulation);
+    case ElementType::LYRICS:       return sizeof(Lyrics);
+    case ElementType::HARMONY:      return sizeof(Harmony);
+    case ElementType::DYNAMIC:      return sizeof(Dynamic);
+    case ElementType::CLEF:         return sizeof(Clef);
+    case ElementType::KEYSIG:       return sizeof(KeySig);
+    case ElementType::BAR_LINE:     return sizeof(BarLine);
+    case ElementType::SEGMENT:      return sizeof(Segment);
+    case ElementType::MEASURE:      return sizeof(Measure);
+    case ElementType::SYSTEM:       return sizeof(System);
+    case ElementType::PAGE:         return sizeof(Page);
+    case ElementType::STAFF:        return sizeof(Staff);
+    case ElementType::PART:         return sizeof(Part);
+    case ElementType::SCORE:        return sizeof(Score);
+    default:
+        break;
+    }
+    return e->isTextBase() ? sizeof(Text) : sizeof(Element);
+}
+
+//---------------------------------------------------------
+//   treeMemoryUsage
+//    estimated size of an element and all its children
+//---------------------------------------------------------
+
+static size_t treeMemoryUsage(const ScoreElement* e)
+{
+    if (!e) {
+        return 0;
+    }
+    size_t size = elementMemoryUsage(e);
+    for (int i = 0; i < e->treeChildCount(); ++i) {
+        size += treeMemoryUsage(e->treeChild(i));
+    }
+    return size;
+}
+
 //---------------------------------------------------------
 //   updateNoteLines
 //    compute line position of noteheads after
@@ -158,6 +223,20 @@ void UndoCommand::cleanup(bool undo)
     }
 }
 
+//---------------------------------------------------------
+//   UndoCommand::memoryUsage
+//    estimated size of the command with the data it holds
+//---------------------------------------------------------
+
+size_t UndoCommand::memoryUsage() const
+{
+    size_t size = sizeof(*this);
+    for (const UndoCommand* c : childList) {
+        size += c->memoryUsage();
+    }
+    return size;
+}
+
 //---------------------------------------------------------
 //   undo
 //---------------------------------------------------------
@@ -273,6 +352,10 @@ UndoStack::UndoStack()
 {
     curCmd   = 0;
     curIdx   = 0;
+    firstIdx = 0;
+    memoryUsed = 0;
+    _memoryBudget = 0;
+    _droppedCount = 0;
     cleanState = 0;
     stateList.push_back(cleanState);
     nextState = 1;
@@ -286,7 +369,10 @@ UndoStack::~UndoStack()
 {
     int idx = 0;
     for (auto c : qAsConst(list)) {
-        c->cleanup(idx++ < curIdx);
+        if (c) {
+            c->cleanup(idx < curIdx);
+        }
+        ++idx;
     }
     qDeleteAll(list);
 }
@@ -359,6 +445,8 @@ void UndoStack::remove(int idx)
     while (list.size() > curIdx) {
         UndoCommand* cmd = list.takeLast();
         stateList.pop_back();
+        memoryUsed -= memoryList.back();
+        memoryList.pop_back();
         cmd->cleanup(false);      // delete elements for which UndoCommand() holds ownership
         delete cmd;
 //            --curIdx;
@@ -366,10 +454,70 @@ void UndoStack::remove(int idx)
     while (list.size() > idx) {
         UndoCommand* cmd = list.takeLast();
         stateList.pop_back();
-        cmd->cleanup(true);
-        delete cmd;
+        memoryUsed -= memoryList.back();
+        memoryList.pop_back();
+        if (cmd) {
+            cmd->cleanup(true);
+            delete cmd;
+        }
     }
     curIdx = idx;
+    firstIdx = std::min(firstIdx, curIdx);
+}
+
+//---------------------------------------------------------
+//   dropFirst
+//    delete the oldest macro, its slot stays in the list
+//    so the indices of the other macros are not changed
+//---------------------------------------------------------
+
+void UndoStack::dropFirst()
+{
+    Q_ASSERT(firstIdx < curIdx);
+    UndoMacro* cmd = list[firstIdx];
+    list[firstIdx] = 0;
+    cmd->cleanup(true);
+    delete cmd;
+    memoryUsed -= memoryList[firstIdx];
+    memoryList[firstIdx] = 0;
+    ++firstIdx;
+    ++_droppedCount;
+}
+
+//---------------------------------------------------------
+//   trim
+//    drop the oldest macros until the history fits
+//    into the budget, the last macro is always kept
+//---------------------------------------------------------
+
+void UndoStack::trim()
+{
+    if (_memoryBudget == 0 || memoryUsed <= _memoryBudget) {
+        return;
+    }
+
+    int dropped = 0;
+    while (memoryUsed > _memoryBudget && firstIdx < curIdx - 1) {
+        dropFirst();
+        ++dropped;
+    }
+
+    if (dropped) {
+        LOGI() << "dropped " << dropped << " undo macros, history size: " << memoryUsed / 1024 << " KB, budget: "
+               << _memoryBudget / 1024 << " KB";
+    }
+}
+
+//---------------------------------------------------------
+//   setMemoryBudget
+//---------------------------------------------------------
+
+void UndoStack::setMemoryBudget(size_t bytes)
+{
+    _memoryBudget = bytes;
+    if (!curCmd) {
+        trim();
+    }
 }
 
 //---------------------------------------------------------
@@ -380,6 +528,7 @@ void UndoStack::mergeCommands(int startIdx)
 {
     Q_ASSERT(startIdx <= curIdx);
 
+    startIdx = std::max(startIdx, firstIdx);
     if (startIdx >= list.size()) {
         return;
     }
@@ -389,6 +538,9 @@ void UndoStack::mergeCommands(int startIdx)
     for (int idx = startIdx + 1; idx < curIdx; ++idx) {
         startMacro->append(std::move(*list[idx]));
     }
+    memoryUsed -= memoryList[startIdx];
+    memoryList[startIdx] = startMacro->memoryUsage();
+    memoryUsed += memoryList[startIdx];
     remove(startIdx + 1);   // TODO: remove from startIdx to curIdx only
 }
 
@@ -416,7 +568,7 @@ void UndoStack::rollback()
 {
     LOG_UNDO() << "called";
     Q_ASSERT(curCmd == 0);
-    Q_ASSERT(curIdx > 0);
+    Q_ASSERT(curIdx > firstIdx);
     int idx = curIdx - 1;
     list[idx]->unwind();
     remove(idx);
@@ -439,14 +591,19 @@ void UndoStack::endMacro(bool rollback)
         while (list.size() > curIdx) {
             UndoCommand* cmd = list.takeLast();
             stateList.pop_back();
+            memoryUsed -= memoryList.back();
+            memoryList.pop_back();
             cmd->cleanup(false);        // delete elements for which UndoCommand() holds ownership
             delete cmd;
         }
         list.append(curCmd);
         stateList.push_back(nextState++);
+        memoryList.push_back(curCmd->memoryUsage());
+        memoryUsed += memoryList.back();
         ++curIdx;
     }
     curCmd = 0;
+    trim();
 }
 
 //---------------------------------------------------------
@@ -457,10 +614,12 @@ void UndoStack::reopen()
 {
     LOG_UNDO() << "curIdx: " << curIdx << ", size: " << list.size();
     Q_ASSERT(curCmd == 0);
-    Q_ASSERT(curIdx > 0);
+    Q_ASSERT(curIdx > firstIdx);
     --curIdx;
     curCmd = list.takeAt(curIdx);
     stateList.erase(stateList.begin() + curIdx);
+    memoryUsed -= memoryList[curIdx];
+    memoryList.erase(memoryList.begin() + curIdx);
     for (auto i : curCmd->commands()) {
         LOG_UNDO() << "   " << i->name();
     }
@@ -490,9 +649,9 @@ void UndoStack::undo(EditData* ed)
             return;
         }
     }
-    if (curIdx) {
+    if (canUndo()) {
         --curIdx;
-        Q_ASSERT(curIdx >= 0);
+        Q_ASSERT(curIdx >= firstIdx);
         list[curIdx]->undo(ed);
     }
 }
@@ -906,6 +1065,15 @@ void RemoveElement::cleanup(bool undo)
     }
 }
 
+//---------------------------------------------------------
+//   RemoveElement::memoryUsage
+//---------------------------------------------------------
+
+size_t RemoveElement::memoryUsage() const
+{
+    return UndoCommand::memoryUsage() + treeMemoryUsage(element);
+}
+
 //---------------------------------------------------------
 //   undo
 //---------------------------------------------------------
@@ -2114,6 +2282,7 @@ void InsertRemoveMeasures::removeMeasures()
                     score->systems().erase(k);
                 }
                 // finally delete system
+                score->nextLayoutGeneration();
                 score->deleteLater(s);
             }
         }
@@ -2168,6 +2337,15 @@ void RemoveExcerpt::redo(EditData*)
     excerpt->oscore()->removeExcerpt(excerpt);
 }
 
+//---------------------------------------------------------
+//   RemoveExcerpt::memoryUsage
+//---------------------------------------------------------
+
+size_t RemoveExcerpt::memoryUsage() const
+{
+    return UndoCommand::memoryUsage() + treeMemoryUsage(excerpt->partScore());
+}
+
 //---------------------------------------------------------
 //   SwapExcerpt::flip
 //---------------------------------------------------------
@@ -2385,6 +2563,154 @@ void ChangeProperty::flip(EditData*)
     flags = ps;
 }
 
+//---------------------------------------------------------
+//   ChangeBatch::addProperty
+//    the change has to be applied already, v and ps are
+//    the values to restore
+//---------------------------------------------------------
+
+void ChangeBatch::addProperty(ScoreElement* e, Pid id, const QVariant& v, PropertyFlags ps)
+{
+    propertyElements.push_back(e);
+    propertyIds.push_back(id);
+    propertyValues.push_back(v);
+    propertyFlags.push_back(ps);
+}
+
+//---------------------------------------------------------
+//   ChangeBatch::addPitch
+//---------------------------------------------------------
+
+void ChangeBatch::addPitch(Note* note, int pitch, int tpc1, int tpc2)
+{
+    pitchNotes.push_back(note);
+    pitches.push_back(pitch);
+    tpcs1.push_back(tpc1);
+    tpcs2.push_back(tpc2);
+}
+
+//---------------------------------------------------------
+//   ChangeBatch::applyToLinked
+//    change the elements linked to the changed ones the same
+//    way, so each element is propagated only once per batch
+//---------------------------------------------------------
+
+void ChangeBatch::applyToLinked()
+{
+    const size_t propertyCount = propertyElements.size();
+    for (size_t i = 0; i < propertyCount; ++i) {
+        ScoreElement* e = propertyElements[i];
+        const Pid id = propertyIds[i];
+        if (!e->links() || !propertyLink(id)) {
+            continue;
+        }
+        const QVariant v = e->getProperty(id);
+        const PropertyFlags ps = e->propertyFlags(id);
+        for (ScoreElement* ee : *e->links()) {
+            if (ee == e || (ee->getProperty(id) == v && ee->propertyFlags(id) == ps)) {
+                continue;
+            }
+            addProperty(ee, id, ee->getProperty(id), ee->propertyFlags(id));
+            ee->setProperty(id, v);
+            ee->setPropertyFlags(id, ps);
+        }
+    }
+
+    const size_t pitchCount = pitchNotes.size();
+    for (size_t i = 0; i < pitchCount; ++i) {
+        Note* note = pitchNotes[i];
+        if (!note->links()) {
+            continue;
+        }
+        for (ScoreElement* e : *note->links()) {
+            Note* n = toNote(e);
+            if (n == note || (n->pitch() == note->pitch() && n->tpc1() == note->tpc1() && n->tpc2() == note->tpc2())) {
+                continue;
+            }
+            addPitch(n, n->pitch(), n->tpc1(), n->tpc2());
+            n->setPitch(note->pitch(), note->tpc1(), note->tpc2());
+            n->triggerLayout();
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   ChangeBatch::flipProperty
+//---------------------------------------------------------
+
+void ChangeBatch::flipProperty(size_t idx)
+{
+    ScoreElement* e = propertyElements[idx];
+    const Pid id = propertyIds[idx];
+
+    QVariant v = e->getProperty(id);
+    PropertyFlags ps = e->propertyFlags(id);
+
+    e->setProperty(id, propertyValues[idx]);
+    e->setPropertyFlags(id, propertyFlags[idx]);
+    propertyValues[idx] = v;
+    propertyFlags[idx] = ps;
+}
+
+//---------------------------------------------------------
+//   ChangeBatch::flipPitch
+//---------------------------------------------------------
+
+void ChangeBatch::flipPitch(size_t idx)
+{
+    Note* note = pitchNotes[idx];
+    const int pitch = note->pitch();
+    const int tpc1 = note->tpc1();
+    const int tpc2 = note->tpc2();
+
+    note->setPitch(pitches[idx], tpcs1[idx], tpcs2[idx]);
+    note->triggerLayout();
+    pitches[idx] = pitch;
+    tpcs1[idx] = tpc1;
+    tpcs2[idx] = tpc2;
+}
+
+//---------------------------------------------------------
+//   ChangeBatch::undo
+//---------------------------------------------------------
+
+void ChangeBatch::undo(EditData* ed)
+{
+    for (size_t i = pitchNotes.size(); i > 0; --i) {
+        flipPitch(i - 1);
+    }
+    for (size_t i = propertyElements.size(); i > 0; --i) {
+        flipProperty(i - 1);
+    }
+    UndoCommand::undo(ed);
+}
+
+//---------------------------------------------------------
+//   ChangeBatch::redo
+//---------------------------------------------------------
+
+void ChangeBatch::redo(EditData* ed)
+{
+    UndoCommand::redo(ed);
+    for (size_t i = 0; i < propertyElements.size(); ++i) {
+        flipProperty(i);
+    }
+    for (size_t i = 0; i < pitchNotes.size(); ++i) {
+        flipPitch(i);
+    }
+}
+
+//---------------------------------------------------------
+//   ChangeBatch::memoryUsage
+//---------------------------------------------------------
+
+size_t ChangeBatch::memoryUsage() const
+{
+    return UndoCommand::memoryUsage()
+           + propertyElements.size() * (sizeof(ScoreElement*) + sizeof(Pid) + sizeof(QVariant) + sizeof(PropertyFlags))
+           + pitchNotes.size() * (sizeof(Note*) + 3 * sizeof(int));
+}
+
 //---------------------------------------------------------
 //   ChangeBracketProperty::flip
 //---------------------------------------------------------
@@ -130,6 +130,7 @@ public:
     void unwind();
     const QList<UndoCommand*>& commands() const { return childList; }
     virtual void cleanup(bool undo);
+    virtual size_t memoryUsage() const;
 // #ifndef QT_NO_DEBUG
     virtual const char* name() const { return "UndoCommand"; }
 // #endif
@@ -189,11 +190,18 @@ class UndoStack
     UndoMacro* curCmd;
     QList<UndoMacro*> list;
     std::vector<int> stateList;
+    std::vector<size_t> memoryList;     // estimated size of each macro in list
     int nextState;
     int cleanState;
     int curIdx;
+    int firstIdx;                       // macros before firstIdx are dropped, their slots are null
+    size_t memoryUsed;
+    size_t _memoryBudget;               // 0 means unlimited
+    int _droppedCount;
 
     void remove(int idx);
+    void dropFirst();
+    void trim();
 
 public:
     UndoStack();
@@ -206,15 +214,15 @@ public:
     void push1(UndoCommand*);
     void pop();
     void setClean();
-    bool canUndo() const { return curIdx > 0; }
+    bool canUndo() const { return curIdx > firstIdx; }
     bool canRedo() const { return curIdx < list.size(); }
     int state() const { return stateList[curIdx]; }
     bool isClean() const { return cleanState == state(); }
     int getCurIdx() const { return curIdx; }
     bool empty() const { return !canUndo() && !canRedo(); }
     UndoMacro* current() const { return curCmd; }
-    UndoMacro* last() const { return curIdx > 0 ? list[curIdx - 1] : 0; }
-    UndoMacro* prev() const { return curIdx > 1 ? list[curIdx - 2] : 0; }
+    UndoMacro* last() const { return curIdx > firstIdx ? list[curIdx - 1] : 0; }
+    UndoMacro* prev() const { return curIdx > firstIdx + 1 ? list[curIdx - 2] : 0; }
     void undo(EditData*);
     void redo(EditData*);
     void rollback();
@@ -222,6 +230,12 @@ public:
 
     void mergeCommands(int startIdx);
     void cleanRedoStack() { remove(curIdx); }
+
+    //! NOTE The oldest macros are dropped when the estimated size of the history exceeds the budget
+    void setMemoryBudget(size_t bytes);
+    size_t memoryBudget() const { return _memoryBudget; }
+    size_t memoryUsage() const { return memoryUsed; }
+    int droppedCount() const { return _droppedCount; }
 };
 
 //---------------------------------------------------------
@@ -625,6 +639,7 @@ public:
     virtual void undo(EditData*) override;
     virtual void redo(EditData*) override;
     virtual void cleanup(bool) override;
+    virtual size_t memoryUsage() const override;
     virtual const char* name() const override;
 
     bool isFiltered(UndoCommand::Filter f, const Element* target) const override;
@@ -759,6 +774,7 @@ class ChangeStyle : public UndoCommand
 
 public:
     ChangeStyle(Score*, const MStyle&, const bool overlapOnly = false);
+    size_t memoryUsage() const override { return sizeof(*this) + UndoCommand::memoryUsage(); }
     UNDO_NAME("ChangeStyle")
 };
 
@@ -924,6 +940,7 @@ public:
     RemoveExcerpt(Excerpt* ex);
     virtual void undo(EditData*) override;
     virtual void redo(EditData*) override;
+    virtual size_t memoryUsage() const override;
     UNDO_NAME("RemoveExcerpt")
 };
 
@@ -1153,6 +1170,44 @@ public:
     }
 };
 
+//---------------------------------------------------------
+//   ChangeBatch
+//    Property and pitch changes of a batch edit, see
+//    Score::startBatch(). The changes are kept in columns
+//    instead of one command per change. The pitch changes
+//    are applied after the property changes, so a batch
+//    must not change the pitch of a note in both ways.
+//---------------------------------------------------------
+
+class ChangeBatch : public UndoCommand
+{
+    std::vector<ScoreElement*> propertyElements;
+    std::vector<Pid> propertyIds;
+    std::vector<QVariant> propertyValues;
+    std::vector<PropertyFlags> propertyFlags;
+
+    std::vector<Note*> pitchNotes;
+    std::vector<int> pitches;
+    std::vector<int> tpcs1;
+    std::vector<int> tpcs2;
+
+    void flipProperty(size_t idx);
+    void flipPitch(size_t idx);
+
+public:
+    void addProperty(ScoreElement* e, Pid id, const QVariant& v, PropertyFlags ps);
+    void addPitch(Note* note, int pitch, int tpc1, int tpc2);
+    void applyToLinked();
+
+    size_t size() const { return propertyElements.size() + pitchNotes.size(); }
+    bool empty() const { return size() == 0; }
+
+    void undo(EditData*) override;
+    void redo(EditData*) override;
+    size_t memoryUsage() const override;
+    UNDO_NAME("ChangeBatch")
+};
+
 //---------------------------------------------------------
 //   ChangeBracketProperty
 //---------------------------------------------------------
@@ -23,10 +23,13 @@
 #ifndef __XML_H__
 #define __XML_H__
 
+#include <memory>
+
 #include <QMultiMap>
 #include <QXmlStreamReader>
 #include <QTextStream>
 
+#include "binaryxml.h"
 #include "connector.h"
 #include "stafftype.h"
 #include "interval.h"
@@ -41,6 +44,7 @@ class Beam;
 class Tuplet;
 class Measure;
 class LinkedElements;
+class SnapshotWriter;
 
 //---------------------------------------------------------
 //   SpannerValues
@@ -81,6 +85,7 @@ public:
 class XmlReader : public QXmlStreamReader
 {
     QString docName;    // used for error reporting
+    std::unique_ptr<BinaryXmlReader> _binary;   // read instead of the XML if set
 
     // Score read context (for read optimizations):
     Fraction _tick             { Fraction(0, 1) };
@@ -126,10 +131,55 @@ public:
         : QXmlStreamReader(d), docName(st) {}
     XmlReader(const QString& d, const QString& st = QString())
         : QXmlStreamReader(d), docName(st) {}
+    XmlReader(std::unique_ptr<BinaryXmlReader> d, const QString& st = QString())
+        : QXmlStreamReader(), docName(st), _binary(std::move(d)) {}
     XmlReader(const XmlReader&) = delete;
     XmlReader& operator=(const XmlReader&) = delete;
     ~XmlReader();
 
+    // the QXmlStreamReader functions used by the element readers,
+    // which read the binary XML instead if there is one
+    TokenType readNext() { return _binary ? _binary->readNext() : QXmlStreamReader::readNext(); }
+    TokenType tokenType() const { return _binary ? _binary->tokenType() : QXmlStreamReader::tokenType(); }
+    QString tokenString() const { return _binary ? _binary->tokenString() : QXmlStreamReader::tokenString(); }
+    bool atEnd() const { return _binary ? _binary->atEnd() : QXmlStreamReader::atEnd(); }
+    bool isStartElement() const { return tokenType() == StartElement; }
+    bool isEndElement() const { return tokenType() == EndElement; }
+    bool isCharacters() const { return tokenType() == Characters; }
+    bool isWhitespace() const { return _binary ? _binary->isWhitespace() : QXmlStreamReader::isWhitespace(); }
+
+    bool readNextStartElement() { return _binary ? _binary->readNextStartElement() : QXmlStreamReader::readNextStartElement(); }
+    void skipCurrentElement()
+    {
+        if (_binary) {
+            _binary->skipCurrentElement();
+        } else {
+            QXmlStreamReader::skipCurrentElement();
+        }
+    }
+    QString readElementText(ReadElementTextBehaviour behaviour = ErrorOnUnexpectedElement)
+    {
+        return _binary ? _binary->readElementText(behaviour) : QXmlStreamReader::readElementText(behaviour);
+    }
+
+    QStringRef name() const { return _binary ? _binary->name() : QXmlStreamReader::name(); }
+    QXmlStreamAttributes attributes() const { return _binary ? _binary->attributes() : QXmlStreamReader::attributes(); }
+    QStringRef text() const { return _binary ? _binary->text() : QXmlStreamReader::text(); }
+
+    qint64 lineNumber() const { return _binary ? 0 : QXmlStreamReader::lineNumber(); }
+    qint64 columnNumber() const { return _binary ? 0 : QXmlStreamReader::columnNumber(); }
+    Error error() const { return _binary ? _binary->error() : QXmlStreamReader::error(); }
+    QString errorString() const { return _binary ? _binary->errorString() : QXmlStreamReader::errorString(); }
+    bool hasError() const { return error() != NoError; }
+    void raiseError(const QString& message = QString())
+    {
+        if (_binary) {
+            _binary->raiseError(message);
+        } else {
+            QXmlStreamReader::raiseError(message);
+        }
+    }
+
     bool hasAccidental { false };                       // used for userAccidental backward compatibility
     void unknown();
 
@@ -258,6 +308,8 @@ class XmlWriter : public QTextStream
     std::vector<std::pair<const ScoreElement*, QString> > _elements;
     bool _recordElements = false;
 
+    SnapshotWriter* _snapshotWriter = nullptr;
+
     void putLevel();
 
 public:
@@ -296,6 +348,9 @@ public:
     const std::vector<std::pair<const ScoreElement*, QString> >& elements() const { return _elements; }
     void setRecordElements(bool record) { _recordElements = record; }
 
+    SnapshotWriter* snapshotWriter() const { return _snapshotWriter; }
+    void setSnapshotWriter(SnapshotWriter* writer) { _snapshotWriter = writer; }
+
     void sTag(const char* name, Spatium sp) { XmlWriter::tag(name, QVariant(sp.val())); }
     void pTag(const char* name, PlaceText);
 
@@ -322,6 +377,7 @@ public:
     void comment(const QString&);
 
     void writeXml(const QString&, QString s);
+    void writeElementData(const QByteArray& data);
     void dump(int len, const unsigned char* p);
 
     void setFilter(SelectionFilter f) { _filter = f; }
@@ -217,7 +217,7 @@ Fraction XmlReader::readFraction()
 
 void XmlReader::unknown()
 {
-    if (QXmlStreamReader::error()) {
+    if (error()) {
         qDebug("%s ", qPrintable(errorString()));
     }
     if (!docName.isEmpty()) {
@@ -424,6 +424,18 @@ void XmlWriter::writeXml(const QString& name, QString s)
     *this << "</" << ename << ">\n";
 }
 
+//---------------------------------------------------------
+//   writeElementData
+//    data is a complete element, serialized as UTF-8
+//    with the indentation of the current level
+//---------------------------------------------------------
+
+void XmlWriter::writeElementData(const QByteArray& data)
+{
+    putLevel();
+    *this << QString::fromUtf8(data) << "\n";
+}
+
 //---------------------------------------------------------
 //   assignLocalIndex
 //---------------------------------------------------------
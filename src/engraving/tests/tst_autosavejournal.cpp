@@ -0,0 +1,381 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <QBuffer>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "testing/qtestsuite.h"
+#include "testbase.h"
+#include "libmscore/autosavejournal.h"
+#include "libmscore/chord.h"
+#include "libmscore/excerpt.h"
+#include "libmscore/measure.h"
+#include "libmscore/note.h"
+#include "libmscore/score.h"
+#include "libmscore/scoresnapshot.h"
+#include "libmscore/segment.h"
+
+static const QString NOTE_DATA_DIR("note_data/");
+static const QString PARTS_DATA_DIR("parts_data/");
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestAutosaveJournal
+//---------------------------------------------------------
+
+class TestAutosaveJournal : public QObject, public MTest
+{
+    Q_OBJECT
+
+    QByteArray mscx(MasterScore* score) const;
+    void toggleVisible(MasterScore* score, int chordIndex) const;
+
+private slots:
+    void initTestCase();
+
+    void recoverSnapshot();
+    void recoverDeltas();
+    void compaction();
+    void truncatedRecord();
+    void scorePath();
+    void inUse();
+    void keepsVersion();
+    void sharedSnapshots();
+    void sharedSnapshotsParts();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestAutosaveJournal::initTestCase()
+{
+    initMTest();
+}
+
+QByteArray TestAutosaveJournal::mscx(MasterScore* score) const
+{
+    QByteArray data;
+    QBuffer buf(&data);
+    buf.open(QIODevice::WriteOnly);
+    score->writeScore(&buf, false);
+    return data;
+}
+
+void TestAutosaveJournal::toggleVisible(MasterScore* score, int chordIndex) const
+{
+    Segment* s = score->firstMeasure()->first(SegmentType::ChordRest);
+    for (int i = 0; i < chordIndex; ++i) {
+        s = s->next1(SegmentType::ChordRest);
+    }
+    Note* note = toChord(s->element(0))->upNote();
+
+    score->startCmd();
+    note->undoChangeProperty(Pid::VISIBLE, !note->visible());
+    score->endCmd();
+}
+
+//---------------------------------------------------------
+//   recoverSnapshot
+//---------------------------------------------------------
+
+void TestAutosaveJournal::recoverSnapshot()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    MasterScore* score = readScore(NOTE_DATA_DIR + "tpc-transpose.mscx");
+    QVERIFY(score);
+
+    AutosaveJournal journal(dir.path() + "/score.journal");
+    score->setAutosaveDirty(true);
+    journal.save(score);
+    journal.flush();
+    QVERIFY(!score->autosaveDirty());
+    QCOMPARE(journal.deltaCount(), 0);
+
+    QByteArray recovered;
+    QVERIFY(AutosaveJournal::recover(journal.filePath(), recovered));
+    QCOMPARE(recovered, mscx(score));
+
+    journal.remove();
+    QVERIFY(!QFile::exists(journal.filePath()));
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   recoverDeltas
+//    edits are appended as deltas and replayed on recovery
+//---------------------------------------------------------
+
+void TestAutosaveJournal::recoverDeltas()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    MasterScore* score = readScore(NOTE_DATA_DIR + "tpc-transpose.mscx");
+    QVERIFY(score);
+
+    AutosaveJournal journal(dir.path() + "/score.journal");
+    score->setAutosaveDirty(true);
+    journal.save(score);
+    journal.flush();
+
+    // nothing changed, nothing written
+    qint64 size = QFileInfo(journal.filePath()).size();
+    journal.save(score);
+    journal.flush();
+    QCOMPARE(QFileInfo(journal.filePath()).size(), size);
+
+    for (int i = 0; i < 3; ++i) {
+        toggleVisible(score, i);
+        QVERIFY(score->autosaveDirty());
+        journal.save(score);
+        journal.flush();
+        QCOMPARE(journal.deltaCount(), i + 1);
+    }
+
+    QByteArray recovered;
+    QVERIFY(AutosaveJournal::recover(journal.filePath(), recovered));
+    QCOMPARE(recovered, mscx(score));
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   compaction
+//    many deltas are folded into a new snapshot
+//---------------------------------------------------------
+
+void TestAutosaveJournal::compaction()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    MasterScore* score = readScore(NOTE_DATA_DIR + "tpc-transpose.mscx");
+    QVERIFY(score);
+
+    AutosaveJournal journal(dir.path() + "/score.journal");
+    score->setAutosaveDirty(true);
+    journal.save(score);
+    journal.flush();
+
+    int maxDeltas = 0;
+    for (int i = 0; i < 100; ++i) {
+        toggleVisible(score, 0);
+        journal.save(score);
+        journal.flush();
+        maxDeltas = qMax(maxDeltas, journal.deltaCount());
+    }
+    QVERIFY(maxDeltas < 100);
+
+    QByteArray recovered;
+    QVERIFY(AutosaveJournal::recover(journal.filePath(), recovered));
+    QCOMPARE(recovered, mscx(score));
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   truncatedRecord
+//    a record cut short by a crash is ignored
+//---------------------------------------------------------
+
+void TestAutosaveJournal::truncatedRecord()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    MasterScore* score = readScore(NOTE_DATA_DIR + "tpc-transpose.mscx");
+    QVERIFY(score);
+
+    AutosaveJournal journal(dir.path() + "/score.journal");
+    score->setAutosaveDirty(true);
+    journal.save(score);
+    journal.flush();
+    QByteArray saved = mscx(score);
+
+    toggleVisible(score, 0);
+    journal.save(score);
+    journal.flush();
+    QCOMPARE(journal.deltaCount(), 1);
+
+    QFile file(journal.filePath());
+    QVERIFY(file.resize(file.size() - 3));
+
+    QByteArray recovered;
+    QVERIFY(AutosaveJournal::recover(journal.filePath(), recovered));
+    QCOMPARE(recovered, saved);
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   scorePath
+//    the journal tells which score it belongs to
+//---------------------------------------------------------
+
+void TestAutosaveJournal::scorePath()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    MasterScore* score = readScore(NOTE_DATA_DIR + "tpc-transpose.mscx");
+    QVERIFY(score);
+
+    const QString scorePath = dir.path() + "/tpc-transpose.mscz";
+    AutosaveJournal journal(dir.path() + "/score.journal", scorePath);
+    score->setAutosaveDirty(true);
+    journal.save(score);
+    journal.flush();
+
+    QByteArray recovered;
+    QString recoveredPath;
+    QVERIFY(AutosaveJournal::recover(journal.filePath(), recovered, &recoveredPath));
+    QCOMPARE(recoveredPath, scorePath);
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   inUse
+//    a journal is not offered for recovery while it is open
+//---------------------------------------------------------
+
+void TestAutosaveJournal::inUse()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QString filePath = dir.path() + "/score.journal";
+    {
+        AutosaveJournal journal(filePath);
+        QVERIFY(AutosaveJournal::isInUse(filePath));
+    }
+    QVERIFY(!AutosaveJournal::isInUse(filePath));
+}
+
+//---------------------------------------------------------
+//   keepsVersion
+//    autosaving does not mark the score as saved by this
+//    version, only saving it does
+//---------------------------------------------------------
+
+void TestAutosaveJournal::keepsVersion()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    MasterScore* score = readScore(NOTE_DATA_DIR + "tpc-transpose.mscx");
+    QVERIFY(score);
+
+    score->setMscVersion(206);
+    score->setMscoreVersion("2.0.3");
+    score->setMscoreRevision(0x3c2f3a3);
+
+    AutosaveJournal journal(dir.path() + "/score.journal");
+    score->setAutosaveDirty(true);
+    journal.save(score);
+    journal.flush();
+
+    QCOMPARE(score->mscVersion(), 206);
+    QCOMPARE(score->mscoreVersion(), QString("2.0.3"));
+    QCOMPARE(score->mscoreRevision(), 0x3c2f3a3);
+
+    journal.remove();
+    delete score;
+}
+
+//---------------------------------------------------------
+//   sharedSnapshots
+//    a snapshot shares the measures not edited since the
+//    previous one, and reads as the whole score
+//---------------------------------------------------------
+
+void TestAutosaveJournal::sharedSnapshots()
+{
+    MasterScore* score = readScore(NOTE_DATA_DIR + "tpc-transpose.mscx");
+    QVERIFY(score);
+
+    ScoreSnapshotPtr first = score->snapshot();
+    const QByteArray original = first->mscxData();
+    QCOMPARE(original, mscx(score));
+    QCOMPARE(first->sharedMeasureCount(), 0);
+
+    ScoreSnapshotPtr unchanged = score->snapshot();
+    QCOMPARE(unchanged->mscxData(), original);
+    const int measureCount = unchanged->sharedMeasureCount();
+    QCOMPARE(measureCount, score->nmeasures() * score->nstaves());
+
+    // only the edited measure is written again
+    toggleVisible(score, 0);
+    ScoreSnapshotPtr edited = score->snapshot();
+    QCOMPARE(edited->mscxData(), mscx(score));
+    QVERIFY(edited->mscxData() != original);
+    QCOMPARE(edited->sharedMeasureCount(), measureCount - score->nstaves());
+
+    // the previous snapshots are not changed by the edit
+    QCOMPARE(first->mscxData(), original);
+    QCOMPARE(unchanged->mscxData(), original);
+
+    score->undoRedo(true, &ed);
+    QCOMPARE(score->snapshot()->mscxData(), original);
+
+    // without sharing, everything is written again
+    QCOMPARE(score->snapshot(false)->sharedMeasureCount(), 0);
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   sharedSnapshotsParts
+//    an edit written again in the score is written again
+//    in its parts, the linked elements refer to each other
+//---------------------------------------------------------
+
+void TestAutosaveJournal::sharedSnapshotsParts()
+{
+    MasterScore* score = readScore(PARTS_DATA_DIR + "part-all-parts.mscx");
+    QVERIFY(score);
+    QVERIFY(!score->excerpts().isEmpty());
+    for (Excerpt* excerpt : score->excerpts()) {
+        QVERIFY(excerpt->partScore());
+    }
+
+    score->snapshot();
+    toggleVisible(score, 1);
+    ScoreSnapshotPtr edited = score->snapshot();
+    QVERIFY(edited->sharedMeasureCount() > 0);
+    QCOMPARE(edited->mscxData(), mscx(score));
+
+    score->undoRedo(true, &ed);
+    QCOMPARE(score->snapshot()->mscxData(), mscx(score));
+
+    delete score;
+}
+
+QTEST_MAIN(TestAutosaveJournal)
+#include "tst_autosavejournal.moc"
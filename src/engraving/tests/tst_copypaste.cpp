@@ -45,7 +45,7 @@ class TestCopyPaste : public QObject, public MTest
 {
     Q_OBJECT
 
-    void copypaste(const char*);
+    void copypaste(const char*, bool binary = false);
     void copypastestaff(const char*);
     void copypastevoice(const char*, int);
     void copypastetuplet(const char*);
@@ -80,6 +80,12 @@ private slots:
     void copypaste25() { copypaste("25"); }         // copy full measure rest
     void copypaste26() { copypaste("26"); }         // Copy chords (#298541)
 
+    void copypasteBinary03() { copypaste("03", true); }     // slur
+    void copypasteBinary06() { copypaste("06", true); }     // tie
+    void copypasteBinary11() { copypaste("11", true); }     // grace notes
+    void copypasteBinary19() { copypaste("19", true); }     // chord symbols
+    void copypasteBinary23() { copypaste("23", true); }     // full measure tuplet 10/8
+
     void copypastestaff50() { copypastestaff("50"); }         // staff & slurs
 
     void copyPastePartial();
@@ -88,6 +94,13 @@ private slots:
     void copyPasteTuplet02() { copypastetuplet("02"); }
 
     //void copyPasteTremolo01() { copypastetremolo(); }
+
+    void copyBenchmark_data();
+    void copyBenchmark();
+    void clipboardParseBenchmark_data();
+    void clipboardParseBenchmark();
+    void pasteBenchmark_data();
+    void pasteBenchmark();
 };
 
 //---------------------------------------------------------
@@ -101,10 +114,11 @@ void TestCopyPaste::initTestCase()
 
 //---------------------------------------------------------
 //   copypaste
-//    copy measure 2, paste into measure 4
+//    copy measure 2, paste into measure 4, from the binary
+//    staff list only if binary is set
 //---------------------------------------------------------
 
-void TestCopyPaste::copypaste(const char* idx)
+void TestCopyPaste::copypaste(const char* idx, bool binary)
 {
     MasterScore* score = readScore(COPYPASTE_DATA_DIR + QString("copypaste%1.mscx").arg(idx));
     Measure* m1 = score->firstMeasure();
@@ -126,7 +140,12 @@ void TestCopyPaste::copypaste(const char* idx)
     QVERIFY(!mimeType.isEmpty());
     QMimeData* mimeData = new QMimeData;
     QByteArray ba = score->selection().mimeData();
-    mimeData->setData(mimeType, ba);
+    if (binary) {
+        QCOMPARE(mimeType, QString(mimeStaffListFormat));
+        mimeData->setData(mimeStaffListBinaryFormat, BinaryXmlReader::fromXml(ba));
+    } else {
+        mimeData->setData(mimeType, ba);
+    }
     QApplication::clipboard()->setMimeData(mimeData);
     QVERIFY(m4->first()->element(0) != 0);
     score->select(m4->first()->element(0));
@@ -486,5 +505,119 @@ void TestCopyPaste::copypastetremolo()
     delete score;
 }
 
+//---------------------------------------------------------
+//   clipboardFormats
+//    the rows of the benchmarks: the XML staff list and the
+//    binary one, which the same version reads on paste
+//---------------------------------------------------------
+
+static void clipboardFormats()
+{
+    QTest::addColumn<bool>("binary");
+
+    QTest::newRow("xml") << false;
+    QTest::newRow("binary") << true;
+}
+
+void TestCopyPaste::copyBenchmark_data() { clipboardFormats(); }
+void TestCopyPaste::clipboardParseBenchmark_data() { clipboardFormats(); }
+void TestCopyPaste::pasteBenchmark_data() { clipboardFormats(); }
+
+//---------------------------------------------------------
+//   copyBenchmark
+//    write all staves of the whole score to the clipboard
+//    format. The binary staff list is made from the XML,
+//    the element writers only write XML.
+//---------------------------------------------------------
+
+void TestCopyPaste::copyBenchmark()
+{
+    QFETCH(bool, binary);
+
+    MasterScore* score = readScore("concertpitch_data/concertpitchbenchmark.mscx");
+    QVERIFY(score);
+
+    score->cmdSelectAll();
+    QVERIFY(score->selection().canCopy());
+
+    QByteArray data;
+    QBENCHMARK {
+        data = score->selection().mimeData();
+        if (binary) {
+            data = BinaryXmlReader::fromXml(data);
+        }
+    }
+    QVERIFY(!data.isEmpty());
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   clipboardParseBenchmark
+//    only read the tokens of the clipboard, without
+//    creating elements
+//---------------------------------------------------------
+
+void TestCopyPaste::clipboardParseBenchmark()
+{
+    QFETCH(bool, binary);
+
+    MasterScore* score = readScore("concertpitch_data/concertpitchbenchmark.mscx");
+    QVERIFY(score);
+
+    score->cmdSelectAll();
+    const QByteArray xml = score->selection().mimeData();
+    QVERIFY(!xml.isEmpty());
+    const QByteArray data = BinaryXmlReader::fromXml(xml);
+    QVERIFY(!data.isEmpty());
+
+    int tokens = 0;
+    QBENCHMARK {
+        tokens = 0;
+        std::unique_ptr<XmlReader> e = binary ? std::make_unique<XmlReader>(std::make_unique<BinaryXmlReader>(data))
+                                       : std::make_unique<XmlReader>(xml);
+        while (!e->atEnd()) {
+            e->readNext();
+            ++tokens;
+        }
+        QVERIFY(!e->hasError());
+    }
+    QVERIFY(tokens > 0);
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   pasteBenchmark
+//    paste all staves of the whole score over the score
+//    again
+//---------------------------------------------------------
+
+void TestCopyPaste::pasteBenchmark()
+{
+    QFETCH(bool, binary);
+
+    MasterScore* score = readScore("concertpitch_data/concertpitchbenchmark.mscx");
+    QVERIFY(score);
+
+    score->cmdSelectAll();
+    const QByteArray xml = score->selection().mimeData();
+    QMimeData mimeData;
+    if (binary) {
+        mimeData.setData(mimeStaffListBinaryFormat, BinaryXmlReader::fromXml(xml));
+    } else {
+        mimeData.setData(mimeStaffListFormat, xml);
+    }
+
+    QBENCHMARK {
+        score->select(score->firstMeasure()->first(SegmentType::ChordRest)->element(0));
+        score->startCmd();
+        score->cmdPaste(&mimeData, 0);
+        score->endCmd();
+    }
+
+    delete score;
+}
+
 QTEST_MAIN(TestCopyPaste)
 #include "tst_copypaste.moc"
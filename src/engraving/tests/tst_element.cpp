@@ -24,6 +24,9 @@
 #include "testbase.h"
 #include "libmscore/score.h"
 #include "libmscore/element.h"
+#include "libmscore/page.h"
+
+static const QString ALL_ELEMENTS_DATA_DIR("all_elements_data/");
 
 using namespace Ms;
 
@@ -38,6 +41,7 @@ class TestElement : public QObject, public MTest
 private slots:
     void initTestCase() { initMTest(); }
     void testIds();
+    void testPaintOrder();
 };
 
 //---------------------------------------------------------
@@ -113,6 +117,58 @@ void TestElement::testIds()
     }
 }
 
+//---------------------------------------------------------
+//   testPaintOrder
+//    the pages keep their elements sorted for painting,
+//    also when the selection changes
+//---------------------------------------------------------
+
+static void checkPaintOrder(const Page* page)
+{
+    const QList<Element*>& elements = page->paintOrder();
+    for (int i = 0; i < elements.size(); ++i) {
+        QCOMPARE(elements[i]->paintIndex, i);
+        if (i > 0) {
+            QVERIFY(!elementLessThan(elements[i], elements[i - 1]));
+        }
+    }
+}
+
+void TestElement::testPaintOrder()
+{
+    MasterScore* score = readScore(ALL_ELEMENTS_DATA_DIR + "layout_elements.mscx");
+    QVERIFY(score);
+    QVERIFY(!score->pages().isEmpty());
+
+    Page* page = score->pages().front();
+    checkPaintOrder(page);
+
+    const QList<Element*> elements = page->paintOrder();
+    QVERIFY(elements.size() > 2);
+
+    Element* e = elements.front();
+    e->setSelected(true);
+    checkPaintOrder(page);
+
+    e->setSelected(false);
+    checkPaintOrder(page);
+
+    // select all sorts once, on the next paint
+    score->cmdSelectAll();
+    checkPaintOrder(page);
+
+    score->deselectAll();
+    checkPaintOrder(page);
+
+    QList<Element*> items = page->items(page->bbox());
+    page->sortInPaintOrder(items);
+    for (int i = 1; i < items.size(); ++i) {
+        QVERIFY(items[i - 1]->paintIndex < items[i]->paintIndex);
+    }
+
+    delete score;
+}
+
 QTEST_MAIN(TestElement)
 
 #include "tst_element.moc"
@@ -0,0 +1,145 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "testing/qtestsuite.h"
+#include "testbase.h"
+#include "libmscore/mscore.h"
+#include "libmscore/scorefont.h"
+#include "libmscore/sym.h"
+
+#include "engraving/draw/fontengineft.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestFontEngineFT
+//---------------------------------------------------------
+
+class TestFontEngineFT : public QObject, public MTest
+{
+    Q_OBJECT
+
+    mu::draw::FontEngineFT engine;
+
+private slots:
+    void initTestCase();
+    void glyphMetrics();
+    void scoreFontBBox();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestFontEngineFT::initTestCase()
+{
+    initMTest();
+    QVERIFY(engine.load(":/fonts/leland/Leland.otf"));
+}
+
+//---------------------------------------------------------
+//   glyphMetrics
+//    the metrics loaded on query agree with the glyph
+//    bboxes of the font's SMuFL metadata
+//---------------------------------------------------------
+
+void TestFontEngineFT::glyphMetrics()
+{
+    QFile metadataFile(":/fonts/leland/metadata.json");
+    QVERIFY(metadataFile.open(QIODevice::ReadOnly));
+    const QJsonObject glyphBBoxes = QJsonDocument::fromJson(metadataFile.readAll()).object().value("glyphBBoxes").toObject();
+    QVERIFY(!glyphBBoxes.isEmpty());
+
+    const ScoreFont* font = ScoreFont::fontByName("Leland");
+
+    auto metadataBBox = [&glyphBBoxes](SymId id) {
+        const QJsonObject bbox = glyphBBoxes.value(Sym::id2name(id)).toObject();
+        const QJsonArray ne = bbox.value("bBoxNE").toArray();
+        const QJsonArray sw = bbox.value("bBoxSW").toArray();
+        QRectF rect;
+        rect.setCoords(sw.at(0).toDouble(), -ne.at(1).toDouble(), ne.at(0).toDouble(), -sw.at(1).toDouble());
+        return rect;
+    };
+
+    // the metadata is in staff spaces
+    const QRectF notehead = engine.bbox(font->symCode(SymId::noteheadBlack), DPI_F);
+    QVERIFY(notehead.isValid());
+    const qreal spatium = notehead.height() / metadataBBox(SymId::noteheadBlack).height();
+
+    const std::vector<SymId> ids {
+        SymId::noteheadBlack,
+        SymId::noteheadWhole,
+        SymId::accidentalSharp,
+        SymId::gClef,
+        SymId::restQuarter
+    };
+
+    for (SymId id : ids) {
+        const QRectF expected = metadataBBox(id);
+        const QRectF actual = engine.bbox(font->symCode(id), DPI_F);
+        QVERIFY2(actual.isValid(), Sym::id2name(id));
+
+        static constexpr qreal TOLERANCE = 0.02; // staff spaces
+        QVERIFY2(qAbs(actual.left() / spatium - expected.left()) < TOLERANCE, Sym::id2name(id));
+        QVERIFY2(qAbs(actual.top() / spatium - expected.top()) < TOLERANCE, Sym::id2name(id));
+        QVERIFY2(qAbs(actual.right() / spatium - expected.right()) < TOLERANCE, Sym::id2name(id));
+        QVERIFY2(qAbs(actual.bottom() / spatium - expected.bottom()) < TOLERANCE, Sym::id2name(id));
+
+        QVERIFY2(engine.advance(font->symCode(id), DPI_F) > 0.0, Sym::id2name(id));
+    }
+
+    QVERIFY(!engine.bbox(0x41, DPI_F).isValid()); // not in the font
+}
+
+//---------------------------------------------------------
+//   scoreFontBBox
+//    a sequence of symbols is measured by the engine in one
+//    query, as if its symbols were placed one after another
+//---------------------------------------------------------
+
+void TestFontEngineFT::scoreFontBBox()
+{
+    const ScoreFont* font = ScoreFont::fontByName("Bravura");
+    const std::vector<SymId> ids { SymId::noteheadBlack, SymId::accidentalFlat, SymId::noteheadHalf };
+
+    mu::RectF bbox;
+    qreal x = 0.0;
+    for (SymId id : ids) {
+        bbox.unite(font->bbox(id, 2.0).translated(mu::PointF(x, 0.0)));
+        x += font->advance(id, 2.0);
+    }
+
+    const mu::RectF batchBBox = font->bbox(ids, 2.0);
+    QVERIFY(qAbs(batchBBox.left() - bbox.left()) < 1e-9);
+    QVERIFY(qAbs(batchBBox.right() - bbox.right()) < 1e-9);
+    QCOMPARE(batchBBox.top(), bbox.top());
+    QCOMPARE(batchBBox.bottom(), bbox.bottom());
+    QCOMPARE(font->width(ids, 2.0), batchBBox.width());
+}
+
+QTEST_MAIN(TestFontEngineFT)
+#include "tst_fontengineft.moc"
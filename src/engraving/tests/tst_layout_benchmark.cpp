@@ -23,6 +23,16 @@
 #include "testing/qtestsuite.h"
 #include "testbase.h"
 #include "libmscore/score.h"
+#include "libmscore/measure.h"
+#include "libmscore/page.h"
+#include "libmscore/system.h"
+#include "libmscore/chord.h"
+#include "libmscore/lyrics.h"
+#include "libmscore/segment.h"
+
+#include "modularity/ioc.h"
+#include "engraving/draw/qfontprovider.h"
+#include "engraving/draw/fontcompat.h"
 
 #include "engraving/compat/mscxcompat.h"
 
@@ -53,6 +63,13 @@ private slots:
     void benchmark1();
     void benchmark2();
     void benchmark4();              // incremental layout (one page)
+    void benchmark5();              // progressive layout, first page only
+    void progressiveLayout();
+    void textMetricsCache();
+    void fontMetricsCacheBounded();
+    void benchmarkSelectAll();      // range selection of the whole score
+    void benchmarkLyrics();         // layout with lyrics on every chord
+    void benchmarkStyledProperties();   // style lookups of the styled properties of all elements
 };
 
 //---------------------------------------------------------
@@ -104,5 +121,227 @@ void TestLayoutBenchmark::benchmark4()
     }
 }
 
+void TestLayoutBenchmark::benchmark5()
+{
+    QBENCHMARK {                          // time to first page
+        score->doLayoutPages(1);
+    }
+    score->doLayoutPages(-1);
+}
+
+//---------------------------------------------------------
+//   progressiveLayout
+//    laying out page by page gives the same result as
+//    a full layout
+//---------------------------------------------------------
+
+void TestLayoutBenchmark::progressiveLayout()
+{
+    score->doLayout();
+    const int npages = score->npages();
+    const int nsystems = score->systems().size();
+    QList<qreal> systemPositions;
+    for (const System* system : score->systems()) {
+        systemPositions.append(system->pagePos().y());
+    }
+    QVERIFY(npages > 1);
+
+    int steps = 0;
+    while (!score->doLayoutPages(1)) {
+        QVERIFY(score->layoutPending());
+        for (const System* system : score->systems()) {
+            QVERIFY(system->page());                // the system for the next page is not kept
+        }
+        ++steps;
+    }
+    QVERIFY(steps > 0);
+    QVERIFY(!score->layoutPending());
+
+    QCOMPARE(score->npages(), npages);
+    QCOMPARE(score->systems().size(), nsystems);
+    for (int i = 0; i < nsystems; ++i) {
+        QCOMPARE(score->systems().at(i)->pagePos().y(), systemPositions.at(i));
+    }
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        QVERIFY(m->system() || m->hasMMRest());
+    }
+}
+
+//---------------------------------------------------------
+//   textMetricsCache
+//    cached text metrics are identical to fresh ones
+//---------------------------------------------------------
+
+void TestLayoutBenchmark::textMetricsCache()
+{
+    auto provider = std::dynamic_pointer_cast<mu::draw::QFontProvider>(
+        mu::modularity::ioc()->resolve<mu::draw::IFontProvider>("engraving_tests"));
+    QVERIFY(provider);
+
+    mu::draw::Font font("Edwin");
+    font.setPointSizeF(10.0);
+    const QString text("Gloria in excelsis");
+    QFontMetricsF fm(mu::draw::toQFont(font), MScore::paintDevice());
+
+    provider->resetCacheStats();
+    for (int i = 0; i < 3; ++i) {
+        QCOMPARE(provider->horizontalAdvance(font, text), fm.horizontalAdvance(text));
+        QCOMPARE(provider->boundingRect(font, text).toQRectF(), fm.boundingRect(text));
+        QCOMPARE(provider->tightBoundingRect(font, text).toQRectF(), fm.tightBoundingRect(text));
+        QCOMPARE(provider->lineSpacing(font), fm.lineSpacing());
+    }
+
+    mu::draw::QFontProvider::CacheStats stats = provider->cacheStats();
+    QCOMPARE(stats.textMisses, quint64(3));
+    QCOMPARE(stats.textHits, quint64(6));
+    QVERIFY(stats.fontMisses <= 1);
+}
+
+//---------------------------------------------------------
+//   fontMetricsCacheBounded
+//    fonts used once, like the sizes of a zoom or a spatium
+//    change, are evicted and the metrics stay right
+//---------------------------------------------------------
+
+void TestLayoutBenchmark::fontMetricsCacheBounded()
+{
+    auto provider = std::dynamic_pointer_cast<mu::draw::QFontProvider>(
+        mu::modularity::ioc()->resolve<mu::draw::IFontProvider>("engraving_tests"));
+    QVERIFY(provider);
+
+    const QString text("Gloria in excelsis");
+    auto fontOfSize = [](int i) {
+        mu::draw::Font font("Edwin");
+        font.setPointSizeF(5.0 + i * 0.01);
+        return font;
+    };
+
+    static constexpr int FONT_COUNT = 1000;
+    provider->resetCacheStats();
+    for (int i = 0; i < FONT_COUNT; ++i) {
+        provider->horizontalAdvance(fontOfSize(i), text);
+    }
+    QCOMPARE(provider->cacheStats().fontMisses, quint64(FONT_COUNT));
+
+    // the first font was evicted, its new entry doesn't hit the texts measured with the old one
+    const mu::draw::Font first = fontOfSize(0);
+    QFontMetricsF fm(mu::draw::toQFont(first), MScore::paintDevice());
+    QCOMPARE(provider->horizontalAdvance(first, text), fm.horizontalAdvance(text));
+    QCOMPARE(provider->cacheStats().fontMisses, quint64(FONT_COUNT + 1));
+    QCOMPARE(provider->cacheStats().textHits, quint64(0));
+}
+
+//---------------------------------------------------------
+//   benchmarkSelectAll
+//---------------------------------------------------------
+
+void TestLayoutBenchmark::benchmarkSelectAll()
+{
+    score->doLayout();
+    score->cmdSelectAll();
+    QVERIFY(score->selection().isRange());
+
+    const QList<Element*> elements = score->selection().elements();
+    QVERIFY(!elements.isEmpty());
+
+    QBENCHMARK {
+        score->selection().updateSelectedElements();
+    }
+
+    QCOMPARE(score->selection().elements(), elements);
+    score->deselectAll();
+}
+
+//---------------------------------------------------------
+//   benchmarkLyrics
+//---------------------------------------------------------
+
+void TestLayoutBenchmark::benchmarkLyrics()
+{
+    static const QStringList syllables { "Al", "le", "lu", "ia", "Glo", "ri", "a", "in", "ex", "cel", "sis" };
+    int n = 0;
+    for (Segment* s = score->firstSegment(SegmentType::ChordRest); s; s = s->next1(SegmentType::ChordRest)) {
+        for (Element* e : s->elist()) {
+            if (!e || !e->isChord()) {
+                continue;
+            }
+            Chord* chord = toChord(e);
+            Lyrics* lyrics = new Lyrics(score);
+            lyrics->setTrack(chord->track());
+            lyrics->setParent(chord);
+            lyrics->setPlainText(syllables.at(n++ % syllables.size()));
+            chord->add(lyrics);
+        }
+    }
+    QVERIFY(n > 0);
+
+    auto provider = std::dynamic_pointer_cast<mu::draw::QFontProvider>(
+        mu::modularity::ioc()->resolve<mu::draw::IFontProvider>("engraving_tests"));
+    QVERIFY(provider);
+
+    score->doLayout();
+    provider->resetCacheStats();
+    QBENCHMARK {
+        score->doLayout();
+    }
+
+    mu::draw::QFontProvider::CacheStats stats = provider->cacheStats();
+    auto rate = [](quint64 hits, quint64 misses) {
+        return hits + misses ? 100.0 * hits / (hits + misses) : 0.0;
+    };
+    qDebug("font metrics hit rate: %.1f%% (%llu lookups), text metrics hit rate: %.1f%% (%llu lookups)",
+           rate(stats.fontHits, stats.fontMisses), stats.fontHits + stats.fontMisses,
+           rate(stats.textHits, stats.textMisses), stats.textHits + stats.textMisses);
+    QVERIFY(stats.textHits > stats.textMisses);
+}
+
+//---------------------------------------------------------
+//   benchmarkStyledProperties
+//    the typed style values match the QVariant ones
+//---------------------------------------------------------
+
+static void collectElements(void* data, Element* e)
+{
+    static_cast<QList<Element*>*>(data)->append(e);
+}
+
+void TestLayoutBenchmark::benchmarkStyledProperties()
+{
+    const MStyle& style = score->style();
+    for (int i = 0; i < int(Sid::STYLES); ++i) {
+        const Sid sid = Sid(i);
+        const char* type = MStyle::valueType(sid);
+        if (!strcmp(type, "double")) {
+            QCOMPARE(score->styleD(sid), style.value(sid).toDouble());
+        } else if (!strcmp(type, "int")) {
+            QCOMPARE(score->styleI(sid), style.value(sid).toInt());
+        } else if (!strcmp(type, "bool")) {
+            QCOMPARE(score->styleB(sid), style.value(sid).toBool());
+        }
+    }
+
+    score->doLayout();
+    QList<Element*> elements;
+    score->scanElements(&elements, collectElements);
+    QVERIFY(!elements.isEmpty());
+
+    qreal sum = 0.0;
+    QBENCHMARK {
+        for (Element* e : qAsConst(elements)) {
+            sum += e->spatium();
+            const ElementStyle* elementStyle = e->styledProperties();
+            if (!elementStyle) {
+                continue;
+            }
+            for (const StyledProperty& sp : *elementStyle) {
+                if (e->getProperty(sp.pid) == e->styleValue(sp.pid, sp.sid)) {
+                    sum += 1.0;
+                }
+            }
+        }
+    }
+    QVERIFY(sum > 0.0);
+}
+
 QTEST_MAIN(TestLayoutBenchmark)
 #include "tst_layout_benchmark.moc"
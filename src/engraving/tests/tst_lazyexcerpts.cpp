@@ -0,0 +1,293 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "testing/qtestsuite.h"
+#include "testbase.h"
+#include "libmscore/chord.h"
+#include "libmscore/excerpt.h"
+#include "libmscore/note.h"
+#include "libmscore/part.h"
+#include "libmscore/score.h"
+#include "libmscore/segment.h"
+
+static const QString PARTS_DATA_DIR("parts_data/");
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestLazyExcerpts
+//---------------------------------------------------------
+
+class TestLazyExcerpts : public QObject, public MTest
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void lazyEqualsEager_data();
+    void lazyEqualsEager();
+    void loadOnEdit();
+    void saveUnloaded_data();
+    void saveUnloaded();
+    void linkedInScore();
+    void initExcerpts();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestLazyExcerpts::initTestCase()
+{
+    initMTest();
+}
+
+void TestLazyExcerpts::cleanupTestCase()
+{
+    MScore::lazyExcerpts = true;
+}
+
+//---------------------------------------------------------
+//   lazyEqualsEager
+//    part scores read on first access must be identical
+//    to the ones read together with the master score
+//---------------------------------------------------------
+
+void TestLazyExcerpts::lazyEqualsEager_data()
+{
+    QTest::addColumn<QString>("file");
+
+    QTest::newRow("all") << "part-all-parts";
+    QTest::newRow("54346") << "part-54346-parts";
+    QTest::newRow("measure-repeat") << "part-measure-repeat-parts";
+    QTest::newRow("textlines") << "part-textlines-parts";
+}
+
+void TestLazyExcerpts::lazyEqualsEager()
+{
+    QFETCH(QString, file);
+
+    QString readFile(PARTS_DATA_DIR + file + ".mscx");
+
+    MScore::lazyExcerpts = false;
+    MasterScore* eager = readScore(readFile);
+    MScore::lazyExcerpts = true;
+    MasterScore* lazy = readScore(readFile);
+    QVERIFY(eager);
+    QVERIFY(lazy);
+
+    QCOMPARE(lazy->excerpts().size(), eager->excerpts().size());
+    QVERIFY(!lazy->excerpts().isEmpty());
+
+    for (int i = 0; i < lazy->excerpts().size(); ++i) {
+        Excerpt* lazyExcerpt = lazy->excerpts().at(i);
+        Excerpt* eagerExcerpt = eager->excerpts().at(i);
+
+        // known without reading the part score
+        QVERIFY(!lazyExcerpt->isPartScoreLoaded());
+        QCOMPARE(lazyExcerpt->title(), eagerExcerpt->title());
+        QCOMPARE(lazyExcerpt->parts().size(), eagerExcerpt->parts().size());
+        for (int j = 0; j < lazyExcerpt->parts().size(); ++j) {
+            QCOMPARE(lazy->parts().indexOf(lazyExcerpt->parts().at(j)), eager->parts().indexOf(eagerExcerpt->parts().at(j)));
+        }
+        QCOMPARE(lazyExcerpt->isEmpty(), eagerExcerpt->isEmpty());
+        QVERIFY(!lazyExcerpt->isPartScoreLoaded());
+
+        QString eagerFile(QString("%1-%2-eager.mscx").arg(file).arg(i));
+        QString lazyFile(QString("%1-%2-lazy.mscx").arg(file).arg(i));
+        QVERIFY(saveScore(eagerExcerpt->partScore(), eagerFile));
+        QVERIFY(saveScore(lazyExcerpt->partScore(), lazyFile));
+        QVERIFY(lazyExcerpt->isPartScoreLoaded());
+        QVERIFY(compareFilesFromPaths(lazyFile, eagerFile));
+        QCOMPARE(lazyExcerpt->tracks(), eagerExcerpt->tracks());
+    }
+
+    // links between master and part scores
+    QString eagerFile(file + "-eager.mscx");
+    QString lazyFile(file + "-lazy.mscx");
+    QVERIFY(saveScore(eager, eagerFile));
+    QVERIFY(saveScore(lazy, lazyFile));
+    QVERIFY(compareFilesFromPaths(lazyFile, eagerFile));
+
+    delete eager;
+    delete lazy;
+}
+
+//---------------------------------------------------------
+//   loadOnEdit
+//    the first command reads all part scores
+//---------------------------------------------------------
+
+void TestLazyExcerpts::loadOnEdit()
+{
+    MScore::lazyExcerpts = true;
+    MasterScore* score = readScore(PARTS_DATA_DIR + "part-all-parts.mscx");
+    QVERIFY(score);
+    QVERIFY(!score->excerpts().isEmpty());
+    QCOMPARE(score->scoreList().size(), 1);
+
+    score->startCmd();
+    score->endCmd();
+
+    for (const Excerpt* excerpt : score->excerpts()) {
+        QVERIFY(excerpt->isPartScoreLoaded());
+    }
+    QCOMPARE(score->scoreList().size(), score->excerpts().size() + 1);
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   saveUnloaded
+//    saving does not read the part scores, the unread
+//    ones are written as they were read
+//---------------------------------------------------------
+
+void TestLazyExcerpts::saveUnloaded_data()
+{
+    lazyEqualsEager_data();
+}
+
+void TestLazyExcerpts::saveUnloaded()
+{
+    QFETCH(QString, file);
+
+    QString readFile(PARTS_DATA_DIR + file + ".mscx");
+
+    MScore::lazyExcerpts = false;
+    MasterScore* eager = readScore(readFile);
+    MScore::lazyExcerpts = true;
+    MasterScore* lazy = readScore(readFile);
+    QVERIFY(eager);
+    QVERIFY(lazy);
+
+    QString eagerFile(file + "-unloaded-eager.mscx");
+    QString lazyFile(file + "-unloaded-lazy.mscx");
+    QVERIFY(saveScore(eager, eagerFile));
+    QVERIFY(saveScore(lazy, lazyFile));
+    for (const Excerpt* excerpt : lazy->excerpts()) {
+        QVERIFY(!excerpt->isPartScoreLoaded());
+    }
+    QVERIFY(compareFilesFromPaths(lazyFile, eagerFile));
+
+    delete eager;
+    delete lazy;
+}
+
+//---------------------------------------------------------
+//   linkedInScore
+//    the score index of the linked elements must give
+//    the same elements as a scan of the link list
+//---------------------------------------------------------
+
+static QList<ScoreElement*> scanLinkedInScore(const ScoreElement* e, const Score* score)
+{
+    QList<ScoreElement*> el;
+    for (ScoreElement* le : e->linkList()) {
+        if (le->score() == score) {
+            el.append(le);
+        }
+    }
+    return el;
+}
+
+void TestLazyExcerpts::linkedInScore()
+{
+    MScore::lazyExcerpts = false;
+    MasterScore* score = readScore(PARTS_DATA_DIR + "part-all-parts.mscx");
+    MScore::lazyExcerpts = true;
+    QVERIFY(score);
+    QVERIFY(score->scoreList().size() > 1);
+
+    Note* firstNote = nullptr;
+    for (Segment* s = score->firstSegment(SegmentType::ChordRest); s; s = s->next1(SegmentType::ChordRest)) {
+        for (Element* e : s->elist()) {
+            if (!e || !e->isChord()) {
+                continue;
+            }
+            for (Note* note : toChord(e)->notes()) {
+                for (Score* sc : score->scoreList()) {
+                    QCOMPARE(note->linkedInScore(sc), scanLinkedInScore(note, sc));
+                }
+                if (!firstNote) {
+                    firstNote = note;
+                }
+            }
+        }
+    }
+    QVERIFY(firstNote);
+    QVERIFY(firstNote->links());
+
+    // unlinking removes the element from the index
+    const ScoreElement* linked = firstNote->linkList().last();
+    Score* partScore = linked->score();
+    QVERIFY(partScore != score);
+    QCOMPARE(linked->linkedInScore(partScore).size(), 1);
+    firstNote->unlink();
+    QCOMPARE(firstNote->linkedInScore(score), QList<ScoreElement*>({ firstNote }));
+    QVERIFY(!linked->linkedInScore(score).contains(firstNote));
+    QCOMPARE(linked->linkedInScore(partScore), scanLinkedInScore(linked, partScore));
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   initExcerpts
+//    the part scores created together must be identical
+//    to the ones created one by one
+//---------------------------------------------------------
+
+void TestLazyExcerpts::initExcerpts()
+{
+    QString readFile(PARTS_DATA_DIR + "part-all.mscx");
+
+    MasterScore* single = readScore(readFile);
+    MasterScore* together = readScore(readFile);
+    QVERIFY(single);
+    QVERIFY(together);
+
+    for (Excerpt* excerpt : Excerpt::createExcerptsFromParts(single->parts())) {
+        single->initExcerpt(excerpt, true);
+    }
+
+    together->initExcerpts(Excerpt::createExcerptsFromParts(together->parts()), true);
+
+    const int n = together->excerpts().size();
+    QVERIFY(n > 1);
+    QCOMPARE(single->excerpts().size(), n);
+
+    for (int i = 0; i < n; ++i) {
+        QString singleFile(QString("part-all-%1-single.mscx").arg(i));
+        QString togetherFile(QString("part-all-%1-together.mscx").arg(i));
+        QVERIFY(saveScore(single->excerpts().at(i)->partScore(), singleFile));
+        QVERIFY(saveScore(together->excerpts().at(i)->partScore(), togetherFile));
+        QVERIFY(compareFilesFromPaths(togetherFile, singleFile));
+    }
+
+    delete single;
+    delete together;
+}
+
+QTEST_MAIN(TestLazyExcerpts)
+#include "tst_lazyexcerpts.moc"
@@ -26,18 +26,24 @@
 #include "libmscore/mscore.h"
 #include "libmscore/score.h"
 #include "libmscore/note.h"
+#include "libmscore/notetable.h"
 #include "libmscore/chordrest.h"
 #include "libmscore/accidental.h"
 #include "libmscore/chord.h"
 #include "libmscore/measure.h"
 #include "libmscore/segment.h"
+#include "libmscore/staff.h"
 #include "libmscore/tremolo.h"
 #include "libmscore/articulation.h"
 #include "libmscore/sym.h"
 #include "libmscore/key.h"
 #include "libmscore/pitchspelling.h"
+#include "libmscore/undo.h"
+
+#include <QElapsedTimer>
 
 static const QString NOTE_DATA_DIR("note_data/");
+static const QString CONCERTPITCH_DATA_DIR("concertpitch_data/");
 
 using namespace Ms;
 
@@ -59,6 +65,11 @@ private slots:
     void noteLimits();
     void tpcDegrees();
     void LongNoteAfterShort_183746();
+    void batchEdit();
+    void batchEditBenchmark_data();
+    void batchEditBenchmark();
+    void noteTable();
+    void transposeBatch();
 };
 
 //---------------------------------------------------------
@@ -554,6 +565,296 @@ void TestNote::LongNoteAfterShort_183746()
     QVERIFY(totalTicks == breveTicks);   // total duration same as a breve
 }
 
+//---------------------------------------------------------
+//   allNotes
+//---------------------------------------------------------
+
+static std::vector<Note*> allNotes(Score* score)
+{
+    std::vector<Note*> notes;
+    for (Segment* s = score->firstSegment(SegmentType::ChordRest); s; s = s->next1(SegmentType::ChordRest)) {
+        for (Element* e : s->elist()) {
+            if (e && e->isChord()) {
+                for (Note* note : toChord(e)->notes()) {
+                    notes.push_back(note);
+                }
+            }
+        }
+    }
+    return notes;
+}
+
+//---------------------------------------------------------
+//   transposeUp
+//    a whole tone up, if the spelling allows it
+//---------------------------------------------------------
+
+static bool transposeUp(Note* note, int& pitch, int& tpc1, int& tpc2)
+{
+    pitch = note->pitch() + 2;
+    tpc1 = note->tpc1() + 2;
+    tpc2 = note->tpc2() + 2;
+    return pitch <= 127 && tpcIsValid(tpc1) && tpcIsValid(tpc2);
+}
+
+//---------------------------------------------------------
+///   batchEdit
+///   the changes of a batch edit are undone and redone
+///   as one command
+//---------------------------------------------------------
+
+void TestNote::batchEdit()
+{
+    MasterScore* score = readScore(CONCERTPITCH_DATA_DIR + "concertpitchbenchmark.mscx");
+    QVERIFY(score);
+
+    const std::vector<Note*> notes = allNotes(score);
+    QVERIFY(!notes.empty());
+
+    std::vector<int> pitches;
+    std::vector<bool> smalls;
+    for (const Note* note : notes) {
+        pitches.push_back(note->pitch());
+        smalls.push_back(note->small());
+    }
+
+    const int undoIdx = score->undoStack()->getCurIdx();
+
+    score->startBatch();
+    QVERIFY(score->batchActive());
+    int changed = 0;
+    for (Note* note : notes) {
+        int pitch, tpc1, tpc2;
+        if (transposeUp(note, pitch, tpc1, tpc2)) {
+            score->batchChangePitch(note, pitch, tpc1, tpc2);
+            ++changed;
+        }
+        score->batchChangeProperty(note, Pid::SMALL, true);
+    }
+    score->endBatch();
+    QVERIFY(!score->batchActive());
+    QVERIFY(changed > 0);
+
+    QCOMPARE(score->undoStack()->getCurIdx(), undoIdx + 1);
+    QCOMPARE(score->undoStack()->last()->childCount(), 1);
+
+    auto verify = [&](bool edited) {
+        for (size_t i = 0; i < notes.size(); ++i) {
+            QCOMPARE(notes[i]->small(), edited || smalls[i]);
+            if (!edited) {
+                QCOMPARE(notes[i]->pitch(), pitches[i]);
+            } else {
+                QVERIFY(notes[i]->pitch() == pitches[i] || notes[i]->pitch() == pitches[i] + 2);
+            }
+        }
+    };
+
+    verify(true);
+    score->undoRedo(/* undo */ true, nullptr);
+    verify(false);
+    score->undoRedo(/* undo */ false, nullptr);
+    verify(true);
+
+    // the offset is changed with undoChangeProperty(), outside of the batch command
+    Note* note = notes.front();
+    const mu::PointF offset = note->offset();
+    score->startBatch();
+    score->batchChangeProperty(note, Pid::OFFSET, QVariant::fromValue(offset + mu::PointF(1.0, 1.0)));
+    score->batchChangeProperty(note, Pid::COLOR, QVariant::fromValue(QColor(Qt::red)));
+    score->endBatch();
+
+    QCOMPARE(score->undoStack()->last()->childCount(), 2);
+    QCOMPARE(note->color(), QColor(Qt::red));
+    score->undoRedo(/* undo */ true, nullptr);
+    QCOMPARE(note->offset(), offset);
+    QVERIFY(note->color() != QColor(Qt::red));
+
+    delete score;
+}
+
+//---------------------------------------------------------
+///   batchEditBenchmark
+///   transposes all notes of a score with a batch edit
+///   and with one undo command per note
+//---------------------------------------------------------
+
+void TestNote::batchEditBenchmark_data()
+{
+    QTest::addColumn<bool>("batch");
+
+    QTest::newRow("batch") << true;
+    QTest::newRow("single") << false;
+}
+
+void TestNote::batchEditBenchmark()
+{
+    QFETCH(bool, batch);
+
+    MasterScore* score = readScore(CONCERTPITCH_DATA_DIR + "concertpitchbenchmark.mscx");
+    QVERIFY(score);
+
+    const std::vector<Note*> notes = allNotes(score);
+    qint64 changes = 0;
+    qint64 elapsed = 0;
+
+    QBENCHMARK {
+        QElapsedTimer timer;
+        timer.start();
+
+        if (batch) {
+            score->startBatch();
+        } else {
+            score->startCmd();
+        }
+        for (Note* note : notes) {
+            int pitch, tpc1, tpc2;
+            if (!transposeUp(note, pitch, tpc1, tpc2)) {
+                continue;
+            }
+            if (batch) {
+                score->batchChangePitch(note, pitch, tpc1, tpc2);
+            } else {
+                score->undoChangePitch(note, pitch, tpc1, tpc2);
+            }
+            ++changes;
+        }
+        if (batch) {
+            score->endBatch();
+        } else {
+            score->endCmd();
+        }
+
+        elapsed += timer.nsecsElapsed();
+        score->undoRedo(/* undo */ true, nullptr);
+    }
+
+    if (elapsed > 0) {
+        qDebug("%s: %.0f changes/sec", batch ? "batch" : "single", changes * 1e9 / elapsed);
+    }
+
+    delete score;
+}
+
+//---------------------------------------------------------
+///   noteTable
+///   the table has a row for every note, grace notes
+///   included, and is rebuilt after an edit
+//---------------------------------------------------------
+
+void TestNote::noteTable()
+{
+    MasterScore* score = readScore(NOTE_DATA_DIR + "grace.mscx");
+    QVERIFY(score);
+
+    size_t noteCount = allNotes(score).size();
+    for (Segment* s = score->firstSegment(SegmentType::ChordRest); s; s = s->next1(SegmentType::ChordRest)) {
+        for (Element* e : s->elist()) {
+            if (e && e->isChord()) {
+                for (Chord* grace : toChord(e)->graceNotes()) {
+                    noteCount += grace->notes().size();
+                }
+            }
+        }
+    }
+
+    const NoteTable& table = score->noteTable();
+    QCOMPARE(table.size(), noteCount);
+    QVERIFY(&score->noteTable() == &table);
+
+    bool hasGrace = false;
+    for (size_t i = 0; i < table.size(); ++i) {
+        const Note* note = table.notes()[i];
+        QCOMPARE(table.pitches()[i], note->pitch());
+        QCOMPARE(table.tpcs()[i], note->tpc());
+        QCOMPARE(table.tracks()[i], note->track());
+        QCOMPARE(table.ticks()[i], note->chord()->tick().ticks());
+        QCOMPARE(table.durations()[i], note->chord()->actualTicks().ticks());
+        QCOMPARE(bool(table.flags()[i] & NoteTable::TIE_FOR), note->tieFor() != nullptr);
+        QCOMPARE(bool(table.flags()[i] & NoteTable::GRACE), note->chord()->isGrace());
+        hasGrace |= note->chord()->isGrace();
+        if (i > 0) {
+            QVERIFY(table.tracks()[i - 1] <= table.tracks()[i]);
+            if (table.tracks()[i - 1] == table.tracks()[i]) {
+                QVERIFY(table.ticks()[i - 1] <= table.ticks()[i]);
+            }
+        }
+    }
+    QVERIFY(hasGrace);
+
+    std::pair<size_t, size_t> rows = table.trackRows(0);
+    QCOMPARE(rows.first, size_t(0));
+    for (size_t i = rows.first; i < rows.second; ++i) {
+        QCOMPARE(table.tracks()[i], 0);
+    }
+
+    Note* note = table.notes().front();
+    int pitch, tpc1, tpc2;
+    QVERIFY(transposeUp(note, pitch, tpc1, tpc2));
+    score->startCmd();
+    score->undoChangePitch(note, pitch, tpc1, tpc2);
+    score->endCmd();
+
+    const NoteTable& edited = score->noteTable();
+    QCOMPARE(edited.size(), noteCount);
+    QCOMPARE(edited.pitches().front(), pitch);
+
+    // the velocity offset of a note is applied as in playback
+    size_t row = 0;
+    while (edited.flags()[row] & NoteTable::GRACE) {
+        ++row;
+    }
+    Note* offsetNote = edited.notes()[row];
+    score->startCmd();
+    offsetNote->undoChangeProperty(Pid::VELO_TYPE, int(Note::ValueType::OFFSET_VAL));
+    offsetNote->undoChangeProperty(Pid::VELO_OFFSET, 50);
+    score->endCmd();
+
+    const int staffVelocity = offsetNote->staff()->velocities().val(offsetNote->chord()->tick());
+    QCOMPARE(score->noteTable().velocities()[row], offsetNote->customizeVelocity(staffVelocity));
+    QVERIFY(score->noteTable().velocities()[row] != staffVelocity);
+
+    delete score;
+}
+
+//---------------------------------------------------------
+///   transposeBatch
+///   the notes of a transposed selection are changed
+///   in one undo command
+//---------------------------------------------------------
+
+void TestNote::transposeBatch()
+{
+    MasterScore* score = readScore(CONCERTPITCH_DATA_DIR + "concertpitchbenchmark.mscx");
+    QVERIFY(score);
+
+    const std::vector<Note*> notes = allNotes(score);
+    QVERIFY(!notes.empty());
+    std::vector<int> pitches;
+    for (const Note* note : notes) {
+        pitches.push_back(note->pitch());
+    }
+
+    score->cmdSelectAll();
+    score->startCmd();
+    QVERIFY(score->transpose(TransposeMode::BY_INTERVAL, TransposeDirection::UP, Key::C, 4, false, true, true));
+    QVERIFY(!score->batchActive());
+    score->endCmd();
+
+    for (size_t i = 0; i < notes.size(); ++i) {
+        if (notes[i]->staff()->isPitchedStaff(notes[i]->tick())) {
+            QCOMPARE(notes[i]->pitch(), pitches[i] + 2);
+        }
+    }
+    QVERIFY(score->undoStack()->last()->childCount() < int(notes.size()));
+
+    score->undoStack()->undo(&ed);
+    for (size_t i = 0; i < notes.size(); ++i) {
+        QCOMPARE(notes[i]->pitch(), pitches[i]);
+    }
+
+    delete score;
+}
+
 QTEST_MAIN(TestNote)
 
 #include "tst_note.moc"
@@ -0,0 +1,177 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "testing/qtestsuite.h"
+#include "testbase.h"
+#include "libmscore/measure.h"
+#include "libmscore/page.h"
+#include "libmscore/score.h"
+#include "libmscore/system.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestPaintDamage
+//    what the views have to repaint of which page after
+//    an edit, see Notation::updatePageDisplayLists()
+//---------------------------------------------------------
+
+class TestPaintDamage : public QObject, public MTest
+{
+    Q_OBJECT
+
+    MasterScore* longScore();
+
+private slots:
+    void initTestCase();
+
+    void localEdit();
+    void refresh();
+    void layoutGeneration();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestPaintDamage::initTestCase()
+{
+    initMTest();
+}
+
+MasterScore* TestPaintDamage::longScore()
+{
+    MasterScore* score = readScore("test.mscx");
+    if (!score) {
+        return nullptr;
+    }
+
+    score->startCmd();
+    score->appendMeasures(200);
+    score->endCmd();
+    score->doLayout();
+    score->takePaintDamage();
+
+    return score;
+}
+
+//---------------------------------------------------------
+//   localEdit
+//    the pages before the edited one keep their painting,
+//    the edited system is repainted
+//---------------------------------------------------------
+
+void TestPaintDamage::localEdit()
+{
+    MasterScore* score = longScore();
+    QVERIFY(score);
+    QVERIFY(score->npages() >= 4);
+
+    const Page* page = score->pages().at(2);
+    Measure* measure = page->systems().at(page->systems().size() / 2)->firstMeasure();
+    QVERIFY(measure);
+
+    const int generation = score->layoutGeneration();
+
+    score->startCmd();
+    measure->undoChangeProperty(Pid::USER_STRETCH, 1.5);
+    score->endCmd();
+
+    //! NOTE The systems are laid out again in place, their pointers stay valid
+    QCOMPARE(score->layoutGeneration(), generation);
+
+    PaintDamage damage = score->takePaintDamage();
+    QVERIFY(!damage.all);
+    QVERIFY(!damage.empty());
+
+    const QList<Page*>& pages = score->pages();
+    const System* system = measure->system();
+    const int pageIdx = system->page()->no();
+    const mu::RectF systemRect = system->bbox().translated(system->pos());
+
+    const mu::RectF pageDamage = damage.pageDamage(pages, pageIdx);
+    QVERIFY(!pageDamage.isNull());
+    QVERIFY(pageDamage.top() <= systemRect.top());
+    QVERIFY(pageDamage.bottom() >= systemRect.bottom());
+
+    for (int i = 0; i < pageIdx - 1; ++i) {
+        QVERIFY2(damage.pageDamage(pages, i).isNull(), qPrintable(QString("page %1").arg(i)));
+    }
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   refresh
+//    a refreshed canvas area damages the pages it covers
+//---------------------------------------------------------
+
+void TestPaintDamage::refresh()
+{
+    MasterScore* score = longScore();
+    QVERIFY(score);
+
+    const QList<Page*>& pages = score->pages();
+    const mu::RectF pageRect = pages.at(1)->canvasBoundingRect();
+    score->addRefresh(mu::RectF(pageRect.x() + 10, pageRect.y() + 10, 20, 20));
+
+    PaintDamage damage = score->takePaintDamage();
+    QVERIFY(damage.pageDamage(pages, 0).isNull());
+    QCOMPARE(damage.pageDamage(pages, 1), mu::RectF(10, 10, 20, 20));
+    QVERIFY(damage.pageDamage(pages, 2).isNull());
+
+    QVERIFY(score->takePaintDamage().empty());
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   layoutGeneration
+//    deleting pages or systems starts a new generation,
+//    so that views don't take a new page at the address
+//    of a deleted one for the old page
+//---------------------------------------------------------
+
+void TestPaintDamage::layoutGeneration()
+{
+    MasterScore* score = longScore();
+    QVERIFY(score);
+
+    int generation = score->layoutGeneration();
+    score->doLayout();
+    QVERIFY(score->layoutGeneration() != generation);
+    QVERIFY(score->takePaintDamage().all);
+
+    // removing the measures of the last pages drops these pages
+    generation = score->layoutGeneration();
+    const int npages = score->npages();
+    score->startCmd();
+    score->deleteMeasures(score->pages().at(1)->systems().front()->firstMeasure(), score->lastMeasure());
+    score->endCmd();
+    QVERIFY(score->npages() < npages);
+    QVERIFY(score->layoutGeneration() != generation);
+
+    delete score;
+}
+
+QTEST_MAIN(TestPaintDamage)
+#include "tst_paintdamage.moc"
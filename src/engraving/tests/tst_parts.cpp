@@ -137,6 +137,8 @@ private slots:
 
     void measureProperties();
 
+    void createPartsBenchmark();
+
     // second part has system text on empty chordrest segment
     void createPart3()
     {
@@ -1219,6 +1221,35 @@ void TestParts::measureProperties()
 {
 }
 
+//---------------------------------------------------------
+//   createPartsBenchmark
+//    create a part score for every instrument of a score,
+//    like on generating the parts
+//---------------------------------------------------------
+
+void TestParts::createPartsBenchmark()
+{
+    MasterScore* score = readScore("concertpitch_data/concertpitchbenchmark.mscx");
+    QVERIFY(score);
+    QVERIFY(score->parts().size() > 1);
+
+    const int excerptCount = score->excerpts().size();
+    const QList<Excerpt*> excerpts = Excerpt::createExcerptsFromParts(score->parts());
+
+    //! NOTE Once, the parts link the elements of the score they are created from
+    QBENCHMARK_ONCE {
+        score->initExcerpts(excerpts, true);
+    }
+
+    QCOMPARE(score->excerpts().size(), excerptCount + excerpts.size());
+    for (const Excerpt* excerpt : excerpts) {
+        QVERIFY(excerpt->partScore());
+        QVERIFY(excerpt->partScore()->firstMeasure());
+    }
+
+    delete score;
+}
+
 QTEST_MAIN(TestParts)
 
 #include "tst_parts.moc"
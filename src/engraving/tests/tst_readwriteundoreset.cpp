@@ -44,6 +44,7 @@ private slots:
     void testReadWriteResetPositions();
 
     void testMMRestLinksRecreateMMRest();
+    void testUndoMemoryBudget();
 };
 
 //---------------------------------------------------------
@@ -128,5 +129,45 @@ void TestReadWriteUndoReset::testMMRestLinksRecreateMMRest()
     delete score;
 }
 
+//---------------------------------------------------------
+///   testUndoMemoryBudget
+///   The oldest macros are dropped when the undo history
+///   exceeds its budget, the last one can still be undone
+//---------------------------------------------------------
+
+void TestReadWriteUndoReset::testUndoMemoryBudget()
+{
+    MasterScore* score = readScore(RWUNDORESET_DATA_DIR + "slurs.mscx");
+    QVERIFY(score);
+
+    UndoStack* undoStack = score->undoStack();
+    const bool createMMRests = score->styleB(Sid::createMultiMeasureRests);
+
+    for (int i = 0; i < 3; ++i) {
+        score->startCmd();
+        score->undo(new ChangeStyleVal(score, Sid::createMultiMeasureRests, (i % 2 == 0) != createMMRests));
+        score->endCmd();
+    }
+
+    const size_t memoryUsage = undoStack->memoryUsage();
+    QVERIFY(memoryUsage > 0);
+    QCOMPARE(undoStack->droppedCount(), 0);
+
+    undoStack->setMemoryBudget(1);
+    QVERIFY(undoStack->memoryUsage() < memoryUsage);
+    QCOMPARE(undoStack->droppedCount(), 2);
+
+    QVERIFY(undoStack->canUndo());
+    score->undoRedo(/* undo */ true, nullptr);
+    QCOMPARE(score->styleB(Sid::createMultiMeasureRests), createMMRests);
+    QVERIFY(!undoStack->canUndo());
+
+    score->undoRedo(/* undo */ false, nullptr);
+    QCOMPARE(score->styleB(Sid::createMultiMeasureRests), !createMMRests);
+    QVERIFY(undoStack->canUndo());
+
+    delete score;
+}
+
 QTEST_MAIN(TestReadWriteUndoReset)
 #include "tst_readwriteundoreset.moc"
@@ -0,0 +1,293 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "testing/qtestsuite.h"
+#include "testbase.h"
+#include "libmscore/score.h"
+#include "compat/mscxcompat.h"
+#include "compat/scorecache.h"
+
+static const QString COMPAT206_DATA_DIR("compat206_data/");
+static const QString PARTS_DATA_DIR("parts_data/");
+
+using namespace Ms;
+using namespace mu::engraving;
+
+//---------------------------------------------------------
+//   TestScoreCache
+//---------------------------------------------------------
+
+class TestScoreCache : public QObject, public MTest
+{
+    Q_OBJECT
+
+    MasterScore* readCachedScore(const QString& name, const compat::ScoreCache& cache, bool* cacheEntryFailed = nullptr);
+    QStringList cacheEntries(const compat::ScoreCache& cache) const;
+    QByteArray sourceData(const QString& name) const;
+
+private slots:
+    void initTestCase();
+
+    void cachedEqualsUncached_data();
+    void cachedEqualsUncached();
+    void currentFormatNotCached();
+    void corruptedEntryIgnored();
+    void unreadableEntryFallback();
+    void eviction();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestScoreCache::initTestCase()
+{
+    initMTest();
+}
+
+MasterScore* TestScoreCache::readCachedScore(const QString& name, const compat::ScoreCache& cache, bool* cacheEntryFailed)
+{
+    QString path = root + "/" + name;
+
+    ScoreLoad sl;
+    bool entryFailed = false;
+    MasterScore* score = new MasterScore(mscore->baseStyle());
+    score->setName(QFileInfo(path).completeBaseName());
+    Score::FileError err = compat::loadMsczOrMscx(score, path, false, &cache, &entryFailed);
+    if (entryFailed) {
+        // as MasterNotation::load(), read the file itself into a new score
+        delete score;
+        score = new MasterScore(mscore->baseStyle());
+        score->setName(QFileInfo(path).completeBaseName());
+        err = compat::loadMsczOrMscx(score, path, false, &cache);
+    }
+    if (cacheEntryFailed) {
+        *cacheEntryFailed = entryFailed;
+    }
+    if (err != Score::FileError::FILE_NO_ERROR) {
+        delete score;
+        return nullptr;
+    }
+
+    for (Score* s : score->scoreList()) {
+        s->doLayout();
+    }
+    return score;
+}
+
+QStringList TestScoreCache::cacheEntries(const compat::ScoreCache& cache) const
+{
+    return QDir(cache.dirPath()).entryList({ "*.mscache" }, QDir::Files);
+}
+
+QByteArray TestScoreCache::sourceData(const QString& name) const
+{
+    QFile file(root + "/" + name);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+//---------------------------------------------------------
+//   cachedEqualsUncached
+//    a score read back from the cache must save exactly
+//    like the same score read from the original file
+//---------------------------------------------------------
+
+void TestScoreCache::cachedEqualsUncached_data()
+{
+    QTest::addColumn<QString>("file");
+
+    QTest::newRow("accidentals") << "accidentals";
+    QTest::newRow("hairpin") << "hairpin";
+    QTest::newRow("tuplets") << "tuplets";
+}
+
+void TestScoreCache::cachedEqualsUncached()
+{
+    QFETCH(QString, file);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    compat::ScoreCache cache(dir.path());
+
+    QString readFile(COMPAT206_DATA_DIR + file + ".mscx");
+
+    MasterScore* uncached = readCachedScore(readFile, cache);
+    QVERIFY(uncached);
+    QCOMPARE(cacheEntries(cache).size(), 1);
+
+    MasterScore* cached = readCachedScore(readFile, cache);
+    QVERIFY(cached);
+    QCOMPARE(cached->mscVersion(), uncached->mscVersion());
+    QCOMPARE(cached->mscoreVersion(), uncached->mscoreVersion());
+    QCOMPARE(cached->mscoreRevision(), uncached->mscoreRevision());
+
+    QString uncachedFile(file + "-uncached.mscx");
+    QString cachedFile(file + "-cached.mscx");
+    QVERIFY(saveScore(uncached, uncachedFile));
+    QVERIFY(saveScore(cached, cachedFile));
+    QVERIFY(compareFilesFromPaths(cachedFile, uncachedFile));
+
+    delete uncached;
+    delete cached;
+}
+
+//---------------------------------------------------------
+//   currentFormatNotCached
+//---------------------------------------------------------
+
+void TestScoreCache::currentFormatNotCached()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    compat::ScoreCache cache(dir.path());
+
+    MasterScore* score = readCachedScore(PARTS_DATA_DIR + "part-all-parts.mscx", cache);
+    QVERIFY(score);
+    QVERIFY(cacheEntries(cache).isEmpty());
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   corruptedEntryIgnored
+//    a damaged entry or changed source data must not be used
+//---------------------------------------------------------
+
+void TestScoreCache::corruptedEntryIgnored()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    compat::ScoreCache cache(dir.path());
+
+    QString readFile(COMPAT206_DATA_DIR + "accidentals.mscx");
+    MasterScore* score = readCachedScore(readFile, cache);
+    QVERIFY(score);
+    delete score;
+
+    QStringList entries = cacheEntries(cache);
+    QCOMPARE(entries.size(), 1);
+
+    QByteArray data = sourceData(readFile);
+    QVERIFY(!data.isEmpty());
+    compat::ScoreCache::SourceVersion sourceVersion;
+    QVERIFY(!cache.load(data, &sourceVersion).isEmpty());
+    QCOMPARE(sourceVersion.mscVersion, 206);
+    QVERIFY(cache.load(data + " ").isEmpty());
+
+    QFile entryFile(cache.dirPath() + "/" + entries.first());
+    QVERIFY(entryFile.open(QIODevice::ReadWrite));
+    QByteArray entryData = entryFile.readAll();
+    entryData[entryData.size() - 1] = char(~entryData.at(entryData.size() - 1));
+    entryFile.seek(0);
+    entryFile.write(entryData);
+    entryFile.close();
+
+    // the damaged entry is skipped and replaced after a normal load
+    score = readCachedScore(readFile, cache);
+    QVERIFY(score);
+    QCOMPARE(score->mscVersion(), 206);
+    delete score;
+
+    QVERIFY(entryFile.open(QIODevice::ReadOnly));
+    QVERIFY(entryFile.readAll() != entryData);
+}
+
+//---------------------------------------------------------
+//   unreadableEntryFallback
+//    a valid entry whose score cannot be read is removed
+//    and the original file is read instead
+//---------------------------------------------------------
+
+void TestScoreCache::unreadableEntryFallback()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    compat::ScoreCache cache(dir.path());
+
+    QString readFile(COMPAT206_DATA_DIR + "accidentals.mscx");
+    QByteArray data = sourceData(readFile);
+    QVERIFY(!data.isEmpty());
+
+    compat::ScoreCache::SourceVersion sourceVersion;
+    sourceVersion.mscVersion = 206;
+    QVERIFY(cache.storeData(data, "not a score", sourceVersion));
+    QVERIFY(!cache.load(data).isEmpty());
+
+    bool cacheEntryFailed = false;
+    MasterScore* score = readCachedScore(readFile, cache, &cacheEntryFailed);
+    QVERIFY(cacheEntryFailed);
+    QVERIFY(score);
+    QCOMPARE(score->mscVersion(), 206);
+    delete score;
+
+    // replaced by an entry of the score read from the file
+    score = readCachedScore(readFile, cache, &cacheEntryFailed);
+    QVERIFY(!cacheEntryFailed);
+    QVERIFY(score);
+    delete score;
+    QVERIFY(cache.load(data) != QByteArray("not a score"));
+}
+
+//---------------------------------------------------------
+//   eviction
+//    the least recently used entries are removed when the
+//    cache grows over its maximum size
+//---------------------------------------------------------
+
+void TestScoreCache::eviction()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    compat::ScoreCache cache(dir.path(), 1);
+
+    QString firstFile(COMPAT206_DATA_DIR + "accidentals.mscx");
+    QString secondFile(COMPAT206_DATA_DIR + "hairpin.mscx");
+
+    MasterScore* score = readCachedScore(firstFile, cache);
+    QVERIFY(score);
+    delete score;
+    QStringList entries = cacheEntries(cache);
+    QCOMPARE(entries.size(), 1);            // the most recent entry is always kept
+
+    QFile entryFile(cache.dirPath() + "/" + entries.first());
+    QVERIFY(entryFile.open(QIODevice::ReadWrite));
+    QVERIFY(entryFile.setFileTime(QDateTime::currentDateTime().addDays(-1), QFileDevice::FileModificationTime));
+    entryFile.close();
+
+    score = readCachedScore(secondFile, cache);
+    QVERIFY(score);
+    delete score;
+    QCOMPARE(cacheEntries(cache).size(), 1);
+    QVERIFY(cache.load(sourceData(firstFile)).isEmpty());
+    QVERIFY(!cache.load(sourceData(secondFile)).isEmpty());
+}
+
+QTEST_MAIN(TestScoreCache)
+#include "tst_scorecache.moc"
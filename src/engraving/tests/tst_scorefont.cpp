@@ -0,0 +1,179 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+#include "testing/qtestsuite.h"
+#include "testbase.h"
+#include "libmscore/scorefont.h"
+#include "libmscore/sym.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestScoreFont
+//---------------------------------------------------------
+
+class TestScoreFont : public QObject, public MTest
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void metricsCache_data();
+    void metricsCache();
+    void metricsCacheOutdated();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestScoreFont::initTestCase()
+{
+    initMTest();
+}
+
+void TestScoreFont::cleanupTestCase()
+{
+    ScoreFont::setMetricsCacheDir(QString());
+}
+
+//---------------------------------------------------------
+//   metricsCache
+//    metrics read from the .smufl cache are the same as
+//    the ones computed from the font and its metadata
+//---------------------------------------------------------
+
+void TestScoreFont::metricsCache_data()
+{
+    QTest::addColumn<QByteArray>("name");
+    QTest::addColumn<QByteArray>("family");
+    QTest::addColumn<QByteArray>("path");
+    QTest::addColumn<QByteArray>("filename");
+
+    QTest::newRow("Leland") << QByteArray("Leland") << QByteArray("Leland") << QByteArray(":/fonts/leland/")
+                            << QByteArray("Leland.otf");
+    QTest::newRow("Bravura") << QByteArray("Bravura") << QByteArray("Bravura") << QByteArray(":/fonts/bravura/")
+                             << QByteArray("Bravura.otf");
+    QTest::newRow("Emmentaler") << QByteArray("Emmentaler") << QByteArray("MScore") << QByteArray(":/fonts/mscore/")
+                                << QByteArray("mscore.ttf");
+}
+
+void TestScoreFont::metricsCache()
+{
+    QFETCH(QByteArray, name);
+    QFETCH(QByteArray, family);
+    QFETCH(QByteArray, path);
+    QFETCH(QByteArray, filename);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    ScoreFont::setMetricsCacheDir(QString());
+    ScoreFont computed(name.constData(), family.constData(), path.constData(), filename.constData());
+    computed.load();
+
+    // the first load with a cache dir computes the metrics and writes them
+    ScoreFont::setMetricsCacheDir(dir.path());
+    ScoreFont writer(name.constData(), family.constData(), path.constData(), filename.constData());
+    writer.load();
+
+    const QString cacheFilePath = dir.path() + "/" + QString::fromLatin1(name).toLower() + ".smufl";
+    QFile cacheFile(cacheFilePath);
+    QVERIFY(cacheFile.exists());
+
+    // the cache is only rewritten when the metrics are computed again
+    const QDateTime written = QDateTime::currentDateTime().addDays(-1);
+    QVERIFY(cacheFile.open(QIODevice::ReadWrite));
+    QVERIFY(cacheFile.setFileTime(written, QFileDevice::FileModificationTime));
+    cacheFile.close();
+
+    ScoreFont cached(name.constData(), family.constData(), path.constData(), filename.constData());
+    cached.load();
+    QCOMPARE(QFileInfo(cacheFilePath).lastModified(), written);
+
+    for (int i = 0; i <= int(SymId::lastSym); ++i) {
+        const Sym& expected = computed.sym(SymId(i));
+        const Sym& actual = cached.sym(SymId(i));
+        const char* symName = Sym::id2name(SymId(i));
+
+        QVERIFY2(actual.code() == expected.code(), symName);
+        QVERIFY2(actual.bbox() == expected.bbox(), symName);
+        QVERIFY2(actual.advance() == expected.advance(), symName);
+        QVERIFY2(actual.smuflAnchors() == expected.smuflAnchors(), symName);
+        QVERIFY2(actual.subSymbols() == expected.subSymbols(), symName);
+    }
+
+    QCOMPARE(cached.engravingDefaults(), computed.engravingDefaults());
+    QCOMPARE(cached.textEnclosureThickness(), computed.textEnclosureThickness());
+}
+
+//---------------------------------------------------------
+//   metricsCacheOutdated
+//    the metrics are computed again when the font file
+//    changed after the cache was written
+//---------------------------------------------------------
+
+void TestScoreFont::metricsCacheOutdated()
+{
+    QTemporaryDir fontDir;
+    QTemporaryDir cacheDir;
+    QVERIFY(fontDir.isValid());
+    QVERIFY(cacheDir.isValid());
+
+    const QString fontFilePath = fontDir.path() + "/Leland.otf";
+    QVERIFY(QFile::copy(":/fonts/leland/Leland.otf", fontFilePath));
+    QVERIFY(QFile::copy(":/fonts/leland/metadata.json", fontDir.path() + "/metadata.json"));
+    QVERIFY(QFile::setPermissions(fontFilePath, QFileDevice::ReadOwner | QFileDevice::WriteOwner));
+
+    const QByteArray fontPath = (fontDir.path() + "/").toUtf8();
+
+    ScoreFont::setMetricsCacheDir(cacheDir.path());
+    ScoreFont writer("Leland", "Leland", fontPath.constData(), "Leland.otf");
+    writer.load();
+
+    const QString cacheFilePath = cacheDir.path() + "/leland.smufl";
+    const QDateTime written = QDateTime::currentDateTime().addDays(-1);
+    QFile cacheFile(cacheFilePath);
+    QVERIFY(cacheFile.open(QIODevice::ReadWrite));
+    QVERIFY(cacheFile.setFileTime(written, QFileDevice::FileModificationTime));
+    cacheFile.close();
+
+    // the font file is replaced by an updated version
+    QFile fontFile(fontFilePath);
+    QVERIFY(fontFile.open(QIODevice::ReadWrite));
+    QVERIFY(fontFile.setFileTime(QDateTime::currentDateTime().addSecs(60), QFileDevice::FileModificationTime));
+    fontFile.close();
+
+    ScoreFont reader("Leland", "Leland", fontPath.constData(), "Leland.otf");
+    reader.load();
+    QVERIFY(QFileInfo(cacheFilePath).lastModified() != written);
+}
+
+QTEST_MAIN(TestScoreFont)
+#include "tst_scorefont.moc"
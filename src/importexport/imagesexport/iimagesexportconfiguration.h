@@ -47,6 +47,11 @@ public:
     virtual bool exportPngWithTransparentBackground() const = 0;
     virtual void setExportPngWithTransparentBackground(bool transparent) = 0;
 
+    // Svg
+    //! NOTE Each glyph is written once as a definition and referenced by <use> elements
+    virtual bool exportSvgWithGlyphDefinitions() const = 0;
+    virtual void setExportSvgWithGlyphDefinitions(bool useDefinitions) = 0;
+
     virtual int trimMarginPixelSize() const = 0;
     virtual void setTrimMarginPixelSize(std::optional<int> pixelSize) = 0;
 };
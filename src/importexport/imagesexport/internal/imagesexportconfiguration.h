@@ -39,6 +39,9 @@ public:
     bool exportPngWithTransparentBackground() const override;
     void setExportPngWithTransparentBackground(bool transparent) override;
 
+    bool exportSvgWithGlyphDefinitions() const override;
+    void setExportSvgWithGlyphDefinitions(bool useDefinitions) override;
+
     int trimMarginPixelSize() const override;
     void setTrimMarginPixelSize(std::optional<int> pixelSize) override;
 
@@ -22,7 +22,12 @@
 
 #include "pngwriter.h"
 
+#include <algorithm>
 #include <cmath>
+#include <numeric>
+
+#include <QImage>
+#include <QtConcurrent>
 
 #include "log.h"
 
@@ -30,8 +35,8 @@
 #include "libmscore/page.h"
 
 #include "engraving/draw/qpainterprovider.h"
-
-#include <QImage>
+#include "engraving/draw/bufferedpaintprovider.h"
+#include "engraving/draw/utils/drawdatapaint.h"
 
 using namespace mu::iex::imagesexport;
 using namespace mu::notation;
@@ -53,56 +58,147 @@ mu::Ret PngWriter::write(INotationPtr notation, Device& destinationDevice, const
         return make_ret(Ret::Code::UnknownError);
     }
 
-    score->setPrinting(true); // don’t print page break symbols etc.
+    const int PAGE_NUMBER = options.value(OptionKey::PAGE_NUMBER, Val(0)).toInt();
+    if (PAGE_NUMBER < 0 || PAGE_NUMBER >= score->pages().size()) {
+        return false;
+    }
 
-    double pixelRatioBackup = Ms::MScore::pixelRatio;
+    std::vector<PageRecording> recordings = recordPages(score, { PAGE_NUMBER }, options);
 
-    const int PAGE_NUMBER = options.value(OptionKey::PAGE_NUMBER, Val(0)).toInt();
-    const QList<Ms::Page*>& pages = score->pages();
+    QImage image = renderPage(recordings.front());
+    image.save(&destinationDevice, "png");
 
-    if (PAGE_NUMBER < 0 || PAGE_NUMBER >= pages.size()) {
-        return false;
+    return true;
+}
+
+mu::Ret PngWriter::writePages(INotationPtr notation, const std::vector<Device*>& destinationDevices, const Options& options)
+{
+    TRACEFUNC;
+
+    IF_ASSERT_FAILED(notation) {
+        return make_ret(Ret::Code::UnknownError);
     }
 
-    Ms::Page* page = pages[PAGE_NUMBER];
+    Ms::Score* score = notation->elements()->msScore();
+    IF_ASSERT_FAILED(score) {
+        return make_ret(Ret::Code::UnknownError);
+    }
 
-    const int TRIM_MARGIN_SIZE = configuration()->trimMarginPixelSize();
-    RectF pageRect = page->abbox();
+    if (destinationDevices.size() > size_t(score->pages().size())) {
+        return false;
+    }
 
-    if (TRIM_MARGIN_SIZE >= 0) {
-        QMarginsF margins(TRIM_MARGIN_SIZE, TRIM_MARGIN_SIZE, TRIM_MARGIN_SIZE, TRIM_MARGIN_SIZE);
-        pageRect = page->tbbox().toQRectF() + margins;
+    //! NOTE The pages are recorded one by one, since painting depends on the state of the score and MScore,
+    //! then they are rasterized and encoded concurrently
+    std::vector<int> pageNumbers(destinationDevices.size());
+    std::iota(pageNumbers.begin(), pageNumbers.end(), 0);
+
+    std::vector<PageRecording> recordings = recordPages(score, pageNumbers, options);
+
+    std::vector<char> written(recordings.size(), false);
+    auto writePage = [&recordings, &destinationDevices, &written](int pageNumber) {
+        QImage image = renderPage(recordings[pageNumber]);
+        written[pageNumber] = image.save(destinationDevices[pageNumber], "png");
+    };
+
+    //! NOTE Pixmaps can only be drawn on the main thread
+    std::vector<int> concurrentPages;
+    for (int pageNumber : pageNumbers) {
+        if (recordings[pageNumber].hasPixmaps) {
+            writePage(pageNumber);
+        } else {
+            concurrentPages.push_back(pageNumber);
+        }
     }
 
-    const float CANVAS_DPI = configuration()->exportPngDpiResolution();
-    int width = std::lrint(pageRect.width() * CANVAS_DPI / Ms::DPI);
-    int height = std::lrint(pageRect.height() * CANVAS_DPI / Ms::DPI);
+    QtConcurrent::blockingMap(concurrentPages, writePage);
+
+    bool ok = std::all_of(written.cbegin(), written.cend(), [](char w) { return w; });
+    return ok ? make_ret(Ret::Code::Ok) : make_ret(Ret::Code::InternalError);
+}
+
+std::vector<PngWriter::PageRecording> PngWriter::recordPages(Ms::Score* score, const std::vector<int>& pageNumbers,
+                                                             const Options& options) const
+{
+    score->setPrinting(true); // don’t print page break symbols etc.
 
-    QImage image(width, height, QImage::Format_ARGB32_Premultiplied);
-    image.setDotsPerMeterX(std::lrint((CANVAS_DPI * 1000) / Ms::INCH));
-    image.setDotsPerMeterY(std::lrint((CANVAS_DPI * 1000) / Ms::INCH));
+    double pixelRatioBackup = Ms::MScore::pixelRatio;
 
+    const int TRIM_MARGIN_SIZE = configuration()->trimMarginPixelSize();
+    const float CANVAS_DPI = configuration()->exportPngDpiResolution();
     const bool TRANSPARENT_BACKGROUND = options.value(OptionKey::TRANSPARENT_BACKGROUND, Val(false)).toBool();
-    image.fill(TRANSPARENT_BACKGROUND ? 0 : Qt::white);
 
     double scaling = CANVAS_DPI / Ms::DPI;
     Ms::MScore::pixelRatio = 1.0 / scaling;
 
-    mu::draw::Painter painter(&image, "pngwriter");
-    painter.setAntialiasing(true);
-    painter.scale(scaling, scaling);
-    if (TRIM_MARGIN_SIZE >= 0) {
-        painter.translate(-pageRect.topLeft());
+    std::vector<PageRecording> recordings;
+    recordings.reserve(pageNumbers.size());
+
+    for (int pageNumber : pageNumbers) {
+        const Ms::Page* page = score->pages().at(pageNumber);
+
+        RectF pageRect = page->abbox();
+        if (TRIM_MARGIN_SIZE >= 0) {
+            QMarginsF margins(TRIM_MARGIN_SIZE, TRIM_MARGIN_SIZE, TRIM_MARGIN_SIZE, TRIM_MARGIN_SIZE);
+            pageRect = page->tbbox().toQRectF() + margins;
+        }
+
+        PageRecording recording;
+        recording.imageSize = QSize(std::lrint(pageRect.width() * scaling), std::lrint(pageRect.height() * scaling));
+        recording.dotsPerMeter = std::lrint((CANVAS_DPI * 1000) / Ms::INCH);
+        recording.scaling = scaling;
+        recording.origin = TRIM_MARGIN_SIZE >= 0 ? pageRect.topLeft() : PointF();
+        recording.transparentBackground = TRANSPARENT_BACKGROUND;
+
+        const QList<Ms::Element*>& elements = page->paintOrder();
+
+        auto provider = std::make_shared<draw::BufferedPaintProvider>();
+        {
+            draw::Painter painter(provider, "pngwriter");
+            for (const Ms::Element* element : elements) {
+                if (!element->isInteractionAvailable()) {
+                    continue;
+                }
+
+                painter.beginObject(element->name(), element->pagePos());
+                Ms::paintElement(painter, element);
+                painter.endObject();
+            }
+        }
+
+        recording.data = provider->drawData();
+        for (const draw::DrawData::Object& obj : recording.data.objects) {
+            for (const draw::DrawData::Data& d : obj.datas) {
+                recording.hasPixmaps = recording.hasPixmaps || !d.pixmaps.empty() || !d.tiledPixmap.empty();
+            }
+        }
+
+        recordings.push_back(std::move(recording));
     }
 
-    QList<Ms::Element*> elements = page->elements();
-    std::stable_sort(elements.begin(), elements.end(), Ms::elementLessThan);
-
-    Ms::paintElements(painter, elements);
-    image.save(&destinationDevice, "png");
-
     score->setPrinting(false);
     Ms::MScore::pixelRatio = pixelRatioBackup;
 
-    return true;
+    return recordings;
+}
+
+QImage PngWriter::renderPage(const PageRecording& recording)
+{
+    QImage image(recording.imageSize, QImage::Format_ARGB32_Premultiplied);
+    image.setDotsPerMeterX(recording.dotsPerMeter);
+    image.setDotsPerMeterY(recording.dotsPerMeter);
+    image.fill(recording.transparentBackground ? 0 : Qt::white);
+
+    draw::Painter painter(&image, "pngwriter");
+    painter.setAntialiasing(true);
+    painter.scale(recording.scaling, recording.scaling);
+    painter.translate(-recording.origin);
+
+    for (const draw::DrawData::Object& obj : recording.data.objects) {
+        draw::DrawDataPaint::paint(&painter, obj);
+    }
+
+    painter.endDraw();
+
+    return image;
 }
@@ -23,11 +23,20 @@
 #ifndef MU_IMPORTEXPORT_PNGWRITER_H
 #define MU_IMPORTEXPORT_PNGWRITER_H
 
+#include <QSize>
+
 #include "notation/abstractnotationwriter.h"
+#include "draw/buffereddrawtypes.h"
 
 #include "../iimagesexportconfiguration.h"
 #include "modularity/ioc.h"
 
+class QImage;
+
+namespace Ms {
+class Score;
+}
+
 namespace mu::iex::imagesexport {
 class PngWriter : public notation::AbstractNotationWriter
 {
@@ -36,6 +45,24 @@ class PngWriter : public notation::AbstractNotationWriter
 public:
     std::vector<notation::INotationWriter::UnitType> supportedUnitTypes() const override;
     Ret write(notation::INotationPtr notation, io::Device& destinationDevice, const Options& options = Options()) override;
+    Ret writePages(notation::INotationPtr notation, const std::vector<io::Device*>& destinationDevices,
+                   const Options& options = Options()) override;
+
+private:
+    //! NOTE The painting of a page, recorded with the score set up for printing.
+    //! It does not refer to the score, so it can be rendered on any thread.
+    struct PageRecording {
+        QSize imageSize;
+        int dotsPerMeter = 0;
+        qreal scaling = 1.0;
+        PointF origin;
+        bool transparentBackground = false;
+        bool hasPixmaps = false;
+        draw::DrawData data;
+    };
+
+    std::vector<PageRecording> recordPages(Ms::Score* score, const std::vector<int>& pageNumbers, const Options& options) const;
+    static QImage renderPage(const PageRecording& recording);
 };
 }
 
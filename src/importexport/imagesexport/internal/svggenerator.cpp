@@ -21,6 +21,7 @@
  */
 
 #include <QTextStream>
+#include <QHash>
 #include <QBuffer>
 #include <QTextCodec>
 #include <QPainterPath>
@@ -170,9 +171,11 @@ public:
     QTextStream* stream;
     int resolution;
 
-    QString header;
 //    QString defs; // NEEDED FOR GRADIENTS
-    QString body;
+
+    // The ids of the glyph definitions written so far, by the font and the text
+    bool useGlyphDefinitions = false;
+    QHash<QString, int> glyphDefinitions;
 
     QBrush brush;
     QPen pen;
@@ -222,6 +225,7 @@ class SvgPaintEngine : public QPaintEngine
 private:
     QString stateString;
     QTextStream stateStream;
+    QString textStateString; // the attributes of the <use> elements of glyphs
     SvgPaintEnginePrivate* d_ptr;
 
 // Qt translates everything. These help avoid SVG transform="translate()".
@@ -233,6 +237,7 @@ protected:
     const Ms::Element* _element = NULL;
 
     void writeImage(const QRectF& r, const QByteArray& imageData, const QString& mimeFormat);
+    void writePathData(const QPainterPath& p, qreal dx, qreal dy);
 
 // SVG strings as constants
 #define SVG_SPACE    ' '
@@ -279,6 +284,14 @@ protected:
 #define SVG_IMAGE       "<image"
 #define SVG_PATH        "<path"
 #define SVG_POLYLINE    "<polyline"
+#define SVG_USE         "<use"
+
+#define SVG_DEFS_BEGIN  "<defs>"
+#define SVG_DEFS_END    "</defs>"
+
+#define SVG_ID          " id=\""
+#define SVG_HREF        " xlink:href=\"#"
+#define SVG_GLYPH_ID    "glyph"
 
 #define SVG_PRESERVE_ASPECT " preserveAspectRatio=\""
 
@@ -318,6 +331,7 @@ public:
     void popGroup();
 
     void drawPath(const QPainterPath& path);
+    void drawTextItem(const QPointF& p, const QTextItem& textItem);
     void drawPixmap(const QRectF& r, const QPixmap& pm, const QRectF& sr);
     void drawPolygon(const QPoint* points, int pointCount, PolygonDrawMode mode) { QPaintEngine::drawPolygon(points, pointCount, mode); }
     void drawPolygon(const QPointF* points, int pointCount, PolygonDrawMode mode);
@@ -358,6 +372,13 @@ public:
         d_func()->outputDevice = device;
     }
 
+    bool useGlyphDefinitions() const { return d_func()->useGlyphDefinitions; }
+    void setUseGlyphDefinitions(bool use)
+    {
+        Q_ASSERT(!isActive());
+        d_func()->useGlyphDefinitions = use;
+    }
+
     int resolution() { return d_func()->resolution; }
     void setResolution(int resolution)
     {
@@ -949,6 +970,31 @@ void SvgGenerator::setResolution(int dpi)
     d->engine->setResolution(dpi);
 }
 
+/*!
+    \property SvgGenerator::useGlyphDefinitions
+    \brief whether each text run is written once as a definition
+
+    When enabled, the outline of each distinct glyph or text run is written
+    once inside <defs> and every occurrence is a <use> element referencing it,
+    which makes scores with many repeated noteheads and accidentals much smaller.
+    By default the text is written as a path at every occurrence.
+*/
+bool SvgGenerator::useGlyphDefinitions() const
+{
+    Q_D(const SvgGenerator);
+    return d->engine->useGlyphDefinitions();
+}
+
+void SvgGenerator::setUseGlyphDefinitions(bool use)
+{
+    Q_D(SvgGenerator);
+    if (d->engine->isActive()) {
+        qWarning("SvgGenerator::setUseGlyphDefinitions(), cannot change it while SVG is being generated");
+        return;
+    }
+    d->engine->setUseGlyphDefinitions(use);
+}
+
 /*!
     Returns the paint engine used to render graphics to be converted to SVG
     format information.
@@ -1031,8 +1077,14 @@ bool SvgPaintEngine::begin(QPaintDevice*)
         return false;
     }
 
+    // Stream the document straight to the device, nothing is kept in memory
+    d->stream = new QTextStream(d->outputDevice);
+#ifndef QT_NO_TEXTCODEC
+    d->stream->setCodec(QTextCodec::codecForName("UTF-8"));
+#endif
+    d->glyphDefinitions.clear();
+
     // Stream the headers
-    d->stream = new QTextStream(&d->header);
     stream() << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>" << Qt::endl << SVG_BEGIN;
     if (d->viewBox.isValid()) {
         // viewBox has floating point values, size width/height is integer
@@ -1054,12 +1106,6 @@ bool SvgPaintEngine::begin(QPaintDevice*)
         stream() << SVG_DESC_BEGIN << d->attributes.description.toHtmlEscaped() << SVG_DESC_END << Qt::endl;
     }
 
-// <defs> is currently empty. It's necessary for gradients.
-//    d->stream->setString(&d->defs);
-//    *d->stream << "<defs>\n";
-
-    // Point the stream at the body string, for other functions to populate
-    d->stream->setString(&d->body);
     return true;
 }
 
@@ -1067,24 +1113,10 @@ bool SvgPaintEngine::end()
 {
     Q_D(SvgPaintEngine);
 
-// <defs> is currently empty
-//    d->stream->setString(&d->defs);
-//    stream() << "</defs>\n";
-
-    // Point the stream at the real output device (the .svg file)
-    d->stream->setDevice(d->outputDevice);
-
-#ifndef QT_NO_TEXTCODEC
-    d->stream->setCodec(QTextCodec::codecForName("UTF-8"));
-#endif
-
-    // Stream our strings out to the device, in order
-    stream() << d->header;
-//    stream() << d->defs;
-    stream() << d->body;
     stream() << SVG_END << Qt::endl;
 
     delete d->stream;
+    d->stream = nullptr;
     return true;
 }
 
@@ -1167,6 +1199,16 @@ void SvgPaintEngine::updateState(const QPaintEngineState& s)
         stateStream << SVG_OPACITY << s.opacity() << SVG_QUOTE;
     }
 
+    // Glyphs are filled with the pen, as QPaintEngine::drawTextItem() does
+    textStateString.clear();
+    QTextStream textStateStream(&textStateString);
+    textStateStream << SVG_CLASS << getClass(_element) << SVG_QUOTE;
+    textStateStream << qbrushToSvg(s.pen().brush());
+
+    if (!qFuzzyIsNull(s.opacity() - 1)) {
+        textStateStream << SVG_OPACITY << s.opacity() << SVG_QUOTE;
+    }
+
     // Translations, SVG transform="translate()", are handled separately from
     // other transformations such as rotation. Qt translates everything, but
     // other transformations do occur, and must be handled here.
@@ -1188,12 +1230,14 @@ void SvgPaintEngine::updateState(const QPaintEngineState& s)
         // Other transformations are more straightforward with a full matrix
         _dx = 0;
         _dy = 0;
-        stateStream << SVG_MATRIX << t.m11() << SVG_COMMA
-                    << t.m12() << SVG_COMMA
-                    << t.m21() << SVG_COMMA
-                    << t.m22() << SVG_COMMA
-                    << t.m31() << SVG_COMMA
-                    << t.m32() << SVG_RPAREN_QUOTE;
+        for (QTextStream* str : { &stateStream, &textStateStream }) {
+            *str << SVG_MATRIX << t.m11() << SVG_COMMA
+                 << t.m12() << SVG_COMMA
+                 << t.m21() << SVG_COMMA
+                 << t.m22() << SVG_COMMA
+                 << t.m31() << SVG_COMMA
+                 << t.m32() << SVG_RPAREN_QUOTE;
+        }
     }
 }
 
@@ -1209,10 +1253,16 @@ void SvgPaintEngine::drawPath(const QPainterPath& p)
 
     // Path data
     stream() << SVG_D;
+    writePathData(p, _dx, _dy);
+    stream() << SVG_QUOTE << SVG_ELEMENT_END << Qt::endl;
+}
+
+void SvgPaintEngine::writePathData(const QPainterPath& p, qreal dx, qreal dy)
+{
     for (int i = 0; i < p.elementCount(); ++i) {
         const QPainterPath::Element& e = p.elementAt(i);
-        qreal x = e.x + _dx;
-        qreal y = e.y + _dy;
+        qreal x = e.x + dx;
+        qreal y = e.y + dy;
         switch (e.type) {
         case QPainterPath::MoveToElement:
             stream() << SVG_MOVE << x << SVG_COMMA << y;
@@ -1226,8 +1276,8 @@ void SvgPaintEngine::drawPath(const QPainterPath& p)
             while (i < p.elementCount()) {
                 const QPainterPath::Element& ee = p.elementAt(i);
                 if (ee.type == QPainterPath::CurveToDataElement) {
-                    stream() << SVG_SPACE << ee.x + _dx
-                             << SVG_COMMA << ee.y + _dy;
+                    stream() << SVG_SPACE << ee.x + dx
+                             << SVG_COMMA << ee.y + dy;
                     ++i;
                 } else {
                     --i;
@@ -1242,7 +1292,44 @@ void SvgPaintEngine::drawPath(const QPainterPath& p)
             stream() << SVG_SPACE;
         }
     }
-    stream() << SVG_QUOTE << SVG_ELEMENT_END << Qt::endl;
+}
+
+void SvgPaintEngine::drawTextItem(const QPointF& p, const QTextItem& textItem)
+{
+    Q_D(SvgPaintEngine);
+
+    // Glyph runs have no text, right-to-left runs are laid out by QPaintEngine
+    const QString text = textItem.text();
+    if (!d->useGlyphDefinitions || text.isEmpty() || textItem.renderFlags().testFlag(QTextItem::RightToLeft)) {
+        QPaintEngine::drawTextItem(p, textItem);
+        return;
+    }
+
+    // The font of the item is resolved for this device, so its size is right
+    const QFont font = textItem.font();
+    const QString key = font.key() + QLatin1Char(',') + QString::number(font.letterSpacing())
+                        + QLatin1Char(',') + QString::number(font.wordSpacing()) + QLatin1Char(':') + text;
+
+    int id = d->glyphDefinitions.value(key, 0);
+    if (id == 0) {
+        id = d->glyphDefinitions.size() + 1;
+        d->glyphDefinitions.insert(key, id);
+
+        QPainterPath path;
+        path.setFillRule(Qt::WindingFill);
+        path.addText(QPointF(0, 0), font, text);
+
+        // A definition may come anywhere in the document, so it is written just before its first use
+        stream() << SVG_DEFS_BEGIN << SVG_PATH << SVG_ID << SVG_GLYPH_ID << id << SVG_QUOTE << SVG_D;
+        writePathData(path, 0, 0);
+        stream() << SVG_QUOTE << SVG_ELEMENT_END << SVG_DEFS_END << Qt::endl;
+    }
+
+    stream() << SVG_USE << textStateString
+             << SVG_HREF << SVG_GLYPH_ID << id << SVG_QUOTE
+             << SVG_X << SVG_QUOTE << p.x() + _dx << SVG_QUOTE
+             << SVG_Y << SVG_QUOTE << p.y() + _dy << SVG_QUOTE
+             << SVG_ELEMENT_END << Qt::endl;
 }
 
 void SvgPaintEngine::drawPolygon(const QPointF* points, int pointCount,
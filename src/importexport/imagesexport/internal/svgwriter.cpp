@@ -22,6 +22,10 @@
 
 #include "svgwriter.h"
 
+#include <numeric>
+
+#include <QtConcurrent>
+
 #include "log.h"
 
 #include "svggenerator.h"
@@ -34,6 +38,8 @@
 #include "libmscore/stafflines.h"
 
 #include "engraving/draw/qpainterprovider.h"
+#include "engraving/draw/bufferedpaintprovider.h"
+#include "engraving/draw/utils/drawdatapaint.h"
 
 using namespace mu::iex::imagesexport;
 using namespace mu::notation;
@@ -55,167 +61,224 @@ mu::Ret SvgWriter::write(INotationPtr notation, Device& destinationDevice, const
         return make_ret(Ret::Code::UnknownError);
     }
 
-    score->setPrinting(true); // don’t print page break symbols etc.
-
-    Ms::MScore::pdfPrinting = true;
-    Ms::MScore::svgPrinting = true;
-
-    const QList<Ms::Page*>& pages = score->pages();
-    double pixelRationBackup = Ms::MScore::pixelRatio;
-
     const int PAGE_NUMBER = options.value(OptionKey::PAGE_NUMBER, Val(0)).toInt();
-    if (PAGE_NUMBER < 0 || PAGE_NUMBER >= pages.size()) {
+    if (PAGE_NUMBER < 0 || PAGE_NUMBER >= score->pages().size()) {
         return false;
     }
 
-    Ms::Page* page = pages.at(PAGE_NUMBER);
+    std::vector<PageRecording> recordings = recordPages(score, { PAGE_NUMBER }, options);
+    renderPage(recordings.front(), destinationDevice); // Writes MuseScore SVG file to disk, finally
 
-    SvgGenerator printer;
-    QString title(score->title());
-    printer.setTitle(pages.size() > 1 ? QString("%1 (%2)").arg(title).arg(PAGE_NUMBER + 1) : title);
-    printer.setOutputDevice(&destinationDevice);
+    return true;
+}
 
-    const int TRIM_MARGINS_SIZE = configuration()->trimMarginPixelSize();
+mu::Ret SvgWriter::writePages(INotationPtr notation, const std::vector<Device*>& destinationDevices, const Options& options)
+{
+    TRACEFUNC;
 
-    RectF pageRect = page->abbox();
-    if (TRIM_MARGINS_SIZE >= 0) {
-        QMarginsF margins(TRIM_MARGINS_SIZE, TRIM_MARGINS_SIZE, TRIM_MARGINS_SIZE, TRIM_MARGINS_SIZE);
-        pageRect = RectF::fromQRectF(page->tbbox().toQRectF() + margins);
+    IF_ASSERT_FAILED(notation) {
+        return make_ret(Ret::Code::UnknownError);
     }
 
-    qreal width = pageRect.width();
-    qreal height = pageRect.height();
-    printer.setSize(QSize(width, height));
-    printer.setViewBox(QRectF(0, 0, width, height));
+    Ms::Score* score = notation->elements()->msScore();
+    IF_ASSERT_FAILED(score) {
+        return make_ret(Ret::Code::UnknownError);
+    }
 
-    mu::draw::Painter painter(&printer, "svgwriter");
-    painter.setAntialiasing(true);
-    if (TRIM_MARGINS_SIZE >= 0) {
-        painter.translate(-pageRect.topLeft());
+    if (destinationDevices.size() > size_t(score->pages().size())) {
+        return false;
     }
 
-    Ms::MScore::pixelRatio = Ms::DPI / printer.logicalDpiX();
+    //! NOTE The pages are recorded one by one, since painting depends on the state of the score and MScore,
+    //! then they are written concurrently
+    std::vector<int> pageNumbers(destinationDevices.size());
+    std::iota(pageNumbers.begin(), pageNumbers.end(), 0);
+
+    std::vector<PageRecording> recordings = recordPages(score, pageNumbers, options);
 
-    if (!options[OptionKey::TRANSPARENT_BACKGROUND].toBool()) {
-        painter.fillRect(pageRect, Qt::white);
+    auto writePage = [&recordings, &destinationDevices](int pageNumber) {
+        renderPage(recordings[pageNumber], *destinationDevices[pageNumber]);
+    };
+
+    //! NOTE Pixmaps can only be drawn on the main thread
+    std::vector<int> concurrentPages;
+    for (int pageNumber : pageNumbers) {
+        if (recordings[pageNumber].hasPixmaps) {
+            writePage(pageNumber);
+        } else {
+            concurrentPages.push_back(pageNumber);
+        }
     }
 
-    // 1st pass: StaffLines
-    for (const Ms::System* system : page->systems()) {
-        int stavesCount = system->staves()->size();
+    QtConcurrent::blockingMap(concurrentPages, writePage);
 
-        for (int staffIndex = 0; staffIndex < stavesCount; ++staffIndex) {
-            if (score->staff(staffIndex)->invisible(Ms::Fraction(0, 1)) || !score->staff(staffIndex)->show()) {
-                continue; // ignore invisible staves
-            }
+    return make_ret(Ret::Code::Ok);
+}
 
-            if (system->staves()->isEmpty() || !system->staff(staffIndex)->show()) {
-                continue;
-            }
+std::vector<SvgWriter::PageRecording> SvgWriter::recordPages(Ms::Score* score, const std::vector<int>& pageNumbers,
+                                                             const Options& options) const
+{
+    score->setPrinting(true); // don’t print page break symbols etc.
 
-            Ms::Measure* firstMeasure = system->firstMeasure();
-            if (!firstMeasure) { // only boxes, hence no staff lines
-                continue;
-            }
+    Ms::MScore::pdfPrinting = true;
+    Ms::MScore::svgPrinting = true;
+
+    const QList<Ms::Page*>& pages = score->pages();
+    double pixelRationBackup = Ms::MScore::pixelRatio;
+    Ms::MScore::pixelRatio = Ms::DPI / SvgGenerator().logicalDpiX();
+
+    const int TRIM_MARGINS_SIZE = configuration()->trimMarginPixelSize();
+    const bool USE_GLYPH_DEFINITIONS = configuration()->exportSvgWithGlyphDefinitions();
+    const QString title(score->title());
+    NotesColors notesColors = parseNotesColors(options.value(OptionKey::NOTES_COLORS, Val()).toQVariant());
+
+    std::vector<PageRecording> recordings;
+    recordings.reserve(pageNumbers.size());
+
+    for (int pageNumber : pageNumbers) {
+        const Ms::Page* page = pages.at(pageNumber);
+
+        PageRecording recording;
+        recording.title = pages.size() > 1 ? QString("%1 (%2)").arg(title).arg(pageNumber + 1) : title;
+        recording.pageRect = page->abbox();
+        if (TRIM_MARGINS_SIZE >= 0) {
+            QMarginsF margins(TRIM_MARGINS_SIZE, TRIM_MARGINS_SIZE, TRIM_MARGINS_SIZE, TRIM_MARGINS_SIZE);
+            recording.pageRect = RectF::fromQRectF(page->tbbox().toQRectF() + margins);
+            recording.origin = recording.pageRect.topLeft();
+        }
+        recording.transparentBackground = options[OptionKey::TRANSPARENT_BACKGROUND].toBool();
+        recording.useGlyphDefinitions = USE_GLYPH_DEFINITIONS;
 
-            // The goal here is to draw SVG staff lines more efficiently.
-            // MuseScore draws staff lines by measure, but for SVG they can
-            // generally be drawn once for each system. This makes a big
-            // difference for scores that scroll horizontally on a single
-            // page. But there are exceptions to this rule:
-            //
-            //   ~ One (or more) invisible measure(s) in a system/staff ~
-            //   ~ One (or more) elements of type HBOX or VBOX          ~
-            //
-            // In these cases the SVG staff lines for the system/staff
-            // are drawn by measure.
-            //
-            bool byMeasure = false;
-            for (Ms::MeasureBase* measure = firstMeasure; measure; measure = system->nextMeasure(measure)) {
-                if (!measure->isMeasure() || !Ms::toMeasure(measure)->visible(staffIndex)) {
-                    byMeasure = true;
-                    break;
+        auto provider = std::make_shared<draw::BufferedPaintProvider>();
+        draw::Painter painter(provider, "svgwriter");
+
+        auto paintElement = [&painter, &recording](const Ms::Element* element, const Ms::Element* classElement) {
+            painter.beginObject(element->name(), element->pagePos());
+            Ms::paintElement(painter, element);
+            painter.endObject();
+            recording.elements.push_back(classElement);
+        };
+
+        // 1st pass: StaffLines
+        for (const Ms::System* system : page->systems()) {
+            int stavesCount = system->staves()->size();
+
+            for (int staffIndex = 0; staffIndex < stavesCount; ++staffIndex) {
+                if (score->staff(staffIndex)->invisible(Ms::Fraction(0, 1)) || !score->staff(staffIndex)->show()) {
+                    continue; // ignore invisible staves
+                }
+
+                if (system->staves()->isEmpty() || !system->staff(staffIndex)->show()) {
+                    continue;
                 }
-            }
 
-            if (byMeasure) {     // Draw visible staff lines by measure
+                Ms::Measure* firstMeasure = system->firstMeasure();
+                if (!firstMeasure) { // only boxes, hence no staff lines
+                    continue;
+                }
+
+                // The goal here is to draw SVG staff lines more efficiently.
+                // MuseScore draws staff lines by measure, but for SVG they can
+                // generally be drawn once for each system. This makes a big
+                // difference for scores that scroll horizontally on a single
+                // page. But there are exceptions to this rule:
+                //
+                //   ~ One (or more) invisible measure(s) in a system/staff ~
+                //   ~ One (or more) elements of type HBOX or VBOX          ~
+                //
+                // In these cases the SVG staff lines for the system/staff
+                // are drawn by measure.
+                //
+                bool byMeasure = false;
                 for (Ms::MeasureBase* measure = firstMeasure; measure; measure = system->nextMeasure(measure)) {
-                    if (measure->isMeasure() && Ms::toMeasure(measure)->visible(staffIndex)) {
-                        Ms::StaffLines* sl = Ms::toMeasure(measure)->staffLines(staffIndex);
-                        printer.setElement(sl);
-                        Ms::paintElement(painter, sl);
+                    if (!measure->isMeasure() || !Ms::toMeasure(measure)->visible(staffIndex)) {
+                        byMeasure = true;
+                        break;
                     }
                 }
-            } else {   // Draw staff lines once per system
-                Ms::StaffLines* firstSL = system->firstMeasure()->staffLines(staffIndex)->clone();
-                Ms::StaffLines* lastSL =  system->lastMeasure()->staffLines(staffIndex);
-
-                qreal lastX =  lastSL->bbox().right()
-                              + lastSL->pagePos().x()
-                              - firstSL->pagePos().x();
-                std::vector<mu::LineF>& lines = firstSL->getLines();
-                for (size_t l = 0, c = lines.size(); l < c; l++) {
-                    lines[l].setP2(mu::PointF(lastX, lines[l].p2().y()));
-                }
 
-                printer.setElement(firstSL);
-                Ms::paintElement(painter, firstSL);
+                if (byMeasure) {     // Draw visible staff lines by measure
+                    for (Ms::MeasureBase* measure = firstMeasure; measure; measure = system->nextMeasure(measure)) {
+                        if (measure->isMeasure() && Ms::toMeasure(measure)->visible(staffIndex)) {
+                            Ms::StaffLines* sl = Ms::toMeasure(measure)->staffLines(staffIndex);
+                            paintElement(sl, sl);
+                        }
+                    }
+                } else {   // Draw staff lines once per system
+                    Ms::StaffLines* firstSL = system->firstMeasure()->staffLines(staffIndex)->clone();
+                    Ms::StaffLines* lastSL =  system->lastMeasure()->staffLines(staffIndex);
+
+                    qreal lastX =  lastSL->bbox().right()
+                                  + lastSL->pagePos().x()
+                                  - firstSL->pagePos().x();
+                    std::vector<mu::LineF>& lines = firstSL->getLines();
+                    for (size_t l = 0, c = lines.size(); l < c; l++) {
+                        lines[l].setP2(mu::PointF(lastX, lines[l].p2().y()));
+                    }
+
+                    paintElement(firstSL, lastSL);
+                    delete firstSL;
+                }
             }
         }
-    }
 
-    // 2nd pass: the rest of the elements
-    QList<Ms::Element*> elements = page->elements();
-    std::stable_sort(elements.begin(), elements.end(), Ms::elementLessThan);
+        // 2nd pass: the rest of the elements
+        QList<Ms::Element*> elements = page->elements();
+        std::stable_sort(elements.begin(), elements.end(), Ms::elementLessThan);
 
-    int lastNoteIndex = -1;
-    for (int i = 0; i < PAGE_NUMBER; ++i) {
-        for (const Ms::Element* element: pages[i]->elements()) {
-            if (element->type() == Ms::ElementType::NOTE) {
-                lastNoteIndex++;
+        int lastNoteIndex = -1;
+        for (int i = 0; i < pageNumber; ++i) {
+            for (const Ms::Element* element: pages[i]->elements()) {
+                if (element->type() == Ms::ElementType::NOTE) {
+                    lastNoteIndex++;
+                }
             }
         }
-    }
 
-    NotesColors notesColors = parseNotesColors(options.value(OptionKey::NOTES_COLORS, Val()).toQVariant());
-
-    for (const Ms::Element* element : elements) {
-        // Always exclude invisible elements
-        if (!element->visible()) {
-            continue;
-        }
+        for (const Ms::Element* element : elements) {
+            // Always exclude invisible elements
+            if (!element->visible()) {
+                continue;
+            }
 
-        Ms::ElementType type = element->type();
-        switch (type) { // In future sub-type code, this switch() grows, and eType gets used
-        case Ms::ElementType::STAFF_LINES: // Handled in the 1st pass above
-            continue; // Exclude from 2nd pass
-            break;
-        default:
-            break;
-        }
+            Ms::ElementType type = element->type();
+            switch (type) { // In future sub-type code, this switch() grows, and eType gets used
+            case Ms::ElementType::STAFF_LINES: // Handled in the 1st pass above
+                continue; // Exclude from 2nd pass
+                break;
+            default:
+                break;
+            }
 
-        // Set the Element pointer inside SvgGenerator/SvgPaintEngine
-        printer.setElement(element);
+            // Paint it
+            if (element->type() == Ms::ElementType::NOTE && !notesColors.isEmpty()) {
+                QColor color = element->color();
+                int currentNoteIndex = (++lastNoteIndex);
 
-        // Paint it
-        if (element->type() == Ms::ElementType::NOTE && !notesColors.isEmpty()) {
-            QColor color = element->color();
-            int currentNoteIndex = (++lastNoteIndex);
+                if (notesColors.contains(currentNoteIndex)) {
+                    color = notesColors[currentNoteIndex];
+                }
 
-            if (notesColors.contains(currentNoteIndex)) {
-                color = notesColors[currentNoteIndex];
+                Ms::Element* note = dynamic_cast<const Ms::Note*>(element)->clone();
+                note->setColor(color);
+                paintElement(note, element);
+                delete note;
+            } else {
+                paintElement(element, element);
             }
+        }
 
-            Ms::Element* note = dynamic_cast<const Ms::Note*>(element)->clone();
-            note->setColor(color);
-            Ms::paintElement(painter, note);
-            delete note;
-        } else {
-            Ms::paintElement(painter, element);
+        painter.endDraw();
+
+        recording.data = provider->drawData();
+        for (const draw::DrawData::Object& obj : recording.data.objects) {
+            for (const draw::DrawData::Data& d : obj.datas) {
+                recording.hasPixmaps = recording.hasPixmaps || !d.pixmaps.empty() || !d.tiledPixmap.empty();
+            }
         }
-    }
 
-    painter.endDraw(); // Writes MuseScore SVG file to disk, finally
+        recordings.push_back(std::move(recording));
+    }
 
     // Clean up and return
     Ms::MScore::pixelRatio = pixelRationBackup;
@@ -223,7 +286,38 @@ mu::Ret SvgWriter::write(INotationPtr notation, Device& destinationDevice, const
     Ms::MScore::pdfPrinting = false;
     Ms::MScore::svgPrinting = false;
 
-    return true;
+    return recordings;
+}
+
+void SvgWriter::renderPage(const PageRecording& recording, Device& destinationDevice)
+{
+    SvgGenerator printer;
+    printer.setTitle(recording.title);
+    printer.setOutputDevice(&destinationDevice);
+    printer.setUseGlyphDefinitions(recording.useGlyphDefinitions);
+
+    qreal width = recording.pageRect.width();
+    qreal height = recording.pageRect.height();
+    printer.setSize(QSize(width, height));
+    printer.setViewBox(QRectF(0, 0, width, height));
+
+    mu::draw::Painter painter(&printer, "svgwriter");
+    painter.setAntialiasing(true);
+    painter.translate(-recording.origin);
+
+    if (!recording.transparentBackground) {
+        painter.fillRect(recording.pageRect, Qt::white);
+    }
+
+    //! NOTE The objects are recorded in paint order, the last one is the default object of the target
+    const size_t count = std::min(recording.elements.size(), recording.data.objects.size());
+    for (size_t i = 0; i < count; ++i) {
+        // Set the Element pointer inside SvgGenerator/SvgPaintEngine
+        printer.setElement(recording.elements[i]);
+        mu::draw::DrawDataPaint::paint(&painter, recording.data.objects[i]);
+    }
+
+    painter.endDraw();
 }
 
 SvgWriter::NotesColors SvgWriter::parseNotesColors(const QVariant& obj) const
@@ -24,10 +24,16 @@
 #define MU_IMPORTEXPORT_SVGWRITER_H
 
 #include "notation/abstractnotationwriter.h"
+#include "draw/buffereddrawtypes.h"
 
 #include "modularity/ioc.h"
 #include "iimagesexportconfiguration.h"
 
+namespace Ms {
+class Score;
+class Element;
+}
+
 namespace mu::iex::imagesexport {
 class SvgWriter : public notation::AbstractNotationWriter
 {
@@ -36,11 +42,29 @@ class SvgWriter : public notation::AbstractNotationWriter
 public:
     std::vector<notation::INotationWriter::UnitType> supportedUnitTypes() const override;
     Ret write(notation::INotationPtr notation, io::Device& destinationDevice, const Options& options = Options()) override;
+    Ret writePages(notation::INotationPtr notation, const std::vector<io::Device*>& destinationDevices,
+                   const Options& options = Options()) override;
 
 private:
     using NotesColors = QHash<int /* noteIndex */, QColor>;
 
+    //! NOTE The painting of a page, recorded with the score set up for printing.
+    //! The elements are only used for the classes of the SVG elements, so it can be written on any thread.
+    struct PageRecording {
+        QString title;
+        RectF pageRect;
+        PointF origin;
+        bool transparentBackground = false;
+        bool useGlyphDefinitions = false;
+        bool hasPixmaps = false;
+        std::vector<const Ms::Element*> elements; // one per object
+        draw::DrawData data;
+    };
+
     NotesColors parseNotesColors(const QVariant& obj) const;
+
+    std::vector<PageRecording> recordPages(Ms::Score* score, const std::vector<int>& pageNumbers, const Options& options) const;
+    static void renderPage(const PageRecording& recording, io::Device& destinationDevice);
 };
 }
 
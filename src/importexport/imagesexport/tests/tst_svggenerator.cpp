@@ -0,0 +1,125 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <QBuffer>
+#include <QFont>
+#include <QPainter>
+
+#include "testing/qtestsuite.h"
+#include "importexport/imagesexport/internal/svggenerator.h"
+
+//---------------------------------------------------------
+//   TestSvgGenerator
+//    size and time of an SVG export with and without
+//    glyph definitions
+//---------------------------------------------------------
+
+class TestSvgGenerator : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void glyphDefinitions();
+
+    void glyphDefinitionsBenchmark_data();
+    void glyphDefinitionsBenchmark();
+};
+
+//---------------------------------------------------------
+//   drawGlyphs
+//    a page of noteheads, clefs and accidentals, as
+//    drawn by the score elements
+//---------------------------------------------------------
+
+static QByteArray drawGlyphs(bool useGlyphDefinitions)
+{
+    static const QList<QString> GLYPHS {
+        QString(QChar(0xE0A4)), // noteheadBlack
+        QString(QChar(0xE0A3)), // noteheadHalf
+        QString(QChar(0xE050)), // gClef
+        QString(QChar(0xE262)), // accidentalSharp
+    };
+
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+
+    SvgGenerator printer;
+    printer.setOutputDevice(&buffer);
+    printer.setSize(QSize(2100, 2970));
+    printer.setViewBox(QRectF(0, 0, 2100, 2970));
+    printer.setUseGlyphDefinitions(useGlyphDefinitions);
+
+    QFont font("Leland");
+    font.setPixelSize(20);
+
+    QPainter painter(&printer);
+    painter.setFont(font);
+    for (int row = 0; row < 100; ++row) {
+        for (int column = 0; column < 40; ++column) {
+            painter.drawText(QPointF(50 + column * 50, 25 + row * 29), GLYPHS.at((row + column) % GLYPHS.size()));
+        }
+    }
+    painter.end();
+
+    return buffer.data();
+}
+
+//---------------------------------------------------------
+//   glyphDefinitions
+//    every glyph is written once and then referenced
+//---------------------------------------------------------
+
+void TestSvgGenerator::glyphDefinitions()
+{
+    const QByteArray paths = drawGlyphs(false);
+    const QByteArray definitions = drawGlyphs(true);
+
+    qDebug() << "paths:" << paths.size() << "bytes, glyph definitions:" << definitions.size() << "bytes";
+
+    QCOMPARE(definitions.count("<defs>"), 4);
+    QCOMPARE(definitions.count("<use"), 4000);
+    QVERIFY(definitions.size() < paths.size());
+}
+
+//---------------------------------------------------------
+//   glyphDefinitionsBenchmark
+//---------------------------------------------------------
+
+void TestSvgGenerator::glyphDefinitionsBenchmark_data()
+{
+    QTest::addColumn<bool>("useGlyphDefinitions");
+
+    QTest::newRow("paths") << false;
+    QTest::newRow("glyph definitions") << true;
+}
+
+void TestSvgGenerator::glyphDefinitionsBenchmark()
+{
+    QFETCH(bool, useGlyphDefinitions);
+
+    QBENCHMARK {
+        drawGlyphs(useGlyphDefinitions);
+    }
+}
+
+QTEST_MAIN(TestSvgGenerator)
+#include "tst_svggenerator.moc"
@@ -34,6 +34,8 @@ public:
 
     virtual Ret write(INotationPtr notation, io::Device& destinationDevice, const Options& options = Options()) override;
     virtual Ret writeList(const INotationPtrList& notations, io::Device& destinationDevice, const Options& options = Options()) override;
+    virtual Ret writePages(INotationPtr notation, const std::vector<io::Device*>& destinationDevices,
+                           const Options& options = Options()) override;
 
     void abort() override;
     framework::ProgressChannel progress() const override;
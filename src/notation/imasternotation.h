@@ -41,6 +41,8 @@ public:
     virtual void setMetaInfo(const Meta& meta) = 0;
 
     virtual Ret load(const io::path& path, const io::path& stylePath = io::path(), bool forceMode = false) = 0;
+    //! NOTE Reads the state kept in an autosave journal; the score takes over the path of the original one
+    virtual Ret loadAutosave(const io::path& journalPath) = 0;
     virtual io::path path() const = 0;
 
     virtual Ret createNew(const ScoreCreateOptions& scoreInfo) = 0;
@@ -52,6 +54,8 @@ public:
     virtual ValCh<ExcerptNotationList> excerpts() const = 0;
     virtual void setExcerpts(const ExcerptNotationList& excerpts) = 0;
 
+    //! NOTE Sent while the part scores are created from the parts
+
     virtual INotationPartsPtr parts() const = 0;
     virtual INotationPtr clone() const = 0;
 
@@ -27,6 +27,7 @@
 #include "modularity/imoduleexport.h"
 #include "io/path.h"
 #include "retval.h"
+#include "async/channel.h"
 #include "notationtypes.h"
 
 namespace mu::notation {
@@ -38,6 +39,10 @@ public:
     virtual ~IMsczMetaReader() = default;
 
     virtual MetaList readMetaList(const io::paths& filePaths) const = 0;
+
+    //! Reads the files on worker threads. Meta is sent for each file as soon as it is read,
+    //! not in the order of filePaths; the channel is closed when all files are done
+    virtual async::Channel<Meta> readMetaListAsync(const io::paths& filePaths) const = 0;
 };
 }
 
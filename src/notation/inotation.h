@@ -59,9 +59,18 @@ public:
     virtual ViewMode viewMode() const = 0;
     virtual void paint(mu::draw::Painter* painter, const RectF& frameRect) = 0;
 
+    // the contents of the pages are painted by contentPainter, e.g. from a raster cache
+    virtual void paint(mu::draw::Painter* painter, const RectF& frameRect, const PageContentPainter& contentPainter) = 0;
+
     virtual ValCh<bool> opened() const = 0;
     virtual void setOpened(bool opened) = 0;
 
+    // true while the pages after the first ones are laid out progressively
+    virtual ValCh<bool> layoutInProgress() const = 0;
+
+    // lays out the remaining pages at once, needed before the pages are exported
+    virtual void finishLayout() = 0;
+
     // input (mouse)
     virtual INotationInteractionPtr interaction() const = 0;
 
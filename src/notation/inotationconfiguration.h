@@ -106,6 +106,17 @@ public:
     virtual io::path partStyleFilePath() const = 0;
     virtual void setPartStyleFilePath(const io::path& path) = 0;
 
+    virtual bool isScoreCacheEnabled() const = 0;
+    virtual void setIsScoreCacheEnabled(bool enabled) = 0;
+    virtual io::path scoreCachePath() const = 0;
+
+    virtual bool isAutoSaveEnabled() const = 0;
+    virtual void setIsAutoSaveEnabled(bool enabled) = 0;
+    virtual int autoSavePeriod() const = 0; // minutes
+    virtual void setAutoSavePeriod(int minutes) = 0;
+    virtual async::Notification autoSaveSettingsChanged() const = 0;
+    virtual io::path autoSavePath() const = 0;
+
     virtual bool isMidiInputEnabled() const = 0;
     virtual void setIsMidiInputEnabled(bool enabled) = 0;
 
@@ -142,6 +153,11 @@ public:
     virtual int notePlayDurationMilliseconds() const = 0;
     virtual void setNotePlayDurationMilliseconds(int durationMs) = 0;
 
+    virtual int undoHistoryMemoryBudgetMegabytes() const = 0;
+    virtual void setUndoHistoryMemoryBudgetMegabytes(int budgetMb) = 0;
+    virtual bool needShowWarningAboutDroppedUndoHistory() const = 0;
+    virtual void setNeedShowWarningAboutDroppedUndoHistory(bool value) = 0;
+
     virtual void setTemplateModeEnalbed(bool enabled) = 0;
     virtual void setTestModeEnabled(bool enabled) = 0;
 };
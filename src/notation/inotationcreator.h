@@ -37,6 +37,9 @@ public:
 
     virtual IMasterNotationPtr newMasterNotation() const = 0;
     virtual IExcerptNotationPtr newExcerptNotation() const = 0;
+
+    //! NOTE Autosave journals left by an instance that did not close properly
+    virtual io::paths recoverableAutosaves() const = 0;
 };
 }
 
@@ -57,6 +57,10 @@ public:
 
     virtual Ret write(INotationPtr notation, io::Device& destinationDevice, const Options& options = Options()) = 0;
     virtual Ret writeList(const INotationPtrList& notations, io::Device& destinationDevice, const Options& options = Options()) = 0;
+
+    // writes the page i of the notation to destinationDevices[i], the pages may be written concurrently
+    virtual Ret writePages(INotationPtr notation, const std::vector<io::Device*>& destinationDevices,
+                           const Options& options = Options()) = 0;
     virtual void abort() = 0;
     virtual framework::ProgressChannel progress() const = 0;
 };
@@ -68,6 +68,24 @@ mu::Ret AbstractNotationWriter::writeList(const INotationPtrList&, io::Device&,
     return Ret(Ret::Code::NotSupported);
 }
 
+mu::Ret AbstractNotationWriter::writePages(INotationPtr notation, const std::vector<io::Device*>& destinationDevices,
+                                           const Options& options)
+{
+    Ret result = make_ret(Ret::Code::Ok);
+
+    for (size_t i = 0; i < destinationDevices.size(); ++i) {
+        Options pageOptions = options;
+        pageOptions[OptionKey::PAGE_NUMBER] = Val(static_cast<int>(i));
+
+        Ret ret = write(notation, *destinationDevices[i], pageOptions);
+        if (!ret) {
+            result = ret;
+        }
+    }
+
+    return result;
+}
+
 void AbstractNotationWriter::abort()
 {
     NOT_IMPLEMENTED;
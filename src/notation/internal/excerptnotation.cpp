@@ -27,8 +27,12 @@
 using namespace mu::notation;
 
 ExcerptNotation::ExcerptNotation(Ms::Excerpt* excerpt)
-    : Notation(excerpt->partScore()), m_excerpt(excerpt)
+    : Notation(), m_excerpt(excerpt)
 {
+    //! NOTE A part score kept unparsed on load is read the first time it is accessed, see score()
+    if (m_excerpt->isPartScoreLoaded()) {
+        initScore();
+    }
 }
 
 ExcerptNotation::~ExcerptNotation()
@@ -61,13 +65,41 @@ Ms::Excerpt* ExcerptNotation::excerpt() const
 void ExcerptNotation::setExcerpt(Ms::Excerpt* excerpt)
 {
     m_excerpt = excerpt;
-    setScore(m_excerpt->partScore());
+    initScore();
     setMetaInfo(m_metaInfo);
 }
 
+void ExcerptNotation::initScore()
+{
+    setScore(m_excerpt->partScore());
+
+    m_layoutTimer.start();
+    continueLayout();
+}
+
+Ms::Score* ExcerptNotation::score() const
+{
+    if (isInited() && !Notation::score()) {
+        const_cast<ExcerptNotation*>(this)->initScore();
+    }
+
+    return Notation::score();
+}
+
 Meta ExcerptNotation::metaInfo() const
 {
-    return isInited() ? Notation::metaInfo() : m_metaInfo;
+    if (!isInited()) {
+        return m_metaInfo;
+    }
+
+    //! NOTE Only the title is known before the part score is read
+    if (!m_excerpt->isPartScoreLoaded()) {
+        Meta meta = m_metaInfo;
+        meta.title = m_excerpt->title();
+        return meta;
+    }
+
+    return Notation::metaInfo();
 }
 
 void ExcerptNotation::setMetaInfo(const Meta& meta)
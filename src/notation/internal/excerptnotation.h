@@ -49,8 +49,11 @@ public:
 
     INotationPtr clone() const override;
 
+    Ms::Score* score() const override;
+
 private:
     bool isInited() const;
+    void initScore();
 
     Ms::Excerpt* m_excerpt = nullptr;
     Meta m_metaInfo;
@@ -48,6 +48,13 @@ public:
     virtual void commitChanges() = 0;
 
     virtual async::Notification stackChanged() const = 0;
+
+    //! NOTE An estimate, in bytes, of the memory held by the undo history
+    virtual size_t historyMemoryUsage() const = 0;
+
+    //! NOTE Sent when the oldest changes can't be undone anymore, they were dropped
+    //! to keep the undo history within its memory budget
+    virtual async::Notification historyDropped() const = 0;
 };
 
 using INotationUndoStackPtr = std::shared_ptr<INotationUndoStack>;
@@ -24,12 +24,17 @@
 #include "masternotationparts.h"
 #include "scoreorderconverter.h"
 
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
 #include <QFileInfo>
 
 #include "log.h"
 #include "translation.h"
 
 #include "libmscore/score.h"
+#include "libmscore/autosavejournal.h"
 #include "libmscore/part.h"
 #include "libmscore/staff.h"
 #include "libmscore/excerpt.h"
@@ -54,10 +59,20 @@ MasterNotation::MasterNotation()
     : Notation()
 {
     m_parts = std::make_shared<MasterNotationParts>(this, interaction(), undoStack());
+
+    undoStack()->stackChanged().onNotify(this, [this]() {
+        m_lastEditTime.start();
+    });
+
+    configuration()->autoSaveSettingsChanged().onNotify(this, [this]() {
+        updateAutosaveSettings();
+    });
 }
 
 MasterNotation::~MasterNotation()
 {
+    removeAutosave();
+
     m_parts = nullptr;
 }
 
@@ -107,14 +122,29 @@ mu::Ret MasterNotation::load(const io::path& path, const io::path& stylePath, co
 {
     TRACEFUNC;
 
+    //! NOTE Only the first pages are laid out before the score is shown,
+    //! the others follow progressively, see Notation::continueLayout().
+    //! The converter exports right after loading, so it lays out all pages
+    static constexpr int FIRST_LAYOUT_PAGES = 2;
+    const bool isProgressive = stylePath.empty() && application()->runMode() == framework::IApplication::RunMode::Editor;
+
     Ms::ScoreLoad sl;
+    m_layoutTimer.start();
 
     Ms::MasterScore* score = new Ms::MasterScore(scoreGlobal()->baseStyle());
-    Ret ret = doLoadScore(score, path, reader, forceMode);
+    Ret ret = doLoadScore(score, path, reader, forceMode, isProgressive ? FIRST_LAYOUT_PAGES : -1);
+
+    if (ret.code() == static_cast<int>(Err::FileCacheEntryFailed)) {
+        //! NOTE The score is partially read from a broken cache entry, read the file itself into a new one
+        delete score;
+        score = new Ms::MasterScore(scoreGlobal()->baseStyle());
+        ret = doLoadScore(score, path, reader, forceMode, isProgressive ? FIRST_LAYOUT_PAGES : -1);
+    }
 
     if (ret) {
         setScore(score);
-        initExcerpts();
+        initExcerpts({}, isProgressive ? FIRST_LAYOUT_PAGES : -1);
+        initAutosave();
     }
 
     if (!stylePath.empty()) {
@@ -125,13 +155,19 @@ mu::Ret MasterNotation::load(const io::path& path, const io::path& stylePath, co
         LOGE() << Ms::MScore::lastError;
     }
 
+    if (ret) {
+        LOGI() << "first pages laid out in " << m_layoutTimer.elapsed() << " ms";
+        continueLayout();
+    }
+
     return ret;
 }
 
 mu::Ret MasterNotation::doLoadScore(Ms::MasterScore* score,
                                     const io::path& path,
                                     const std::shared_ptr<INotationReader>& reader,
-                                    bool forceMode) const
+                                    bool forceMode,
+                                    int layoutPages) const
 {
     QFileInfo fi(path.toQString());
     score->setName(fi.completeBaseName());
@@ -164,6 +200,16 @@ mu::Ret MasterNotation::doLoadScore(Ms::MasterScore* score,
     //score->updateExpressive(MuseScore::synthesizer("Fluid"));
     score->setSaved(true);
     score->setCreated(false);
+
+    if (layoutPages > 0) {
+        score->doLayoutPages(layoutPages);
+        for (Ms::Score* s : score->scoreList()) {
+            if (s != score) {
+                s->doLayout();
+            }
+        }
+        score->cmdState().reset();
+    }
     score->update();
 
     if (!score->sanityCheck(QString())) {
@@ -525,6 +571,8 @@ mu::Ret MasterNotation::createNew(const ScoreCreateOptions& scoreOptions)
         parts()->setParts(scoreOptions.parts);
     }
 
+    initAutosave();
+
     return make_ret(Err::NoError);
 }
 
@@ -564,6 +612,8 @@ mu::Ret MasterNotation::exportScore(const io::path& path, const std::string& suf
         return false;
     }
 
+    finishLayout();
+
     Ret ret = writer->write(shared_from_this(), file);
     file.close();
 
@@ -579,18 +629,31 @@ mu::ValNt<bool> MasterNotation::needSave() const
     return needSave;
 }
 
-void MasterNotation::initExcerpts(const QList<Ms::Excerpt*>& scoreExcerpts)
+void MasterNotation::initExcerpts(const QList<Ms::Excerpt*>& scoreExcerpts, int layoutPages)
 {
     QList<Ms::Excerpt*> excerpts = scoreExcerpts;
+    bool isNew = !excerpts.empty();
 
-    if (scoreExcerpts.empty()) {
+    //! NOTE The parts read from the file are taken as they are, their part scores
+    //! are read when the excerpt notations first access them, see ExcerptNotation::score()
+    if (excerpts.empty()) {
+        excerpts = masterScore()->excerpts();
+    }
+
+    if (excerpts.empty()) {
         excerpts = Ms::Excerpt::createExcerptsFromParts(score()->parts());
+        isNew = true;
+    }
+
+    if (isNew) {
+        //! NOTE The pages after the first ones are laid out by the excerpt notations,
+        //! see Notation::continueLayout()
+        masterScore()->initExcerpts(excerpts, true, layoutPages);
     }
 
     ExcerptNotationList notationExcerpts;
 
     for (Ms::Excerpt* excerpt : excerpts) {
-        masterScore()->initExcerpt(excerpt, true);
         notationExcerpts.push_back(std::make_shared<ExcerptNotation>(excerpt));
     }
 
@@ -711,6 +774,9 @@ mu::Ret MasterNotation::saveScore(const mu::io::path& path, SaveMode saveMode)
     } else if (saveMode != SaveMode::SaveCopy || oldFilePath == path) {
         score()->setCreated(false);
         undoStack()->stackChanged().notify();
+
+        removeAutosave();
+        initAutosave();
     }
 
     return make_ret(Ret::Code::Ok);
@@ -726,6 +792,132 @@ mu::Ret MasterNotation::saveSelectionOnScore(const mu::io::path& path)
     return ret;
 }
 
+void MasterNotation::initAutosave()
+{
+    m_autosaveTimer = nullptr;
+    m_autosaveJournal = nullptr;
+
+    if (!configuration()->isAutoSaveEnabled()) {
+        return;
+    }
+
+    QString dirPath = configuration()->autoSavePath().toQString();
+    if (!QDir().mkpath(dirPath)) {
+        LOGE() << "failed create autosave dir: " << dirPath;
+        return;
+    }
+
+    //! NOTE One journal per score file, so that it can be found again after a crash
+    QString scorePath = masterScore()->created() ? QString() : masterScore()->fileInfo()->absoluteFilePath();
+    QString key = scorePath.isEmpty() ? QString::number(QDateTime::currentMSecsSinceEpoch()) : scorePath;
+    QString name = QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex().left(16);
+    m_autosaveJournal = std::make_unique<Ms::AutosaveJournal>(dirPath + "/" + name + ".journal", scorePath);
+
+    m_autosaveTimer = std::make_unique<QTimer>();
+    m_autosaveTimer->setInterval(std::max(configuration()->autoSavePeriod(), 1) * 60 * 1000);
+    QObject::connect(m_autosaveTimer.get(), &QTimer::timeout, [this]() {
+        autosave();
+    });
+    m_autosaveTimer->start();
+}
+
+void MasterNotation::updateAutosaveSettings()
+{
+    if (!masterScore()) {
+        return;
+    }
+
+    if (m_autosaveTimer && configuration()->isAutoSaveEnabled()) {
+        //! NOTE Restarts the timer with the new period
+        m_autosaveTimer->start(std::max(configuration()->autoSavePeriod(), 1) * 60 * 1000);
+        return;
+    }
+
+    if (m_autosaveJournal) {
+        m_autosaveJournal->remove();
+    }
+    initAutosave();
+}
+
+void MasterNotation::autosave()
+{
+    //! NOTE The measures edited since the last autosave are serialized on the main thread, so wait until the user pauses editing
+    static constexpr int IDLE_TIME = 3000; // ms
+
+    Ms::MasterScore* score = masterScore();
+    if (!score || !m_autosaveJournal || !score->dirty()) {
+        return;
+    }
+
+    if (m_lastEditTime.isValid() && !m_lastEditTime.hasExpired(IDLE_TIME)) {
+        QTimer::singleShot(IDLE_TIME, m_autosaveTimer.get(), [this]() {
+            autosave();
+        });
+        return;
+    }
+
+    TRACEFUNC;
+
+    m_autosaveJournal->save(score);
+}
+
+//! NOTE Called when the score is saved or closed, the journal is not needed anymore then
+void MasterNotation::removeAutosave()
+{
+    if (m_autosaveJournal) {
+        m_autosaveJournal->remove();
+    }
+
+    if (!m_recoveredJournalPath.isEmpty()) {
+        QFile::remove(m_recoveredJournalPath);
+        m_recoveredJournalPath.clear();
+    }
+}
+
+mu::Ret MasterNotation::loadAutosave(const io::path& journalPath)
+{
+    TRACEFUNC;
+
+    QByteArray mscxData;
+    QString scorePath;
+    if (!Ms::AutosaveJournal::recover(journalPath.toQString(), mscxData, &scorePath)) {
+        return make_ret(Err::FileCorrupted, journalPath);
+    }
+
+    //! NOTE The recovered state is read like a regular file, then takes over the path of the original score
+    QString recoveredFilePath = journalPath.toQString() + ".mscx";
+    QFile recoveredFile(recoveredFilePath);
+    if (!recoveredFile.open(QIODevice::WriteOnly) || recoveredFile.write(mscxData) != mscxData.size()) {
+        return make_ret(Err::FileOpenError, recoveredFilePath);
+    }
+    recoveredFile.close();
+
+    Ret ret = load(recoveredFilePath);
+    QFile::remove(recoveredFilePath);
+    if (!ret) {
+        return ret;
+    }
+
+    Ms::MasterScore* score = masterScore();
+    if (scorePath.isEmpty()) {
+        score->setCreated(true);
+        score->setName(qtrc("notation", "Untitled"));
+    } else {
+        score->fileInfo()->setFile(scorePath);
+        score->setName(QFileInfo(scorePath).completeBaseName());
+    }
+    score->setSaved(false);
+
+    //! NOTE The journal is kept until the recovered score is saved or closed
+    if (m_autosaveJournal) {
+        m_autosaveJournal->remove();
+    }
+    m_recoveredJournalPath = journalPath.toQString();
+    initAutosave();
+
+    return make_ret(Err::NoError);
+}
+
 mu::Ret MasterNotation::writeToDevice(io::Device& destinationDevice)
 {
     bool ok = score()->writeMscz(&destinationDevice, score()->title() + ".mscx");
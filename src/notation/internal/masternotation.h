@@ -24,16 +24,21 @@
 
 #include <memory>
 
+#include <QElapsedTimer>
+#include <QTimer>
+
 #include "../imasternotation.h"
 #include "../inotationreadersregister.h"
 #include "../inotationwritersregister.h"
 
 #include "modularity/ioc.h"
+#include "global/iapplication.h"
 #include "notation.h"
 #include "retval.h"
 
 namespace Ms {
 class MasterScore;
+class AutosaveJournal;
 }
 
 namespace mu::notation {
@@ -41,6 +46,7 @@ class MasterNotation : public IMasterNotation, public Notation, public std::enab
 {
     INJECT(notation, INotationReadersRegister, readers)
     INJECT(notation, INotationWritersRegister, writers)
+    INJECT(notation, framework::IApplication, application)
 
 public:
     explicit MasterNotation();
@@ -52,6 +58,7 @@ public:
     void setMetaInfo(const Meta& meta) override;
 
     Ret load(const io::path& path, const io::path& stylePath = io::path(), bool forceMode = false) override;
+    Ret loadAutosave(const io::path& journalPath) override;
     io::path path() const override;
 
     Ret createNew(const ScoreCreateOptions& scoreOptions) override;
@@ -74,12 +81,13 @@ private:
     Ms::MasterScore* masterScore() const;
 
     Ret load(const io::path& path, const io::path& stylePath, const INotationReaderPtr& reader, bool forceMode = false);
-    Ret doLoadScore(Ms::MasterScore* score, const io::path& path, const INotationReaderPtr& reader, bool forceMode = false) const;
+    Ret doLoadScore(Ms::MasterScore* score, const io::path& path, const INotationReaderPtr& reader, bool forceMode = false,
+                    int layoutPages = -1) const;
     mu::RetVal<Ms::MasterScore*> newScore(const ScoreCreateOptions& scoreInfo);
 
     void doSetExcerpts(ExcerptNotationList excerpts);
 
-    void initExcerpts(const QList<Ms::Excerpt*>& scoreExcerpts = QList<Ms::Excerpt*>());
+    void initExcerpts(const QList<Ms::Excerpt*>& scoreExcerpts = QList<Ms::Excerpt*>(), int layoutPages = -1);
 
     void createNonexistentExcerpts(const ExcerptNotationList& newExcerpts);
 
@@ -89,7 +97,17 @@ private:
     Ret saveScore(const io::path& path = io::path(), SaveMode saveMode = SaveMode::Save);
     Ret saveSelectionOnScore(const io::path& path = io::path());
 
+    void initAutosave();
+    void updateAutosaveSettings();
+    void autosave();
+    void removeAutosave();
+
     ValCh<ExcerptNotationList> m_excerpts;
+
+    std::unique_ptr<QTimer> m_autosaveTimer;
+    std::unique_ptr<Ms::AutosaveJournal> m_autosaveJournal;
+    QElapsedTimer m_lastEditTime;
+    QString m_recoveredJournalPath;
 };
 }
 
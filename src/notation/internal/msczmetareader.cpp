@@ -24,6 +24,9 @@
 #include <sstream>
 
 #include <QBuffer>
+#include <QDataStream>
+#include <QFileInfo>
+#include <QtConcurrent>
 
 #include "stringutils.h"
 #include "notationerrors.h"
@@ -39,25 +42,242 @@ using namespace mu::framework;
 using namespace mu::system;
 using namespace mu::engraving;
 
+static const QString META_CACHE_FILE_NAME("scoremeta.cache");
+static const quint32 META_CACHE_VERSION = 2;
+static const int META_CACHE_MAX_UNUSED_DAYS = 30;
+
 MetaList MsczMetaReader::readMetaList(const io::paths& filePaths) const
 {
-    MetaList result;
+    loadCache();
 
-    for (const io::path& path: filePaths) {
-        RetVal<Meta> meta = readMeta(path);
+    QList<RetVal<MetaEntry> > entries = QtConcurrent::blockingMapped<QList<RetVal<MetaEntry> > >(
+        filePaths, [this](const io::path& path) {
+        return th_readEntry(path);
+    });
 
-        if (!meta.ret) {
-            LOGE() << meta.ret.toString();
+    MetaList result;
+
+    for (const RetVal<MetaEntry>& entry : entries) {
+        if (!entry.ret) {
+            LOGE() << entry.ret.toString();
             continue;
         }
 
-        result.push_back(meta.val);
+        result.push_back(toMeta(entry.val));
     }
 
+    saveCache();
+
     return result;
 }
 
-mu::RetVal<Meta> MsczMetaReader::readMeta(const io::path& filePath) const
+mu::async::Channel<Meta> MsczMetaReader::readMetaListAsync(const io::paths& filePaths) const
+{
+    loadCache();
+
+    async::Channel<Meta> result;
+    async::Channel<MetaEntry> entryRead;
+
+    auto self = const_cast<MsczMetaReader*>(this);
+    entryRead.onReceive(self, [this, result](const MetaEntry& entry) mutable {
+        result.send(toMeta(entry));
+    }, Asyncable::AsyncMode::AsyncSetRepeat);
+
+    entryRead.onClose(self, [this, result]() mutable {
+        saveCache();
+        result.close();
+    });
+
+    QtConcurrent::run([this, filePaths, entryRead]() mutable {
+        std::mutex sendMutex;
+        QtConcurrent::blockingMap(filePaths, [this, &entryRead, &sendMutex](const io::path& path) {
+            RetVal<MetaEntry> entry = th_readEntry(path);
+            if (!entry.ret) {
+                LOGE() << entry.ret.toString();
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(sendMutex);
+            entryRead.send(entry.val);
+        });
+
+        entryRead.close();
+    });
+
+    return result;
+}
+
+mu::RetVal<MsczMetaReader::MetaEntry> MsczMetaReader::th_readEntry(const io::path& filePath) const
+{
+    RetVal<MetaEntry> entry;
+
+    QFileInfo fileInfo(filePath.toQString());
+    const QString key = fileInfo.absoluteFilePath();
+    if (!fileInfo.exists()) {
+        LOGE() << "File not exists: " << filePath;
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        if (m_cache.remove(key) > 0) {
+            m_cacheChanged = true;
+        }
+        entry.ret = make_ret(Err::FileNotFound);
+        return entry;
+    }
+
+    const QDate today = QDate::currentDate();
+    {
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        auto it = m_cache.find(key);
+        if (it != m_cache.end() && it->lastModified == fileInfo.lastModified() && it->fileSize == fileInfo.size()) {
+            if (it->lastUsed != today) {
+                it->lastUsed = today;
+                m_cacheChanged = true;
+            }
+            entry.ret = make_ret(Err::NoError);
+            entry.val = it.value();
+            entry.val.meta.filePath = filePath;
+            return entry;
+        }
+    }
+
+    RetVal<Meta> meta = readMeta(filePath, entry.val.thumbnailData);
+    entry.ret = meta.ret;
+    if (!meta.ret) {
+        return entry;
+    }
+
+    entry.val.meta = meta.val;
+    entry.val.lastModified = fileInfo.lastModified();
+    entry.val.fileSize = fileInfo.size();
+    entry.val.lastUsed = today;
+
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    m_cache.insert(key, entry.val);
+    m_cacheChanged = true;
+
+    return entry;
+}
+
+Meta MsczMetaReader::toMeta(const MetaEntry& entry) const
+{
+    Meta meta = entry.meta;
+
+    if (entry.thumbnailData.isEmpty()) {
+        LOGD() << "Can't find thumbnail";
+    } else {
+        meta.thumbnail.loadFromData(entry.thumbnailData, "PNG");
+    }
+
+    return meta;
+}
+
+mu::io::path MsczMetaReader::cacheFilePath() const
+{
+    return globalConfiguration()->userAppDataPath() + "/" + META_CACHE_FILE_NAME;
+}
+
+static QDataStream& operator<<(QDataStream& out, const Meta& meta)
+{
+    out << meta.fileName.toQString() << meta.filePath.toQString()
+        << meta.title << meta.subtitle << meta.composer << meta.lyricist
+        << meta.copyright << meta.translator << meta.arranger
+        << quint64(meta.partsCount) << meta.creationDate
+        << meta.source << meta.platform << meta.musescoreVersion
+        << qint32(meta.musescoreRevision) << qint32(meta.mscVersion)
+        << meta.additionalTags;
+    return out;
+}
+
+static QDataStream& operator>>(QDataStream& in, Meta& meta)
+{
+    QString fileName;
+    QString filePath;
+    quint64 partsCount = 0;
+    qint32 musescoreRevision = 0;
+    qint32 mscVersion = 0;
+
+    in >> fileName >> filePath
+    >> meta.title >> meta.subtitle >> meta.composer >> meta.lyricist
+    >> meta.copyright >> meta.translator >> meta.arranger
+    >> partsCount >> meta.creationDate
+    >> meta.source >> meta.platform >> meta.musescoreVersion
+    >> musescoreRevision >> mscVersion
+    >> meta.additionalTags;
+
+    meta.fileName = fileName;
+    meta.filePath = filePath;
+    meta.partsCount = partsCount;
+    meta.musescoreRevision = musescoreRevision;
+    meta.mscVersion = mscVersion;
+    return in;
+}
+
+void MsczMetaReader::loadCache() const
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    if (m_cacheLoaded) {
+        return;
+    }
+    m_cacheLoaded = true;
+
+    RetVal<QByteArray> data = fileSystem()->readFile(cacheFilePath());
+    if (!data.ret) {
+        return;
+    }
+
+    QDataStream in(data.val);
+    in.setVersion(QDataStream::Qt_5_9);
+
+    quint32 version = 0;
+    quint32 count = 0;
+    in >> version >> count;
+    if (version != META_CACHE_VERSION) {
+        return;
+    }
+
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString key;
+        MetaEntry entry;
+        in >> key >> entry.meta >> entry.thumbnailData >> entry.lastModified >> entry.fileSize >> entry.lastUsed;
+        m_cache.insert(key, entry);
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        LOGW() << "damaged score meta cache, ignored";
+        m_cache.clear();
+    }
+}
+
+void MsczMetaReader::saveCache() const
+{
+    QByteArray data;
+    {
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        if (!m_cacheChanged) {
+            return;
+        }
+        m_cacheChanged = false;
+
+        const QDate today = QDate::currentDate();
+        for (auto it = m_cache.begin(); it != m_cache.end();) {
+            bool isUnused = !it->lastUsed.isValid() || it->lastUsed.daysTo(today) > META_CACHE_MAX_UNUSED_DAYS;
+            it = (isUnused || !QFileInfo::exists(it.key())) ? m_cache.erase(it) : std::next(it);
+        }
+
+        QDataStream out(&data, QIODevice::WriteOnly);
+        out.setVersion(QDataStream::Qt_5_9);
+        out << META_CACHE_VERSION << quint32(m_cache.size());
+        for (auto it = m_cache.constBegin(); it != m_cache.constEnd(); ++it) {
+            out << it.key() << it->meta << it->thumbnailData << it->lastModified << it->fileSize << it->lastUsed;
+        }
+    }
+
+    Ret ret = fileSystem()->writeToFile(cacheFilePath(), data);
+    if (!ret) {
+        LOGE() << ret.toString();
+    }
+}
+
+mu::RetVal<Meta> MsczMetaReader::readMeta(const io::path& filePath, QByteArray& thumbnailData) const
 {
     RetVal<Meta> meta;
 
@@ -70,7 +290,7 @@ mu::RetVal<Meta> MsczMetaReader::readMeta(const io::path& filePath) const
     bool compressed = io::syffix(filePath) == "mscz";
 
     if (compressed) {
-        meta = readMetaFromMscx(filePath);
+        meta = readMetaFromMscx(filePath, thumbnailData);
     } else {
         framework::XmlReader reader(filePath);
         meta = doReadMeta(reader);
@@ -85,7 +305,7 @@ mu::RetVal<Meta> MsczMetaReader::readMeta(const io::path& filePath) const
     return meta;
 }
 
-mu::RetVal<Meta> MsczMetaReader::readMetaFromMscx(const io::path& filePath) const
+mu::RetVal<Meta> MsczMetaReader::readMetaFromMscx(const io::path& filePath, QByteArray& thumbnailData) const
 {
     RetVal<Meta> meta;
 
@@ -106,12 +326,7 @@ mu::RetVal<Meta> MsczMetaReader::readMetaFromMscx(const io::path& filePath) cons
     meta = doReadMeta(xmlReader);
 
     // Read thumbnail
-    QByteArray thumbnailData = msczReader.readThumbnail();
-    if (thumbnailData.isEmpty()) {
-        LOGD() << "Can't find thumbnail";
-    } else {
-        meta.val.thumbnail.loadFromData(thumbnailData, "PNG");
-    }
+    thumbnailData = msczReader.readThumbnail();
 
     return meta;
 }
@@ -22,10 +22,17 @@
 #ifndef MU_NOTATION_MSCZMETAREADER_H
 #define MU_NOTATION_MSCZMETAREADER_H
 
+#include <mutex>
+
+#include <QDateTime>
+#include <QHash>
+
 #include "imsczmetareader.h"
 
 #include "system/ifilesystem.h"
+#include "iglobalconfiguration.h"
 #include "modularity/ioc.h"
+#include "async/asyncable.h"
 
 namespace mu::framework {
 class XmlReader;
@@ -34,15 +41,34 @@ class XmlReader;
 class MQZipReader;
 
 namespace mu::notation {
-class MsczMetaReader : public IMsczMetaReader
+class MsczMetaReader : public IMsczMetaReader, public async::Asyncable
 {
     INJECT(notation, system::IFileSystem, fileSystem)
+    INJECT(notation, framework::IGlobalConfiguration, globalConfiguration)
 
 public:
     MetaList readMetaList(const io::paths& filePaths) const override;
+    async::Channel<Meta> readMetaListAsync(const io::paths& filePaths) const override;
 
 private:
-    RetVal<Meta> readMeta(const io::path& filePath) const;
+    //! NOTE Meta as it can be read on a worker thread: the thumbnail stays PNG data,
+    //! it is turned into a pixmap on the main thread, see toMeta()
+    struct MetaEntry {
+        Meta meta;
+        QByteArray thumbnailData;
+        QDateTime lastModified;
+        qint64 fileSize = 0;
+        QDate lastUsed;
+    };
+
+    RetVal<MetaEntry> th_readEntry(const io::path& filePath) const;
+    Meta toMeta(const MetaEntry& entry) const;
+
+    io::path cacheFilePath() const;
+    void loadCache() const;
+    void saveCache() const;
+
+    RetVal<Meta> readMeta(const io::path& filePath, QByteArray& thumbnailData) const;
 
     struct RawMeta {
         QString titleTag;
@@ -72,7 +98,7 @@ private:
 
     RetVal<Meta> doReadMeta(framework::XmlReader& xmlReader) const;
     RawMeta doReadBox(framework::XmlReader& xmlReader) const;
-    RetVal<Meta> readMetaFromMscx(const io::path& filePath) const;
+    RetVal<Meta> readMetaFromMscx(const io::path& filePath, QByteArray& thumbnailData) const;
     RawMeta doReadRawMeta(framework::XmlReader& xmlReader) const;
     QString formatFromXml(const std::string& xml) const;
 
@@ -83,6 +109,13 @@ private:
 
     QString readText(framework::XmlReader& xmlReader) const;
     QString readMetaTagText(framework::XmlReader& xmlReader) const;
+
+    //! NOTE Persistent, keyed by path and checked against modification time and size.
+    //! The entries of removed files and the ones not used for a while are dropped on save
+    mutable std::mutex m_cacheMutex;
+    mutable QHash<QString, MetaEntry> m_cache;
+    mutable bool m_cacheLoaded = false;
+    mutable bool m_cacheChanged = false;
 };
 }
 
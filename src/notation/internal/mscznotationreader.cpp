@@ -28,12 +28,27 @@
 #include "libmscore/score.h"
 #include "notation/notationerrors.h"
 #include "engraving/compat/mscxcompat.h"
+#include "engraving/compat/scorecache.h"
 
 using namespace mu::notation;
 using namespace mu::engraving;
 
 mu::Ret MsczNotationReader::read(Ms::MasterScore* score, const io::path& path, const Options& options)
 {
-    Ms::Score::FileError err = compat::loadMsczOrMscx(score, path.toQString(), options.contains(OptionKey::ForceMode));
+    bool forceMode = options.contains(OptionKey::ForceMode);
+
+    Ms::Score::FileError err = Ms::Score::FileError::FILE_NO_ERROR;
+    if (configuration() && configuration()->isScoreCacheEnabled()) {
+        compat::ScoreCache cache(configuration()->scoreCachePath().toQString());
+        bool cacheEntryFailed = false;
+        err = compat::loadMsczOrMscx(score, path.toQString(), forceMode, &cache, &cacheEntryFailed);
+        if (cacheEntryFailed) {
+            //! NOTE The entry is removed, the file itself is read on the next attempt
+            return make_ret(Err::FileCacheEntryFailed, path);
+        }
+    } else {
+        err = compat::loadMsczOrMscx(score, path.toQString(), forceMode);
+    }
+
     return mu::notation::scoreFileErrorToRet(err, path);
 }
@@ -23,10 +23,14 @@
 #define MU_NOTATION_MSCZNOTATIONREADER_H
 
 #include "../inotationreader.h"
+#include "modularity/ioc.h"
+#include "../inotationconfiguration.h"
 
 namespace mu::notation {
 class MsczNotationReader : public INotationReader
 {
+    INJECT(notation, INotationConfiguration, configuration)
+
 public:
     Ret read(Ms::MasterScore* score, const io::path& path, const Options& options = Options()) override;
 };
@@ -25,10 +25,14 @@
 #include <QScreen>
 
 #include "log.h"
+#include "async/async.h"
 
 #include "libmscore/score.h"
 #include "libmscore/scorefont.h"
 #include "libmscore/page.h"
+#include "libmscore/system.h"
+#include "libmscore/measurebase.h"
+#include "libmscore/undo.h"
 #include "libmscore/rendermidi.h"
 #include "engraving/accessibility/accessibleelement.h"
 
@@ -44,6 +48,9 @@
 #include "notationtypes.h"
 #include "scoreorderconverter.h"
 #include "draw/pen.h"
+#include "draw/painter.h"
+#include "draw/bufferedpaintprovider.h"
+#include "draw/utils/drawdatapaint.h"
 
 using namespace mu::notation;
 
@@ -128,10 +135,20 @@ Notation::Notation(Ms::Score* score)
     });
 
     configuration()->selectionColorChanged().onReceive(this, [this](int) {
+        m_pageDisplayLists.clear();
+        m_droppedDisplayLists.clear();
         notifyAboutNotationChanged();
     });
 
+    configuration()->foregroundChanged().onNotify(this, [this]() {
+        m_foregroundWallpaperPath.clear();
+        m_foregroundWallpaper = QPixmap();
+    });
+
     configuration()->canvasOrientation().ch.onReceive(this, [this](framework::Orientation) {
+        if (!m_score) {
+            return;
+        }
         m_score->doLayout();
         for (Ms::Score* score : m_score->scoreList()) {
             score->doLayout();
@@ -181,8 +198,17 @@ void Notation::init()
 void Notation::setScore(Ms::Score* score)
 {
     m_score = score;
+    m_pageDisplayLists.clear();
+    m_droppedDisplayLists.clear();
+    m_paintedSelection.clear();
 
     if (score) {
+        //! NOTE The parts share the undo stack of the master score
+        if (score->isMaster()) {
+            const int budgetMb = std::max(0, configuration()->undoHistoryMemoryBudgetMegabytes());
+            score->undoStack()->setMemoryBudget(static_cast<size_t>(budgetMb) * 1024 * 1024);
+        }
+
         static_cast<NotationInteraction*>(m_interaction.get())->init();
         static_cast<NotationPlayback*>(m_playback.get())->init(m_parts);
     }
@@ -246,10 +272,10 @@ void Notation::setMetaInfo(const Meta& meta)
 
 mu::instruments::ScoreOrder Notation::scoreOrder() const
 {
-    if (!m_score) {
+    if (!score()) {
         return mu::instruments::ScoreOrder();
     }
-    return ScoreOrderConverter::convertScoreOrder(m_score->scoreOrder());
+    return ScoreOrderConverter::convertScoreOrder(score()->scoreOrder());
 }
 
 INotationPtr Notation::clone() const
@@ -264,7 +290,7 @@ void Notation::setViewSize(const QSizeF& vs)
 
 void Notation::setViewMode(const ViewMode& viewMode)
 {
-    if (!m_score) {
+    if (!score()) {
         return;
     }
 
@@ -275,7 +301,7 @@ void Notation::setViewMode(const ViewMode& viewMode)
 
 ViewMode Notation::viewMode() const
 {
-    if (!m_score) {
+    if (!score()) {
         return ViewMode::PAGE;
     }
 
@@ -283,6 +309,11 @@ ViewMode Notation::viewMode() const
 }
 
 void Notation::paint(mu::draw::Painter* painter, const RectF& frameRect)
+{
+    paint(painter, frameRect, nullptr);
+}
+
+void Notation::paint(mu::draw::Painter* painter, const RectF& frameRect, const PageContentPainter& contentPainter)
 {
     const QList<Ms::Page*>& pages = score()->pages();
     if (pages.empty()) {
@@ -293,21 +324,28 @@ void Notation::paint(mu::draw::Painter* painter, const RectF& frameRect)
     case Ms::LayoutMode::LINE:
     case Ms::LayoutMode::SYSTEM: {
         bool paintBorders = false;
-        paintPages(painter, frameRect, { pages.first() }, paintBorders);
+        paintPages(painter, frameRect, { pages.first() }, paintBorders, contentPainter);
         break;
     }
     case Ms::LayoutMode::FLOAT:
     case Ms::LayoutMode::PAGE: {
         bool paintBorders = !score()->printing();
-        paintPages(painter, frameRect, pages, paintBorders);
+        paintPages(painter, frameRect, pages, paintBorders, contentPainter);
     }
     }
 
     static_cast<NotationInteraction*>(m_interaction.get())->paint(painter);
 }
 
-void Notation::paintPages(draw::Painter* painter, const RectF& frameRect, const QList<Ms::Page*>& pages, bool paintBorders) const
+void Notation::paintPages(draw::Painter* painter, const RectF& frameRect, const QList<Ms::Page*>& pages, bool paintBorders,
+                          const PageContentPainter& contentPainter)
 {
+    //! NOTE Printing and export paint directly, as do the painters watched by a test provider
+    const bool useDisplayLists = !score()->printing() && !draw::Painter::extended;
+    if (useDisplayLists) {
+        updatePageDisplayLists(pages);
+    }
+
     for (Ms::Page* page : pages) {
         RectF pageRect(page->abbox().translated(page->pos()));
 
@@ -327,13 +365,224 @@ void Notation::paintPages(draw::Painter* painter, const RectF& frameRect, const
         painter->translate(pagePosition);
         paintForeground(painter, page->bbox());
 
-        QList<Element*> elements = page->items(frameRect.translated(-page->pos()));
-        Ms::paintElements(*painter, elements);
+        RectF pageFrameRect = frameRect.translated(-page->pos());
+        if (useDisplayLists) {
+            const PageDisplayList& list = pageDisplayList(page);
+            if (contentPainter) {
+                contentPainter(painter, page, list.drawing, pageFrameRect);
+            } else {
+                paintPageDisplayList(painter, *list.drawing, pageFrameRect);
+            }
+        } else {
+            QList<Element*> elements = page->items(pageFrameRect);
+            page->sortInPaintOrder(elements);
+            Ms::paintSortedElements(*painter, elements);
+        }
 
         painter->translate(-pagePosition);
     }
 }
 
+static void pageTickRange(const Ms::Page* page, Ms::Fraction& startTick, Ms::Fraction& endTick)
+{
+    startTick = Ms::Fraction(-1, 1);
+    endTick = Ms::Fraction(-1, 1);
+
+    for (const Ms::System* system : page->systems()) {
+        if (system->measures().empty()) {
+            continue;
+        }
+        if (startTick < Ms::Fraction(0, 1)) {
+            startTick = system->measures().front()->tick();
+        }
+        endTick = system->measures().back()->endTick();
+    }
+}
+
+static std::vector<std::pair<const Ms::System*, mu::PointF> > pageSystems(const Ms::Page* page)
+{
+    std::vector<std::pair<const Ms::System*, mu::PointF> > systems;
+    for (const Ms::System* system : page->systems()) {
+        systems.push_back({ system, system->pos() });
+    }
+    return systems;
+}
+
+void Notation::updatePageDisplayLists(const QList<Ms::Page*>& pages)
+{
+    Ms::PaintDamage damage = score()->takePaintDamage();
+    if (damage.all) {
+        m_pageDisplayLists.clear();
+        m_droppedDisplayLists.clear();
+    }
+
+    if (!damage.empty()) {
+        for (int i = 0; i < pages.size(); ++i) {
+            RectF pageDamage = damage.pageDamage(pages, i);
+            if (!pageDamage.isNull()) {
+                dropPageDisplayList(pages.at(i), pageDamage);
+            }
+        }
+    }
+
+    //! NOTE Deleted pages and systems may be reallocated at the same address,
+    //! so the display lists of an older layout generation are never reused
+    const int generation = score()->layoutGeneration();
+    for (auto it = m_droppedDisplayLists.begin(); it != m_droppedDisplayLists.end();) {
+        if (it->first.second == generation) {
+            ++it;
+        } else {
+            it = m_droppedDisplayLists.erase(it);
+        }
+    }
+
+    for (auto it = m_pageDisplayLists.begin(); it != m_pageDisplayLists.end();) {
+        const int pageNo = it->first.first;
+        const Ms::Page* page = pageNo < pages.size() ? pages.at(pageNo) : nullptr;
+        bool valid = page && it->first.second == generation && it->second.systems == pageSystems(page);
+        if (valid) {
+            Ms::Fraction startTick, endTick;
+            pageTickRange(page, startTick, endTick);
+            valid = startTick == it->second.startTick && endTick == it->second.endTick;
+        }
+
+        if (valid) {
+            ++it;
+        } else {
+            m_droppedDisplayLists.erase(it->first);
+            it = m_pageDisplayLists.erase(it);
+        }
+    }
+
+    //! NOTE Selected elements are painted differently, and so are the edited ones
+    const QList<Ms::Element*>& selection = score()->selection().elements();
+    if (selection != m_paintedSelection || m_interaction->isDragStarted() || m_interaction->isTextEditingStarted()
+        || m_interaction->isGripEditStarted()) {
+        invalidateSelectedPages();
+        m_paintedSelection = selection;
+    }
+}
+
+Notation::PageKey Notation::pageKey(const Ms::Page* page) const
+{
+    return { page->no(), score()->layoutGeneration() };
+}
+
+void Notation::invalidateSelectedPages()
+{
+    std::vector<std::pair<PageKey, RectF> > selectedPages;
+    for (const auto& pair : m_pageDisplayLists) {
+        if (pair.second.hasSelection) {
+            selectedPages.push_back({ pair.first, pair.second.selectionRect });
+        }
+    }
+
+    for (const auto& pair : selectedPages) {
+        dropPageDisplayList(pair.first, pair.second);
+    }
+
+    for (const Ms::Element* element : score()->selection().elements()) {
+        const Ms::Element* page = element->findAncestor(Ms::ElementType::PAGE);
+        if (page) {
+            dropPageDisplayList(Ms::toPage(page), element->pageBoundingRect());
+        }
+    }
+}
+
+void Notation::dropPageDisplayList(const Ms::Page* page, const RectF& damage)
+{
+    dropPageDisplayList(pageKey(page), damage);
+}
+
+void Notation::dropPageDisplayList(const PageKey& key, const RectF& damage)
+{
+    auto it = m_pageDisplayLists.find(key);
+    if (it != m_pageDisplayLists.end()) {
+        DroppedDisplayList& dropped = m_droppedDisplayLists[key];
+        dropped.revision = it->second.drawing->revision;
+        dropped.damage = damage;
+        m_pageDisplayLists.erase(it);
+        return;
+    }
+
+    auto dropped = m_droppedDisplayLists.find(key);
+    if (dropped != m_droppedDisplayLists.end()) {
+        dropped->second.damage = dropped->second.damage.united(damage);
+    }
+}
+
+const Notation::PageDisplayList& Notation::pageDisplayList(const Ms::Page* page)
+{
+    const PageKey key = pageKey(page);
+    auto it = m_pageDisplayLists.find(key);
+    if (it != m_pageDisplayLists.end()) {
+        return it->second;
+    }
+
+    PageDisplayList& list = m_pageDisplayLists[key];
+    list.systems = pageSystems(page);
+    pageTickRange(page, list.startTick, list.endTick);
+
+    auto drawing = std::make_shared<PageDrawing>();
+    drawing->pageRect = page->bbox();
+    drawing->revision = ++m_displayListRevision;
+
+    auto dropped = m_droppedDisplayLists.find(key);
+    if (dropped != m_droppedDisplayLists.end()) {
+        drawing->previousRevision = dropped->second.revision;
+        drawing->damage = dropped->second.damage;
+        m_droppedDisplayLists.erase(dropped);
+    }
+
+    const QList<Element*>& elements = page->paintOrder();
+
+    auto provider = std::make_shared<draw::BufferedPaintProvider>();
+    {
+        draw::Painter painter(provider, "notationpage");
+        for (const Element* element : elements) {
+            if (!element->isInteractionAvailable()) {
+                continue;
+            }
+
+            painter.beginObject(element->name(), element->pagePos());
+            Ms::paintElement(painter, element);
+            painter.endObject();
+
+            drawing->itemRects.push_back(element->pageBoundingRect());
+            if (element->selected()) {
+                list.hasSelection = true;
+                list.selectionRect = list.selectionRect.united(element->pageBoundingRect());
+            }
+        }
+    }
+
+    drawing->data = provider->drawData();
+    for (const draw::DrawData::Object& obj : drawing->data.objects) {
+        for (const draw::DrawData::Data& d : obj.datas) {
+            drawing->hasPixmaps = drawing->hasPixmaps || !d.pixmaps.empty() || !d.tiledPixmap.empty();
+        }
+    }
+
+    list.drawing = drawing;
+
+    return list;
+}
+
+void Notation::paintPageDisplayList(draw::Painter* painter, const PageDrawing& drawing, const RectF& pageFrameRect) const
+{
+    //! NOTE The objects are recorded in paint order, the last one is the default object of the target
+    const size_t count = std::min(drawing.itemRects.size(), drawing.data.objects.size());
+    for (size_t i = 0; i < count; ++i) {
+        const RectF& r = drawing.itemRects[i];
+        if (r.right() < pageFrameRect.left() || r.left() > pageFrameRect.right()
+            || r.bottom() < pageFrameRect.top() || r.top() > pageFrameRect.bottom()) {
+            continue;
+        }
+
+        draw::DrawDataPaint::paint(painter, drawing.data.objects[i]);
+    }
+}
+
 void Notation::paintPageBorder(draw::Painter* painter, const Ms::Page* page) const
 {
     using namespace mu::draw;
@@ -357,7 +606,7 @@ void Notation::paintPageBorder(draw::Painter* painter, const Ms::Page* page) con
     }
 }
 
-void Notation::paintForeground(mu::draw::Painter* painter, const RectF& pageRect) const
+void Notation::paintForeground(mu::draw::Painter* painter, const RectF& pageRect)
 {
     if (score()->printing()) {
         painter->fillRect(pageRect, Qt::white);
@@ -369,8 +618,11 @@ void Notation::paintForeground(mu::draw::Painter* painter, const RectF& pageRect
     if (configuration()->foregroundUseColor() || wallpaperPath.isEmpty()) {
         painter->fillRect(pageRect, configuration()->foregroundColor());
     } else {
-        QPixmap pixmap(wallpaperPath);
-        painter->drawTiledPixmap(pageRect, pixmap);
+        if (wallpaperPath != m_foregroundWallpaperPath) {
+            m_foregroundWallpaper = QPixmap(wallpaperPath);
+            m_foregroundWallpaperPath = wallpaperPath;
+        }
+        painter->drawTiledPixmap(pageRect, m_foregroundWallpaper);
     }
 }
 
@@ -388,11 +640,52 @@ void Notation::setOpened(bool opened)
     m_opened.set(opened);
 }
 
+mu::ValCh<bool> Notation::layoutInProgress() const
+{
+    return m_layoutInProgress;
+}
+
+void Notation::finishLayout()
+{
+    if (m_score && m_score->layoutPending()) {
+        m_score->doLayoutPages(-1);
+        notifyAboutNotationChanged();
+    }
+    continueLayout();
+}
+
 void Notation::notifyAboutNotationChanged()
 {
     m_notationChanged.notify();
 }
 
+void Notation::continueLayout()
+{
+    //! NOTE Layout is not thread safe, so the remaining pages are laid out
+    //! in small steps on the main thread to keep the UI responsive
+    static constexpr int LAYOUT_PAGES_PER_STEP = 4;
+
+    if (!m_score || !m_score->layoutPending()) {
+        if (m_layoutInProgress.val) {
+            LOGI() << "layout completed in " << m_layoutTimer.elapsed() << " ms";
+            m_layoutInProgress.set(false);
+        }
+        return;
+    }
+
+    if (!m_layoutInProgress.val) {
+        m_layoutInProgress.set(true);
+    }
+
+    async::Async::call(this, [this]() {
+        if (m_score && m_score->layoutPending()) {
+            m_score->doLayoutPages(LAYOUT_PAGES_PER_STEP);
+            notifyAboutNotationChanged();
+        }
+        continueLayout();
+    });
+}
+
 INotationInteractionPtr Notation::interaction() const
 {
     return m_interaction;
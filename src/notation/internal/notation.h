@@ -22,6 +22,12 @@
 #ifndef MU_NOTATION_NOTATION_H
 #define MU_NOTATION_NOTATION_H
 
+#include <map>
+#include <vector>
+
+#include <QElapsedTimer>
+#include <QPixmap>
+
 #include "inotation.h"
 #include "igetscore.h"
 #include "inotationmidievents.h"
@@ -30,9 +36,15 @@
 #include "modularity/ioc.h"
 #include "inotationconfiguration.h"
 
+#include "draw/buffereddrawtypes.h"
+#include "libmscore/fraction.h"
+
 namespace Ms {
 class MScore;
 class Score;
+class Page;
+class System;
+class Element;
 }
 
 namespace mu::notation {
@@ -59,10 +71,14 @@ public:
     void setViewMode(const ViewMode& viewMode) override;
     ViewMode viewMode() const override;
     void paint(draw::Painter* painter, const RectF& frameRect) override;
+    void paint(draw::Painter* painter, const RectF& frameRect, const PageContentPainter& contentPainter) override;
 
     ValCh<bool> opened() const override;
     void setOpened(bool opened) override;
 
+    ValCh<bool> layoutInProgress() const override;
+    void finishLayout() override;
+
     INotationInteractionPtr interaction() const override;
     INotationMidiInputPtr midiInput() const override;
     INotationUndoStackPtr undoStack() const override;
@@ -79,15 +95,45 @@ protected:
     void setScore(Ms::Score* score);
     Ms::MScore* scoreGlobal() const;
     void notifyAboutNotationChanged();
+    void continueLayout();
 
     INotationPartsPtr m_parts = nullptr;
+    QElapsedTimer m_layoutTimer;
 
 private:
     friend class NotationInteraction;
 
-    void paintPages(mu::draw::Painter* painter, const RectF& frameRect, const QList<Ms::Page*>& pages, bool paintBorders) const;
+    //! NOTE The painting of a page is recorded once and replayed at any transform
+    //! until the page is touched by a layout, a refresh or a selection change
+    struct PageDisplayList {
+        std::vector<std::pair<const Ms::System*, PointF> > systems;
+        Ms::Fraction startTick;
+        Ms::Fraction endTick;
+        bool hasSelection = false;
+        RectF selectionRect;
+        std::shared_ptr<PageDrawing> drawing;
+    };
+
+    //! NOTE Display lists are kept per page number and layout generation
+    using PageKey = std::pair<int, int>;
+
+    //! NOTE What has to be repainted since a dropped display list was recorded
+    struct DroppedDisplayList {
+        int revision = 0;
+        RectF damage;
+    };
+
+    void paintPages(mu::draw::Painter* painter, const RectF& frameRect, const QList<Ms::Page*>& pages, bool paintBorders,
+                    const PageContentPainter& contentPainter);
+    void updatePageDisplayLists(const QList<Ms::Page*>& pages);
+    void invalidateSelectedPages();
+    PageKey pageKey(const Ms::Page* page) const;
+    void dropPageDisplayList(const Ms::Page* page, const RectF& damage);
+    void dropPageDisplayList(const PageKey& key, const RectF& damage);
+    const PageDisplayList& pageDisplayList(const Ms::Page* page);
+    void paintPageDisplayList(mu::draw::Painter* painter, const PageDrawing& drawing, const RectF& pageFrameRect) const;
     void paintPageBorder(mu::draw::Painter* painter, const Ms::Page* page) const;
-    void paintForeground(mu::draw::Painter* painter, const RectF& pageRect) const;
+    void paintForeground(mu::draw::Painter* painter, const RectF& pageRect);
 
     QSizeF viewSize() const;
 
@@ -95,6 +141,7 @@ private:
     Ms::MScore* m_scoreGlobal = nullptr;
     Ms::Score* m_score = nullptr;
     ValCh<bool> m_opened;
+    ValCh<bool> m_layoutInProgress;
 
     INotationInteractionPtr m_interaction = nullptr;
     INotationMidiEventsPtr m_midiEventsProvider = nullptr;
@@ -106,6 +153,14 @@ private:
     INotationElementsPtr m_elements = nullptr;
 
     async::Notification m_notationChanged;
+
+    std::map<PageKey, PageDisplayList> m_pageDisplayLists;
+    std::map<PageKey, DroppedDisplayList> m_droppedDisplayLists;
+    int m_displayListRevision = 0;
+    QList<Ms::Element*> m_paintedSelection;
+
+    QString m_foregroundWallpaperPath;
+    QPixmap m_foregroundWallpaper;
 };
 }
 
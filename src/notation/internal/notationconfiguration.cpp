@@ -64,6 +64,11 @@ static const Settings::Key USER_STYLES_PATH(module_name, "application/paths/mySt
 static const Settings::Key DEFAULT_STYLE_FILE_PATH(module_name, "score/style/defaultStyleFile");
 static const Settings::Key PART_STYLE_FILE_PATH(module_name, "score/style/partStyleFile");
 
+static const Settings::Key IS_SCORE_CACHE_ENABLED(module_name, "score/cacheConvertedScores");
+
+static const Settings::Key IS_AUTOSAVE_ENABLED(module_name, "application/autosave/enabled");
+static const Settings::Key AUTOSAVE_PERIOD(module_name, "application/autosave/period");
+
 static const Settings::Key IS_MIDI_INPUT_ENABLED(module_name, "io/midi/enableInput");
 static const Settings::Key IS_AUTOMATICALLY_PAN_ENABLED(module_name, "application/playback/panPlayback");
 static const Settings::Key IS_PLAY_REPEATS_ENABLED(module_name, "application/playback/playRepeats");
@@ -78,6 +83,8 @@ static const Settings::Key IS_LIMIT_CANVAS_SCROLL_AREA_KEY(module_name, "ui/canv
 static const Settings::Key COLOR_NOTES_OUTSIDE_OF_USABLE_PITCH_RANGE(module_name, "score/note/warnPitchRange");
 static const Settings::Key REALTIME_DELAY(module_name, "io/midi/realtimeDelay");
 static const Settings::Key NOTE_DEFAULT_PLAY_DURATION(module_name, "score/note/defaultPlayDuration");
+static const Settings::Key UNDO_HISTORY_MEMORY_BUDGET(module_name, "score/undo/memoryBudget");
+static const Settings::Key WARN_ABOUT_DROPPED_UNDO_HISTORY(module_name, "score/undo/warnHistoryDropped");
 
 static const Settings::Key VOICE1_COLOR_KEY(module_name, "ui/score/voice1/color");
 static const Settings::Key VOICE2_COLOR_KEY(module_name, "ui/score/voice2/color");
@@ -139,6 +146,18 @@ void NotationConfiguration::init()
     fileSystem()->makePath(userStylesPath());
 
     settings()->setDefaultValue(SELECTION_PROXIMITY, Val(6));
+    settings()->setDefaultValue(IS_SCORE_CACHE_ENABLED, Val(true));
+
+    settings()->setDefaultValue(IS_AUTOSAVE_ENABLED, Val(true));
+    settings()->valueChanged(IS_AUTOSAVE_ENABLED).onReceive(nullptr, [this](const Val&) {
+        m_autoSaveSettingsChanged.notify();
+    });
+
+    settings()->setDefaultValue(AUTOSAVE_PERIOD, Val(2));
+    settings()->valueChanged(AUTOSAVE_PERIOD).onReceive(nullptr, [this](const Val&) {
+        m_autoSaveSettingsChanged.notify();
+    });
+
     settings()->setDefaultValue(IS_MIDI_INPUT_ENABLED, Val(false));
     settings()->setDefaultValue(IS_AUTOMATICALLY_PAN_ENABLED, Val(true));
     settings()->setDefaultValue(IS_PLAY_REPEATS_ENABLED, Val(false));
@@ -155,6 +174,8 @@ void NotationConfiguration::init()
     settings()->setDefaultValue(COLOR_NOTES_OUTSIDE_OF_USABLE_PITCH_RANGE, Val(true));
     settings()->setDefaultValue(REALTIME_DELAY, Val(750));
     settings()->setDefaultValue(NOTE_DEFAULT_PLAY_DURATION, Val(300));
+    settings()->setDefaultValue(UNDO_HISTORY_MEMORY_BUDGET, Val(512));
+    settings()->setDefaultValue(WARN_ABOUT_DROPPED_UNDO_HISTORY, Val(true));
 
     std::vector<std::pair<Settings::Key, QColor> > voicesColors {
         { VOICE1_COLOR_KEY, QColor(0x0065BF) },
@@ -422,6 +443,51 @@ void NotationConfiguration::setPartStyleFilePath(const io::path& path)
     settings()->setSharedValue(PART_STYLE_FILE_PATH, Val(path.toStdString()));
 }
 
+bool NotationConfiguration::isScoreCacheEnabled() const
+{
+    return settings()->value(IS_SCORE_CACHE_ENABLED).toBool();
+}
+
+void NotationConfiguration::setIsScoreCacheEnabled(bool enabled)
+{
+    settings()->setSharedValue(IS_SCORE_CACHE_ENABLED, Val(enabled));
+}
+
+io::path NotationConfiguration::scoreCachePath() const
+{
+    return globalConfiguration()->userAppDataPath() + "/score_cache";
+}
+
+bool NotationConfiguration::isAutoSaveEnabled() const
+{
+    return settings()->value(IS_AUTOSAVE_ENABLED).toBool();
+}
+
+void NotationConfiguration::setIsAutoSaveEnabled(bool enabled)
+{
+    settings()->setSharedValue(IS_AUTOSAVE_ENABLED, Val(enabled));
+}
+
+int NotationConfiguration::autoSavePeriod() const
+{
+    return settings()->value(AUTOSAVE_PERIOD).toInt();
+}
+
+void NotationConfiguration::setAutoSavePeriod(int minutes)
+{
+    settings()->setSharedValue(AUTOSAVE_PERIOD, Val(minutes));
+}
+
+async::Notification NotationConfiguration::autoSaveSettingsChanged() const
+{
+    return m_autoSaveSettingsChanged;
+}
+
+io::path NotationConfiguration::autoSavePath() const
+{
+    return globalConfiguration()->userAppDataPath() + "/autosave";
+}
+
 bool NotationConfiguration::isMidiInputEnabled() const
 {
     return settings()->value(IS_MIDI_INPUT_ENABLED).toBool();
@@ -554,6 +620,26 @@ void NotationConfiguration::setNotePlayDurationMilliseconds(int durationMs)
     settings()->setSharedValue(NOTE_DEFAULT_PLAY_DURATION, Val(durationMs));
 }
 
+int NotationConfiguration::undoHistoryMemoryBudgetMegabytes() const
+{
+    return settings()->value(UNDO_HISTORY_MEMORY_BUDGET).toInt();
+}
+
+void NotationConfiguration::setUndoHistoryMemoryBudgetMegabytes(int budgetMb)
+{
+    settings()->setSharedValue(UNDO_HISTORY_MEMORY_BUDGET, Val(budgetMb));
+}
+
+bool NotationConfiguration::needShowWarningAboutDroppedUndoHistory() const
+{
+    return settings()->value(WARN_ABOUT_DROPPED_UNDO_HISTORY).toBool();
+}
+
+void NotationConfiguration::setNeedShowWarningAboutDroppedUndoHistory(bool value)
+{
+    settings()->setSharedValue(WARN_ABOUT_DROPPED_UNDO_HISTORY, Val(value));
+}
+
 void NotationConfiguration::setTemplateModeEnalbed(bool enabled)
 {
     Ms::MScore::saveTemplateMode = enabled;
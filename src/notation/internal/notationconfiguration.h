@@ -109,6 +109,17 @@ public:
     io::path partStyleFilePath() const override;
     void setPartStyleFilePath(const io::path& path) override;
 
+    bool isScoreCacheEnabled() const override;
+    void setIsScoreCacheEnabled(bool enabled) override;
+    io::path scoreCachePath() const override;
+
+    bool isAutoSaveEnabled() const override;
+    void setIsAutoSaveEnabled(bool enabled) override;
+    int autoSavePeriod() const override;
+    void setAutoSavePeriod(int minutes) override;
+    async::Notification autoSaveSettingsChanged() const override;
+    io::path autoSavePath() const override;
+
     bool isMidiInputEnabled() const override;
     void setIsMidiInputEnabled(bool enabled) override;
 
@@ -145,6 +156,11 @@ public:
     int notePlayDurationMilliseconds() const override;
     void setNotePlayDurationMilliseconds(int durationMs) override;
 
+    int undoHistoryMemoryBudgetMegabytes() const override;
+    void setUndoHistoryMemoryBudgetMegabytes(int budgetMb) override;
+    bool needShowWarningAboutDroppedUndoHistory() const override;
+    void setNeedShowWarningAboutDroppedUndoHistory(bool value) override;
+
     void setTemplateModeEnalbed(bool enabled) override;
     void setTestModeEnabled(bool enabled) override;
 
@@ -152,6 +168,7 @@ private:
 
     async::Notification m_backgroundChanged;
     async::Notification m_foregroundChanged;
+    async::Notification m_autoSaveSettingsChanged;
     async::Channel<int> m_currentZoomChanged;
     async::Channel<framework::Orientation> m_canvasOrientationChanged;
     async::Channel<io::path> m_userStylesPathChanged;
@@ -21,9 +21,13 @@
  */
 #include "notationcreator.h"
 
+#include <QDir>
+
 #include "masternotation.h"
 #include "excerptnotation.h"
 
+#include "libmscore/autosavejournal.h"
+
 using namespace mu::notation;
 
 IMasterNotationPtr NotationCreator::newMasterNotation() const
@@ -35,3 +39,18 @@ IExcerptNotationPtr NotationCreator::newExcerptNotation() const
 {
     return std::make_shared<ExcerptNotation>();
 }
+
+mu::io::paths NotationCreator::recoverableAutosaves() const
+{
+    QDir dir(configuration()->autoSavePath().toQString());
+    io::paths result;
+
+    for (const QFileInfo& fi : dir.entryInfoList({ "*.journal" }, QDir::Files, QDir::Time)) {
+        //! NOTE The journals of the scores opened in running instances are locked
+        if (!Ms::AutosaveJournal::isInUse(fi.absoluteFilePath())) {
+            result.push_back(fi.absoluteFilePath());
+        }
+    }
+
+    return result;
+}
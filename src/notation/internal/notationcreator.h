@@ -24,12 +24,19 @@
 
 #include "../inotationcreator.h"
 
+#include "modularity/ioc.h"
+#include "../inotationconfiguration.h"
+
 namespace mu::notation {
 class NotationCreator : public INotationCreator
 {
+    INJECT(notation, INotationConfiguration, configuration)
+
 public:
     IMasterNotationPtr newMasterNotation() const override;
     IExcerptNotationPtr newExcerptNotation() const override;
+
+    io::paths recoverableAutosaves() const override;
 };
 }
 
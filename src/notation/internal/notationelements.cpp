@@ -21,7 +21,11 @@
  */
 #include "notationelements.h"
 
+#include <algorithm>
+
+#include "libmscore/mscore.h"
 #include "libmscore/score.h"
+#include "libmscore/notetable.h"
 #include "libmscore/segment.h"
 #include "libmscore/rehearsalmark.h"
 #include "libmscore/measure.h"
@@ -171,7 +175,35 @@ std::vector<Element*> NotationElements::filterNotes(const FilterNotesOptions* no
 {
     Ms::NotePattern* pattern = constructNotePattern(notesOptions);
 
-    score()->scanElements(pattern, Ms::Score::collectNoteMatch);
+    //! NOTE The staves, voices, pitches and tpcs are matched in the columns of the note table,
+    //! only the notes left are checked against the whole pattern
+    const Ms::NoteTable& table = score()->noteTable();
+    const std::vector<int>& pitches = table.pitches();
+    const std::vector<int>& tpcs = table.tpcs();
+
+    int startTrack = 0;
+    int endTrack = score()->ntracks();
+    if (pattern->staffStart != -1) {
+        startTrack = pattern->staffStart * VOICES;
+        endTrack = std::min(pattern->staffEnd * VOICES, endTrack);
+    }
+
+    for (int track = startTrack; track < endTrack; ++track) {
+        if (pattern->voice != -1 && track % VOICES != pattern->voice) {
+            continue;
+        }
+
+        std::pair<size_t, size_t> rows = table.trackRows(track);
+        for (size_t row = rows.first; row < rows.second; ++row) {
+            if (pattern->pitch != -1 && pitches[row] != pattern->pitch) {
+                continue;
+            }
+            if (pattern->tpc != Ms::Tpc::TPC_INVALID && tpcs[row] != pattern->tpc) {
+                continue;
+            }
+            Ms::Score::collectNoteMatch(pattern, table.notes()[row]);
+        }
+    }
 
     std::vector<Element*> result;
     for (Element* element: pattern->el) {
@@ -1647,12 +1647,14 @@ void NotationInteraction::setDropTarget(Element* el)
     if (m_dropData.dropTarget != el) {
         if (m_dropData.dropTarget) {
             m_dropData.dropTarget->setDropTarget(false);
+            score()->paintDamage().refresh.unite(m_dropData.dropTarget->canvasBoundingRect());
             m_dropData.dropTarget = nullptr;
         }
 
         m_dropData.dropTarget = el;
         if (m_dropData.dropTarget) {
             m_dropData.dropTarget->setDropTarget(true);
+            score()->paintDamage().refresh.unite(m_dropData.dropTarget->canvasBoundingRect());
         }
     }
 
@@ -2237,18 +2239,9 @@ void NotationInteraction::swapSelection()
     QString mimeType = selection.mimeType();
 
     if (mimeType == Ms::mimeStaffListFormat) { // determine size of clipboard selection
-        const QMimeData* mimeData = this->selection()->mimeData();
-        QByteArray data = mimeData ? mimeData->data(Ms::mimeStaffListFormat) : QByteArray();
-        Ms::XmlReader reader(data);
-        reader.readNextStartElement();
-
-        Fraction tickLen = Fraction(0, 1);
-        int stavesCount = 0;
-
-        if (reader.name() == "StaffList") {
-            tickLen = Ms::Fraction::fromTicks(reader.intAttribute("len", 0));
-            stavesCount = reader.intAttribute("staves", 0);
-        }
+        //! NOTE The same size as written to the staff list by Selection::staffMimeData(), without serializing the selection
+        Fraction tickLen = selection.tickEnd() - selection.tickStart();
+        int stavesCount = selection.staffEnd() - selection.staffStart();
 
         if (tickLen > Ms::Fraction(0, 1)) { // attempt to extend selection to match clipboard size
             Ms::Segment* segment = selection.startSegment();
@@ -2267,11 +2260,9 @@ void NotationInteraction::swapSelection()
         }
     }
 
-    QByteArray currentSelectionBackup(selection.mimeData());
+    QMimeData* currentSelectionBackup = m_selection->mimeData();
     pasteSelection();
-    QMimeData* mimeData = new QMimeData();
-    mimeData->setData(mimeType, currentSelectionBackup);
-    QApplication::clipboard()->setMimeData(mimeData);
+    QApplication::clipboard()->setMimeData(currentSelectionBackup);
 }
 
 void NotationInteraction::deleteSelection()
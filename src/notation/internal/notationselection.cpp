@@ -24,6 +24,7 @@
 #include "libmscore/score.h"
 #include "libmscore/segment.h"
 #include "libmscore/measure.h"
+#include "libmscore/binaryxml.h"
 
 #include "notationselectionrange.h"
 
@@ -59,8 +60,14 @@ QMimeData* NotationSelection::mimeData() const
         return nullptr;
     }
 
+    QByteArray data = score()->selection().mimeData();
     QMimeData* mimeData = new QMimeData();
-    mimeData->setData(mimeType, score()->selection().mimeData());
+    mimeData->setData(mimeType, data);
+
+    //! NOTE The same version pastes the staff list from the binary form, other applications take the XML
+    if (mimeType == Ms::mimeStaffListFormat) {
+        mimeData->setData(Ms::mimeStaffListBinaryFormat, Ms::BinaryXmlReader::fromXml(data));
+    }
 
     return mimeData;
 }
@@ -118,10 +118,16 @@ void NotationUndoStack::commitChanges()
         return;
     }
 
+    const int droppedCount = undoStack()->droppedCount();
+
     score()->endCmd();
     masterScore()->setSaved(isStackClean());
 
     notifyAboutStateChanged();
+
+    if (undoStack()->droppedCount() != droppedCount) {
+        m_historyDropped.notify();
+    }
 }
 
 mu::async::Notification NotationUndoStack::stackChanged() const
@@ -129,6 +135,16 @@ mu::async::Notification NotationUndoStack::stackChanged() const
     return m_stackStateChanged;
 }
 
+size_t NotationUndoStack::historyMemoryUsage() const
+{
+    return undoStack() ? undoStack()->memoryUsage() : 0;
+}
+
+Notification NotationUndoStack::historyDropped() const
+{
+    return m_historyDropped;
+}
+
 Ms::Score* NotationUndoStack::score() const
 {
     return m_getScore->score();
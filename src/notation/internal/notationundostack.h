@@ -53,6 +53,9 @@ public:
 
     async::Notification stackChanged() const override;
 
+    size_t historyMemoryUsage() const override;
+    async::Notification historyDropped() const override;
+
 private:
     void notifyAboutNotationChanged();
     void notifyAboutStateChanged();
@@ -71,6 +74,7 @@ private:
     async::Notification m_stackStateChanged;
     async::Notification m_undoNotification;
     async::Notification m_redoNotification;
+    async::Notification m_historyDropped;
 };
 }
 
@@ -48,6 +48,7 @@ enum class Err {
     FileOld300Format    = 1018,
     FileCorrupted       = 1019,
     FileCriticalCorrupted = 1020,
+    FileCacheEntryFailed = 1021,
 
     // notation
     NoScore = 1030,
@@ -118,6 +119,7 @@ inline Ret make_ret(Err err, const io::path& filePath = "")
     case Err::UnknownError:
     case Err::UserAbort:
     case Err::IgnoreError:
+    case Err::FileCacheEntryFailed:
         break;
     }
 
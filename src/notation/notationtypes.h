@@ -22,11 +22,14 @@
 #ifndef MU_NOTATION_NOTATIONTYPES_H
 #define MU_NOTATION_NOTATIONTYPES_H
 
+#include <functional>
+
 #include <QPixmap>
 #include <QDate>
 
 #include "io/path.h"
 #include "translation.h"
+#include "draw/buffereddrawtypes.h"
 
 #include "libmscore/element.h"
 #include "libmscore/page.h"
@@ -54,6 +57,10 @@
 
 #include "instruments/instrumentstypes.h"
 
+namespace mu::draw {
+class Painter;
+}
+
 namespace mu::notation {
 using Page = Ms::Page;
 using Element = Ms::Element;
@@ -477,6 +484,24 @@ inline QList<StaffType> allStaffTypes()
     return result;
 }
 
+//! NOTE The recorded painting of a page. It is not changed after recording,
+//! so it can be shared with other threads, e.g. to rasterize it
+struct PageDrawing
+{
+    RectF pageRect;
+    std::vector<RectF> itemRects; // page coordinates, one per object
+    draw::DrawData data;
+    bool hasPixmaps = false;
+
+    int revision = 0;
+    int previousRevision = 0; // the drawing replaced by this one, 0 if none
+    RectF damage; // page coordinates, what differs from the previous drawing
+};
+
+using PageDrawingPtr = std::shared_ptr<const PageDrawing>;
+using PageContentPainter = std::function<void (draw::Painter* painter, const Page* page, const PageDrawingPtr& drawing,
+                                               const RectF& pageFrameRect)>;
+
 struct MeasureBeat
 {
     int measureIndex = 0;
@@ -153,6 +153,19 @@ FocusScope {
                     }
                 }
 
+                BusyIndicator {
+                    anchors.left: parent.left
+                    anchors.leftMargin: 8
+                    anchors.bottom: horizontalScrollBar.top
+                    anchors.bottomMargin: 8
+
+                    width: 24
+                    height: 24
+
+                    running: notationView.isLayoutInProgress
+                    visible: running
+                }
+
                 StyledMenuLoader {
                     id: contextMenuLoader
 
@@ -31,6 +31,7 @@ class MsczReaderMock : public IMsczMetaReader
 {
 public:
     MOCK_METHOD(MetaList, readMetaList, (const io::paths&), (const, override));
+    MOCK_METHOD(async::Channel<Meta>, readMetaListAsync, (const io::paths&), (const, override));
 };
 }
 
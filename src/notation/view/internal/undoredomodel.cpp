@@ -22,8 +22,12 @@
 
 #include "undoredomodel.h"
 
+#include "translation.h"
+#include "async/async.h"
+
 using namespace mu::notation;
 using namespace mu::ui;
+using namespace mu::framework;
 
 UndoRedoModel::UndoRedoModel(QObject* parent)
     : QObject(parent)
@@ -35,6 +39,11 @@ QVariant UndoRedoModel::undoItem() const
     MenuItem item = actionsRegister()->action("undo");
     item.state.enabled = undoStack() ? undoStack()->canUndo() : false;
 
+    if (undoStack()) {
+        const double historyMb = undoStack()->historyMemoryUsage() / (1024.0 * 1024.0);
+        item.description += "\n" + qtrc("notation", "Undo history: %1 MB").arg(historyMb, 0, 'f', 1);
+    }
+
     return item.toMap();
 }
 
@@ -57,6 +66,13 @@ void UndoRedoModel::load()
         undoStack()->stackChanged().onNotify(this, [this]() {
             emit stackChanged();
         });
+
+        //! NOTE Not shown in the middle of the edit which dropped the history
+        undoStack()->historyDropped().onNotify(this, [this]() {
+            async::Async::call(this, [this]() {
+                warnAboutDroppedHistory();
+            });
+        });
     });
 
     emit stackChanged();
@@ -76,6 +92,29 @@ void UndoRedoModel::undo()
     }
 }
 
+void UndoRedoModel::warnAboutDroppedHistory()
+{
+    if (m_droppedHistoryWarned || !configuration()->needShowWarningAboutDroppedUndoHistory()) {
+        return;
+    }
+
+    m_droppedHistoryWarned = true;
+
+    std::string title = trc("notation", "Your earliest changes can no longer be undone");
+    std::string body = qtrc("notation", "The undo history is limited to %1 MB of memory. "
+                                        "The oldest changes were removed from it to stay within this limit.")
+                       .arg(configuration()->undoHistoryMemoryBudgetMegabytes()).toStdString();
+
+    IInteractive::Options options {
+        IInteractive::Option::WithIcon | IInteractive::Option::WithShowAgain
+    };
+
+    IInteractive::Result result = interactive()->warning(title, body, { IInteractive::Button::Ok },
+                                                         IInteractive::Button::Ok, options);
+
+    configuration()->setNeedShowWarningAboutDroppedUndoHistory(result.showAgain());
+}
+
 INotationUndoStackPtr UndoRedoModel::undoStack() const
 {
     INotationPtr notation = context()->currentNotation();
@@ -26,6 +26,8 @@
 
 #include "context/iglobalcontext.h"
 #include "ui/iuiactionsregister.h"
+#include "iinteractive.h"
+#include "notation/inotationconfiguration.h"
 #include "modularity/ioc.h"
 #include "async/asyncable.h"
 
@@ -39,6 +41,8 @@ class UndoRedoModel : public QObject, public async::Asyncable
 
     INJECT(notation, context::IGlobalContext, context)
     INJECT(notation, ui::IUiActionsRegister, actionsRegister)
+    INJECT(notation, framework::IInteractive, interactive)
+    INJECT(notation, INotationConfiguration, configuration)
 
 public:
     explicit UndoRedoModel(QObject* parent = nullptr);
@@ -55,6 +59,9 @@ signals:
 
 private:
     INotationUndoStackPtr undoStack() const;
+    void warnAboutDroppedHistory();
+
+    bool m_droppedHistoryWarned = false;
 };
 }
 
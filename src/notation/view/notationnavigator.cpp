@@ -29,6 +29,10 @@ NotationNavigator::NotationNavigator(QQuickItem* parent)
     : NotationPaintView(parent)
 {
     setReadonly(true);
+
+    m_thumbnails.thumbnailRendered().onNotify(this, [this]() {
+        update();
+    });
 }
 
 void NotationNavigator::load()
@@ -36,10 +40,17 @@ void NotationNavigator::load()
     initOrientation();
     initVisible();
 
+    updatePageLabelStyle();
+
     uiConfiguration()->currentThemeChanged().onNotify(this, [this]() {
+        updatePageLabelStyle();
         update();
     });
 
+    globalContext()->currentNotationChanged().onNotify(this, [this]() {
+        m_thumbnails.clear();
+    });
+
     NotationPaintView::load();
 }
 
@@ -231,8 +242,13 @@ void NotationNavigator::paint(QPainter* painter)
 
     NotationPaintView::paint(painter);
     paintCursor(painter);
+}
 
-    paintPageNumbers(painter);
+void NotationNavigator::paintPageContent(draw::Painter* painter, const Page* page, const PageDrawingPtr& drawing, const RectF&)
+{
+    //! NOTE The whole page is painted from its thumbnail, the page numbers are painted on the thumbnails
+    QString label = notationViewMode() == ViewMode::PAGE ? QString::number(page->no() + 1) : QString();
+    m_thumbnails.paint(painter, page, drawing, label);
 }
 
 void NotationNavigator::paintCursor(QPainter* painter)
@@ -245,22 +261,10 @@ void NotationNavigator::paintCursor(QPainter* painter)
     painter->drawRect(m_cursorRect);
 }
 
-void NotationNavigator::paintPageNumbers(QPainter* painter)
+void NotationNavigator::updatePageLabelStyle()
 {
-    if (notationViewMode() != ViewMode::PAGE) {
-        return;
-    }
-
     constexpr int PAGE_NUMBER_FONT_SIZE = 2000;
     QFont font(QString::fromStdString(configuration()->fontFamily()), PAGE_NUMBER_FONT_SIZE);
 
-    for (const Page* page : pages()) {
-        painter->translate(page->pos().toQPointF());
-
-        painter->setFont(font);
-        painter->setPen(configuration()->layoutBreakColor());
-        painter->drawText(page->bbox().toQRectF(), Qt::AlignCenter, QString("%1").arg(page->no() + 1));
-
-        painter->translate(-page->pos().toQPointF());
-    }
+    m_thumbnails.setLabelStyle(font, configuration()->layoutBreakColor());
 }
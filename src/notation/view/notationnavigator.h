@@ -31,6 +31,7 @@
 #include "context/iglobalcontext.h"
 #include "ui/iuiconfiguration.h"
 #include "notationpaintview.h"
+#include "pagethumbnailcache.h"
 
 namespace mu::notation {
 class NotationNavigator : public NotationPaintView
@@ -66,13 +67,14 @@ private:
     void rescale();
 
     void paint(QPainter* painter) override;
+    void paintPageContent(draw::Painter* painter, const Page* page, const PageDrawingPtr& drawing, const RectF& pageFrameRect) override;
 
     void wheelEvent(QWheelEvent* event) override;
     void mousePressEvent(QMouseEvent* event) override;
     void mouseMoveEvent(QMouseEvent* event) override;
 
     void paintCursor(QPainter* painter);
-    void paintPageNumbers(QPainter* painter);
+    void updatePageLabelStyle();
 
     void moveCanvasToRect(const QRect& viewRect);
 
@@ -83,6 +85,8 @@ private:
 
     QRect m_cursorRect;
     PointF m_startMove;
+
+    PageThumbnailCache m_thumbnails;
 };
 }
 
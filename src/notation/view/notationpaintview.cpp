@@ -68,6 +68,10 @@ NotationPaintView::NotationPaintView(QQuickItem* parent)
     m_loopInMarker = std::make_unique<LoopMarker>(LoopBoundaryType::LoopIn);
     m_loopOutMarker = std::make_unique<LoopMarker>(LoopBoundaryType::LoopOut);
 
+    m_tileCache.tilesRendered().onNotify(this, [this]() {
+        update();
+    });
+
     //! NOTE For Autobot tests tool
     dispatcher()->reg(this, "dev-notationview-redraw", [this]() {
         update();
@@ -107,6 +111,8 @@ void NotationPaintView::initBackground()
     emit backgroundColorChanged(configuration()->backgroundColor());
 
     configuration()->backgroundChanged().onNotify(this, [this]() {
+        m_backgroundWallpaperPath.clear();
+        m_backgroundWallpaper = QPixmap();
         emit backgroundColorChanged(configuration()->backgroundColor());
         update();
     });
@@ -182,11 +188,14 @@ void NotationPaintView::onCurrentNotationChanged()
 
     if (m_notation) {
         m_notation->notationChanged().resetOnNotify(this);
+        m_notation->layoutInProgress().ch.resetOnReceive(this);
         INotationInteractionPtr interaction = m_notation->interaction();
         interaction->noteInput()->stateChanged().resetOnNotify(this);
         interaction->selectionChanged().resetOnNotify(this);
     }
 
+    m_tileCache.clear();
+
     m_notation = globalContext()->currentNotation();
     if (!m_notation) {
         return;
@@ -198,6 +207,11 @@ void NotationPaintView::onCurrentNotationChanged()
         update();
     });
 
+    m_notation->layoutInProgress().ch.onReceive(this, [this](bool) {
+        emit layoutInProgressChanged();
+    });
+    emit layoutInProgressChanged();
+
     onNoteInputChanged();
 
     INotationInteractionPtr interaction = notationInteraction();
@@ -355,7 +369,9 @@ void NotationPaintView::paint(QPainter* qp)
         return;
     }
 
-    mu::draw::Painter mup(qp, "notationview");
+    auto provider = std::make_shared<draw::QPainterProvider>(qp);
+    provider->setUseGlyphAtlas(true);
+    mu::draw::Painter mup(provider, "notationview");
     mu::draw::Painter* painter = &mup;
 
     RectF rect(0.0, 0.0, width(), height());
@@ -363,7 +379,10 @@ void NotationPaintView::paint(QPainter* qp)
 
     painter->setWorldTransform(m_matrix);
 
-    notation()->paint(painter, toLogical(rect.toQRect()));
+    notation()->paint(painter, toLogical(rect.toQRect()), [this](draw::Painter* pagePainter, const Page* page,
+                                                                 const PageDrawingPtr& drawing, const RectF& pageFrameRect) {
+        paintPageContent(pagePainter, page, drawing, pageFrameRect);
+    });
 
     m_playbackCursor->paint(painter);
     m_noteInputCursor->paint(painter);
@@ -371,6 +390,12 @@ void NotationPaintView::paint(QPainter* qp)
     m_loopOutMarker->paint(painter);
 }
 
+void NotationPaintView::paintPageContent(draw::Painter* painter, const Page* page, const PageDrawingPtr& drawing,
+                                         const RectF& pageFrameRect)
+{
+    m_tileCache.paint(painter, page, drawing, pageFrameRect);
+}
+
 void NotationPaintView::paintBackground(const RectF& rect, draw::Painter* painter)
 {
     QString wallpaperPath = configuration()->backgroundWallpaperPath().toQString();
@@ -378,8 +403,11 @@ void NotationPaintView::paintBackground(const RectF& rect, draw::Painter* painte
     if (configuration()->backgroundUseColor() || wallpaperPath.isEmpty()) {
         painter->fillRect(rect, configuration()->backgroundColor());
     } else {
-        QPixmap pixmap(wallpaperPath);
-        painter->drawTiledPixmap(rect, pixmap, rect.topLeft() - PointF(m_matrix.m31(), m_matrix.m32()));
+        if (wallpaperPath != m_backgroundWallpaperPath) {
+            m_backgroundWallpaper = QPixmap(wallpaperPath);
+            m_backgroundWallpaperPath = wallpaperPath;
+        }
+        painter->drawTiledPixmap(rect, m_backgroundWallpaper, rect.topLeft() - PointF(m_matrix.m31(), m_matrix.m32()));
     }
 }
 
@@ -440,6 +468,11 @@ QRect NotationPaintView::viewport() const
     return toLogical(QRect(0, 0, width(), height())).toQRect();
 }
 
+bool NotationPaintView::isLayoutInProgress() const
+{
+    return m_notation ? m_notation->layoutInProgress().val : false;
+}
+
 QRectF NotationPaintView::notationContentRect() const
 {
     if (!notationElements()) {
@@ -747,6 +780,7 @@ void NotationPaintView::setReadonly(bool readonly)
 
 void NotationPaintView::clear()
 {
+    m_tileCache.clear();
     m_matrix = QTransform();
     m_previousHorizontalScrollPosition = 0;
     m_previousVerticalScrollPosition = 0;
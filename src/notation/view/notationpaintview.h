@@ -41,6 +41,7 @@
 #include "noteinputcursor.h"
 #include "playbackcursor.h"
 #include "loopmarker.h"
+#include "pagetilecache.h"
 
 namespace mu::notation {
 class NotationPaintView : public QQuickPaintedItem, public IControlledView, public async::Asyncable, public actions::Actionable
@@ -62,6 +63,7 @@ class NotationPaintView : public QQuickPaintedItem, public IControlledView, publ
 
     Q_PROPERTY(QColor backgroundColor READ backgroundColor NOTIFY backgroundColorChanged)
     Q_PROPERTY(QRect viewport READ viewport NOTIFY viewportChanged)
+    Q_PROPERTY(bool isLayoutInProgress READ isLayoutInProgress NOTIFY layoutInProgressChanged)
 
 public:
     explicit NotationPaintView(QQuickItem* parent = nullptr);
@@ -102,6 +104,7 @@ public:
 
     QColor backgroundColor() const;
     QRect viewport() const;
+    bool isLayoutInProgress() const;
 
 signals:
     void openContextMenuRequested(const QVariantList& items, const QPoint& pos);
@@ -112,6 +115,7 @@ signals:
 
     void backgroundColorChanged(QColor color);
     void viewportChanged(QRect viewport);
+    void layoutInProgressChanged();
 
     void activeFocusRequested();
 
@@ -129,6 +133,7 @@ protected:
 
     // Draw
     void paint(QPainter* painter) override;
+    virtual void paintPageContent(draw::Painter* painter, const Page* page, const PageDrawingPtr& drawing, const RectF& pageFrameRect);
 
 protected slots:
     virtual void onViewSizeChanged();
@@ -194,6 +199,10 @@ private:
     std::unique_ptr<NoteInputCursor> m_noteInputCursor;
     std::unique_ptr<LoopMarker> m_loopInMarker;
     std::unique_ptr<LoopMarker> m_loopOutMarker;
+    PageTileCache m_tileCache;
+
+    QString m_backgroundWallpaperPath;
+    QPixmap m_backgroundWallpaper;
 
     qreal m_previousVerticalScrollPosition = 0;
     qreal m_previousHorizontalScrollPosition = 0;
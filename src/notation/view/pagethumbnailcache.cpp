@@ -0,0 +1,180 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "pagethumbnailcache.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QPainter>
+#include <QtConcurrent>
+
+#include "draw/painter.h"
+#include "draw/qpainterprovider.h"
+#include "draw/utils/drawdatapaint.h"
+
+using namespace mu::notation;
+
+static constexpr int MAX_CACHE_COST_KB = 64 * 1024;
+
+//! NOTE A thumbnail is rendered again when the view is zoomed by more than this
+static constexpr qreal MAX_SCALING_RATIO = 1.25;
+
+PageThumbnailCache::PageThumbnailCache()
+    : m_thumbnails(MAX_CACHE_COST_KB), m_sendMutex(std::make_shared<std::mutex>())
+{
+    m_thumbnailReady.onReceive(this, [this](const RenderedThumbnail& rendered) {
+        m_pending.remove(rendered.page);
+
+        Thumbnail* thumbnail = new Thumbnail();
+        thumbnail->revision = rendered.revision;
+        thumbnail->label = rendered.label;
+        thumbnail->scaling = rendered.scaling;
+        thumbnail->pixmap = QPixmap::fromImage(rendered.image);
+
+        m_thumbnails.insert(rendered.page, thumbnail, std::max(1, int(rendered.image.sizeInBytes() / 1024)));
+        m_thumbnailRendered.notify();
+    }, Asyncable::AsyncMode::AsyncSetRepeat);
+}
+
+void PageThumbnailCache::setLabelStyle(const QFont& font, const QColor& color)
+{
+    if (m_labelStyle.font == font && m_labelStyle.color == color) {
+        return;
+    }
+
+    m_labelStyle.font = font;
+    m_labelStyle.color = color;
+    m_thumbnails.clear();
+}
+
+mu::async::Notification PageThumbnailCache::thumbnailRendered() const
+{
+    return m_thumbnailRendered;
+}
+
+void PageThumbnailCache::clear()
+{
+    m_thumbnails.clear();
+}
+
+void PageThumbnailCache::paint(draw::Painter* painter, const Page* page, const PageDrawingPtr& drawing, const QString& label)
+{
+    QPainter* qp = painter->qpainter();
+
+    //! NOTE Pixmaps cannot be drawn on other threads, so pages with images are painted from the vectors
+    if (!qp || drawing->hasPixmaps) {
+        paintVectors(painter, *drawing, label);
+        return;
+    }
+
+    const qreal scaling = qp->combinedTransform().m11() * qp->device()->devicePixelRatioF();
+
+    const Thumbnail* thumbnail = m_thumbnails.object(page);
+    bool isActual = thumbnail && thumbnail->revision == drawing->revision && thumbnail->label == label
+                    && scaling <= thumbnail->scaling * MAX_SCALING_RATIO && scaling * MAX_SCALING_RATIO >= thumbnail->scaling;
+    if (!isActual) {
+        requestThumbnail(page, drawing, scaling, label);
+    }
+
+    if (!thumbnail) {
+        paintVectors(painter, *drawing, label);
+        return;
+    }
+
+    qp->save();
+    qp->setRenderHint(QPainter::SmoothPixmapTransform, true);
+    qp->drawPixmap(drawing->pageRect.toQRectF(), thumbnail->pixmap, QRectF(thumbnail->pixmap.rect()));
+    qp->restore();
+}
+
+void PageThumbnailCache::requestThumbnail(const Page* page, const PageDrawingPtr& drawing, qreal scaling, const QString& label)
+{
+    if (m_pending.contains(page)) {
+        return;
+    }
+
+    m_pending.insert(page);
+
+    LabelStyle style = m_labelStyle;
+    async::Channel<RenderedThumbnail> thumbnailReady = m_thumbnailReady;
+    std::shared_ptr<std::mutex> sendMutex = m_sendMutex;
+    QtConcurrent::run([page, drawing, scaling, label, style, thumbnailReady, sendMutex]() mutable {
+        RenderedThumbnail rendered;
+        rendered.page = page;
+        rendered.revision = drawing->revision;
+        rendered.label = label;
+        rendered.scaling = scaling;
+        rendered.image = th_renderThumbnail(*drawing, scaling, label, style);
+
+        std::lock_guard<std::mutex> lock(*sendMutex);
+        thumbnailReady.send(rendered);
+    });
+}
+
+QImage PageThumbnailCache::th_renderThumbnail(const PageDrawing& drawing, qreal scaling, const QString& label,
+                                              const LabelStyle& style)
+{
+    const RectF& pageRect = drawing.pageRect;
+    QImage image(std::max(1, int(std::ceil(pageRect.width() * scaling))), std::max(1, int(std::ceil(pageRect.height() * scaling))),
+                 QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+
+    auto provider = std::make_shared<draw::QPainterProvider>(new QPainter(&image), true);
+    provider->setUseGlyphAtlas(true);
+    draw::Painter painter(provider, "notationthumbnail");
+    painter.setAntialiasing(true);
+    painter.scale(scaling, scaling);
+    painter.translate(-pageRect.topLeft());
+
+    const size_t count = std::min(drawing.itemRects.size(), drawing.data.objects.size());
+    for (size_t i = 0; i < count; ++i) {
+        draw::DrawDataPaint::paint(&painter, drawing.data.objects[i]);
+    }
+
+    if (!label.isEmpty()) {
+        QPainter* qp = painter.qpainter();
+        qp->setFont(style.font);
+        qp->setPen(style.color);
+        qp->drawText(pageRect.toQRectF(), Qt::AlignCenter, label);
+    }
+
+    painter.endDraw();
+
+    return image;
+}
+
+void PageThumbnailCache::paintVectors(draw::Painter* painter, const PageDrawing& drawing, const QString& label) const
+{
+    const size_t count = std::min(drawing.itemRects.size(), drawing.data.objects.size());
+    for (size_t i = 0; i < count; ++i) {
+        draw::DrawDataPaint::paint(painter, drawing.data.objects[i]);
+    }
+
+    QPainter* qp = painter->qpainter();
+    if (qp && !label.isEmpty()) {
+        qp->save();
+        qp->setFont(m_labelStyle.font);
+        qp->setPen(m_labelStyle.color);
+        qp->drawText(drawing.pageRect.toQRectF(), Qt::AlignCenter, label);
+        qp->restore();
+    }
+}
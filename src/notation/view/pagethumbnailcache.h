@@ -0,0 +1,94 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_NOTATION_PAGETHUMBNAILCACHE_H
+#define MU_NOTATION_PAGETHUMBNAILCACHE_H
+
+#include <memory>
+#include <mutex>
+
+#include <QCache>
+#include <QColor>
+#include <QFont>
+#include <QImage>
+#include <QPixmap>
+#include <QSet>
+
+#include "async/asyncable.h"
+#include "async/channel.h"
+#include "async/notification.h"
+
+#include "notation/notationtypes.h"
+
+namespace mu::notation {
+//! NOTE Paints the contents of the pages from one raster thumbnail per page, with the page label on it.
+//! The thumbnails are rendered from the recorded page drawings on the global thread pool
+//! and only rendered again for the changed pages, until then the previous one is shown.
+class PageThumbnailCache : public async::Asyncable
+{
+public:
+    PageThumbnailCache();
+
+    void setLabelStyle(const QFont& font, const QColor& color);
+
+    void paint(draw::Painter* painter, const Page* page, const PageDrawingPtr& drawing, const QString& label);
+    void clear();
+
+    //! NOTE Sent on the main thread when a thumbnail is rendered, the view has to be repainted
+    async::Notification thumbnailRendered() const;
+
+private:
+    struct Thumbnail {
+        int revision = 0;
+        QString label;
+        qreal scaling = 0;
+        QPixmap pixmap;
+    };
+
+    struct RenderedThumbnail {
+        const Page* page = nullptr;
+        int revision = 0;
+        QString label;
+        qreal scaling = 0;
+        QImage image;
+    };
+
+    struct LabelStyle {
+        QFont font;
+        QColor color;
+    };
+
+    static QImage th_renderThumbnail(const PageDrawing& drawing, qreal scaling, const QString& label, const LabelStyle& style);
+
+    void requestThumbnail(const Page* page, const PageDrawingPtr& drawing, qreal scaling, const QString& label);
+    void paintVectors(draw::Painter* painter, const PageDrawing& drawing, const QString& label) const;
+
+    QCache<const Page*, Thumbnail> m_thumbnails;
+    QSet<const Page*> m_pending;
+    LabelStyle m_labelStyle;
+
+    async::Channel<RenderedThumbnail> m_thumbnailReady;
+    std::shared_ptr<std::mutex> m_sendMutex;
+    async::Notification m_thumbnailRendered;
+};
+}
+
+#endif // MU_NOTATION_PAGETHUMBNAILCACHE_H
@@ -0,0 +1,382 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "pagetilecache.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QPainter>
+#include <QPainterPath>
+#include <QtConcurrent>
+
+#include "draw/painter.h"
+#include "draw/qpainterprovider.h"
+#include "draw/utils/drawdatapaint.h"
+
+#include "libmscore/page.h"
+#include "libmscore/score.h"
+
+using namespace mu::notation;
+
+static constexpr int LEVELS_PER_OCTAVE = 4;
+static constexpr int MAX_SCALED_LEVEL_DISTANCE = 2 * LEVELS_PER_OCTAVE;
+static constexpr int MAX_CACHE_COST_KB = 256 * 1024;
+
+//! NOTE The margin in pixels around a tile for the antialiased edges of the items
+static constexpr qreal TILE_MARGIN = 2.0;
+
+namespace mu::notation {
+uint qHash(const PageTileCache::TileKey& key, uint seed)
+{
+    return ::qHash(key.page.first, seed) ^ ::qHash(key.page.second << 8) ^ ::qHash(key.level) ^ ::qHash((key.column << 16) ^ key.row);
+}
+}
+
+static bool intersects(const mu::RectF& r1, const mu::RectF& r2)
+{
+    return r1.right() >= r2.left() && r1.left() <= r2.right() && r1.bottom() >= r2.top() && r1.top() <= r2.bottom();
+}
+
+PageTileCache::PageTileCache()
+    : m_tiles(MAX_CACHE_COST_KB), m_sendMutex(std::make_shared<std::mutex>())
+{
+    m_tileRendered.onReceive(this, [this](const RenderedTile& tile) {
+        m_pending.remove(tile.key);
+
+        auto it = m_revisions.find(tile.key.page);
+        bool isActual = it != m_revisions.end() && it->second == tile.revision;
+        if (isActual) {
+            //! NOTE A null pixmap marks a tile without items
+            const int cost = tile.image.isNull() ? 1 : tile.image.sizeInBytes() / 1024;
+            m_tiles.insert(tile.key, new QPixmap(QPixmap::fromImage(tile.image)), cost);
+            m_levels[tile.key.page].insert(tile.key.level);
+        }
+
+        m_tilesRendered.notify();
+    }, Asyncable::AsyncMode::AsyncSetRepeat);
+}
+
+mu::async::Notification PageTileCache::tilesRendered() const
+{
+    return m_tilesRendered;
+}
+
+void PageTileCache::clear()
+{
+    m_tiles.clear();
+    m_revisions.clear();
+    m_levels.clear();
+    m_pending.clear();
+    m_generation = -1;
+}
+
+int PageTileCache::zoomLevel(qreal scaling)
+{
+    //! NOTE Rounded up, so the tiles are only ever scaled down
+    return static_cast<int>(std::ceil(std::log2(scaling) * LEVELS_PER_OCTAVE - 0.01));
+}
+
+qreal PageTileCache::levelScaling(int level)
+{
+    return std::pow(2.0, static_cast<qreal>(level) / LEVELS_PER_OCTAVE);
+}
+
+mu::RectF PageTileCache::tileRect(int level, int column, int row)
+{
+    const qreal span = TILE_SIZE / levelScaling(level);
+    return RectF(column * span, row * span, span, span);
+}
+
+void PageTileCache::paint(draw::Painter* painter, const Page* page, const PageDrawingPtr& drawing, const RectF& pageFrameRect)
+{
+    QPainter* qp = painter->qpainter();
+
+    //! NOTE Pixmaps cannot be drawn on other threads, so pages with images are painted from the vectors
+    if (!qp || drawing->hasPixmaps || qp->combinedTransform().isRotating()) {
+        paintVectors(painter, *drawing, { pageFrameRect });
+        return;
+    }
+
+    const PageKey key = pageKey(page);
+    dropOtherGenerations(key.second);
+    updateRevision(key, *drawing);
+
+    const RectF visibleRect = pageFrameRect.intersected(drawing->pageRect);
+    if (visibleRect.isEmpty()) {
+        return;
+    }
+
+    const qreal scaling = qp->combinedTransform().m11() * qp->device()->devicePixelRatioF();
+    const int level = zoomLevel(scaling);
+    const qreal span = TILE_SIZE / levelScaling(level);
+
+    const int firstColumn = static_cast<int>(std::floor(visibleRect.left() / span));
+    const int lastColumn = static_cast<int>(std::floor(visibleRect.right() / span));
+    const int firstRow = static_cast<int>(std::floor(visibleRect.top() / span));
+    const int lastRow = static_cast<int>(std::floor(visibleRect.bottom() / span));
+
+    std::vector<RectF> missingRects;
+
+    qp->save();
+    qp->setRenderHint(QPainter::Antialiasing, false);
+    qp->setRenderHint(QPainter::SmoothPixmapTransform, true);
+
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int column = firstColumn; column <= lastColumn; ++column) {
+            const TileKey tileKey { key, level, column, row };
+            const RectF rect = tileRect(level, column, row);
+
+            if (const QPixmap* tile = m_tiles.object(tileKey)) {
+                if (!tile->isNull()) {
+                    qp->drawPixmap(rect.toQRectF(), *tile, QRectF(tile->rect()));
+                }
+                continue;
+            }
+
+            requestTile(tileKey, drawing);
+
+            if (!paintScaled(qp, tileKey, rect)) {
+                missingRects.push_back(rect);
+            }
+        }
+    }
+
+    qp->restore();
+
+    if (!missingRects.empty()) {
+        paintVectors(painter, *drawing, missingRects);
+    }
+}
+
+PageTileCache::PageKey PageTileCache::pageKey(const Page* page)
+{
+    return { page->no(), page->score()->layoutGeneration() };
+}
+
+//! NOTE Deleted pages may be reallocated at the same address and renumbered,
+//! so nothing of an older layout generation is reused. A tile still rendered
+//! for it is dropped when it arrives, it has no revision anymore.
+void PageTileCache::dropOtherGenerations(int generation)
+{
+    if (generation == m_generation) {
+        return;
+    }
+
+    m_generation = generation;
+
+    for (const TileKey& key : m_tiles.keys()) {
+        if (key.page.second != generation) {
+            m_tiles.remove(key);
+        }
+    }
+
+    for (auto it = m_revisions.begin(); it != m_revisions.end();) {
+        it = it->first.second == generation ? std::next(it) : m_revisions.erase(it);
+    }
+
+    for (auto it = m_levels.begin(); it != m_levels.end();) {
+        it = it->first.second == generation ? std::next(it) : m_levels.erase(it);
+    }
+
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        it = it->page.second == generation ? std::next(it) : m_pending.erase(it);
+    }
+}
+
+void PageTileCache::updateRevision(const PageKey& page, const PageDrawing& drawing)
+{
+    auto it = m_revisions.find(page);
+    if (it != m_revisions.end() && it->second == drawing.revision) {
+        return;
+    }
+
+    bool isPartial = it != m_revisions.end() && it->second == drawing.previousRevision && !drawing.damage.isNull();
+    invalidate(page, isPartial ? drawing.damage : RectF());
+
+    m_revisions[page] = drawing.revision;
+}
+
+void PageTileCache::invalidate(const PageKey& page, const RectF& damage)
+{
+    for (const TileKey& key : m_tiles.keys()) {
+        if (key.page != page) {
+            continue;
+        }
+
+        if (!damage.isNull()) {
+            const qreal margin = TILE_MARGIN / levelScaling(key.level);
+            RectF rect = tileRect(key.level, key.column, key.row).adjusted(-margin, -margin, margin, margin);
+            if (!intersects(rect, damage)) {
+                continue;
+            }
+        }
+
+        m_tiles.remove(key);
+    }
+}
+
+void PageTileCache::requestTile(const TileKey& key, const PageDrawingPtr& drawing)
+{
+    if (m_pending.contains(key)) {
+        return;
+    }
+
+    m_pending.insert(key);
+
+    async::Channel<RenderedTile> tileRendered = m_tileRendered;
+    std::shared_ptr<std::mutex> sendMutex = m_sendMutex;
+    QtConcurrent::run([key, drawing, tileRendered, sendMutex]() mutable {
+        RenderedTile tile;
+        tile.key = key;
+        tile.revision = drawing->revision;
+        tile.image = th_renderTile(*drawing, key);
+
+        std::lock_guard<std::mutex> lock(*sendMutex);
+        tileRendered.send(tile);
+    });
+}
+
+QImage PageTileCache::th_renderTile(const PageDrawing& drawing, const TileKey& key)
+{
+    const RectF rect = tileRect(key.level, key.column, key.row);
+    const qreal scaling = levelScaling(key.level);
+    const qreal margin = TILE_MARGIN / scaling;
+    const RectF cullRect = rect.adjusted(-margin, -margin, margin, margin);
+
+    std::vector<const draw::DrawData::Object*> objects;
+    const size_t count = std::min(drawing.itemRects.size(), drawing.data.objects.size());
+    for (size_t i = 0; i < count; ++i) {
+        if (intersects(drawing.itemRects[i], cullRect)) {
+            objects.push_back(&drawing.data.objects[i]);
+        }
+    }
+
+    if (objects.empty()) {
+        return QImage();
+    }
+
+    QImage image(TILE_SIZE, TILE_SIZE, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+
+    auto provider = std::make_shared<draw::QPainterProvider>(new QPainter(&image), true);
+    provider->setUseGlyphAtlas(true);
+    draw::Painter painter(provider, "notationtile");
+    painter.setAntialiasing(true);
+    painter.scale(scaling, scaling);
+    painter.translate(-rect.topLeft());
+
+    for (const draw::DrawData::Object* obj : objects) {
+        draw::DrawDataPaint::paint(&painter, *obj);
+    }
+
+    painter.endDraw();
+
+    return image;
+}
+
+bool PageTileCache::paintScaled(QPainter* painter, const TileKey& key, const RectF& rect) const
+{
+    auto levels = m_levels.find(key.page);
+    if (levels == m_levels.end()) {
+        return false;
+    }
+
+    //! NOTE The nearest level first, the sharper one of two equally near
+    std::vector<int> candidates;
+    for (int level : levels->second) {
+        if (level != key.level && std::abs(level - key.level) <= MAX_SCALED_LEVEL_DISTANCE) {
+            candidates.push_back(level);
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [&key](int l1, int l2) {
+        int d1 = std::abs(l1 - key.level);
+        int d2 = std::abs(l2 - key.level);
+        return d1 != d2 ? d1 < d2 : l1 > l2;
+    });
+
+    for (int level : candidates) {
+        const qreal scaling = levelScaling(level);
+        const qreal span = TILE_SIZE / scaling;
+        const int firstColumn = static_cast<int>(std::floor(rect.left() / span));
+        const int lastColumn = static_cast<int>(std::ceil(rect.right() / span)) - 1;
+        const int firstRow = static_cast<int>(std::floor(rect.top() / span));
+        const int lastRow = static_cast<int>(std::ceil(rect.bottom() / span)) - 1;
+
+        std::vector<std::pair<TileKey, const QPixmap*> > tiles;
+        for (int row = firstRow; row <= lastRow; ++row) {
+            for (int column = firstColumn; column <= lastColumn; ++column) {
+                const TileKey scaledKey { key.page, level, column, row };
+                tiles.push_back({ scaledKey, m_tiles.object(scaledKey) });
+            }
+        }
+
+        bool isComplete = std::all_of(tiles.cbegin(), tiles.cend(), [](const auto& tile) { return tile.second != nullptr; });
+        if (!isComplete) {
+            continue;
+        }
+
+        for (const auto& tile : tiles) {
+            if (tile.second->isNull()) {
+                continue;
+            }
+
+            const RectF scaledRect = tileRect(level, tile.first.column, tile.first.row);
+            const RectF part = scaledRect.intersected(rect);
+            const QRectF source((part.left() - scaledRect.left()) * scaling, (part.top() - scaledRect.top()) * scaling,
+                                part.width() * scaling, part.height() * scaling);
+            painter->drawPixmap(part.toQRectF(), *tile.second, source);
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+void PageTileCache::paintVectors(draw::Painter* painter, const PageDrawing& drawing, const std::vector<RectF>& rects) const
+{
+    RectF bounds;
+    QPainterPath clipPath;
+    for (const RectF& rect : rects) {
+        bounds = bounds.united(rect);
+        clipPath.addRect(rect.toQRectF());
+    }
+
+    //! NOTE The neighbour tiles are painted already, the items must not be painted over them
+    QPainter* qp = painter->qpainter();
+    if (qp) {
+        qp->save();
+        qp->setClipPath(clipPath, Qt::IntersectClip);
+    }
+
+    const size_t count = std::min(drawing.itemRects.size(), drawing.data.objects.size());
+    for (size_t i = 0; i < count; ++i) {
+        if (intersects(drawing.itemRects[i], bounds)) {
+            draw::DrawDataPaint::paint(painter, drawing.data.objects[i]);
+        }
+    }
+
+    if (qp) {
+        qp->restore();
+    }
+}
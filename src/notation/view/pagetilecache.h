@@ -0,0 +1,113 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_NOTATION_PAGETILECACHE_H
+#define MU_NOTATION_PAGETILECACHE_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include <QCache>
+#include <QImage>
+#include <QPixmap>
+#include <QSet>
+
+#include "async/asyncable.h"
+#include "async/channel.h"
+#include "async/notification.h"
+
+#include "notation/notationtypes.h"
+
+class QPainter;
+
+namespace mu::notation {
+//! NOTE Paints the contents of the pages from raster tiles.
+//! The tiles are rendered from the recorded page drawings on the global thread pool,
+//! at a few zoom levels, so they are reused while scrolling and zooming.
+//! A missing tile is drawn scaled from another zoom level while it is rendered,
+//! or from the vectors if there is none.
+//! Like the display lists, the tiles are kept per page number and layout generation,
+//! and the tiles of an older generation are dropped.
+class PageTileCache : public async::Asyncable
+{
+public:
+    static constexpr int TILE_SIZE = 256;
+
+    PageTileCache();
+
+    void paint(draw::Painter* painter, const Page* page, const PageDrawingPtr& drawing, const RectF& pageFrameRect);
+    void clear();
+
+    //! NOTE Sent on the main thread when rendered tiles are added, the view has to be repainted
+    async::Notification tilesRendered() const;
+
+private:
+    using PageKey = std::pair<int /*page number*/, int /*layout generation*/>;
+
+    struct TileKey {
+        PageKey page;
+        int level = 0;
+        int column = 0;
+        int row = 0;
+
+        bool operator==(const TileKey& other) const
+        {
+            return page == other.page && level == other.level && column == other.column && row == other.row;
+        }
+    };
+
+    struct RenderedTile {
+        TileKey key;
+        int revision = 0;
+        QImage image;
+    };
+
+    friend uint qHash(const TileKey& key, uint seed);
+
+    static int zoomLevel(qreal scaling);
+    static qreal levelScaling(int level);
+    static RectF tileRect(int level, int column, int row);
+    static QImage th_renderTile(const PageDrawing& drawing, const TileKey& key);
+
+    static PageKey pageKey(const Page* page);
+
+    void dropOtherGenerations(int generation);
+    void updateRevision(const PageKey& page, const PageDrawing& drawing);
+    void invalidate(const PageKey& page, const RectF& damage);
+    void requestTile(const TileKey& key, const PageDrawingPtr& drawing);
+    bool paintScaled(QPainter* painter, const TileKey& key, const RectF& rect) const;
+    void paintVectors(draw::Painter* painter, const PageDrawing& drawing, const std::vector<RectF>& rects) const;
+
+    QCache<TileKey, QPixmap> m_tiles;
+    std::map<PageKey, int> m_revisions;
+    std::map<PageKey, QSet<int> > m_levels;
+    QSet<TileKey> m_pending;
+    int m_generation = -1;
+
+    async::Channel<RenderedTile> m_tileRendered;
+    std::shared_ptr<std::mutex> m_sendMutex;
+    async::Notification m_tilesRendered;
+};
+}
+
+#endif // MU_NOTATION_PAGETILECACHE_H
@@ -64,6 +64,10 @@ bool ExportScoreScenario::exportScores(const INotationPtrList& notations, const
         return false;
     }
 
+    for (INotationPtr notation : notations) {
+        notation->finishLayout();
+    }
+
     bool isCreatingOnlyOneFile = this->isCreatingOnlyOneFile(notations, unitType);
 
     // If isCreatingOnlyOneFile, the save dialog has already asked whether to replace
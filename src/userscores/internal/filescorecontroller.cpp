@@ -23,6 +23,7 @@
 
 #include <QObject>
 #include <QBuffer>
+#include <QFile>
 
 #include "log.h"
 #include "translation.h"
@@ -54,6 +55,7 @@ void FileScoreController::init()
     dispatcher()->reg(this, "clear-recent", this, &FileScoreController::clearRecentScores);
 
     dispatcher()->reg(this, "continue-last-session", this, &FileScoreController::continueLastSession);
+    dispatcher()->reg(this, "recover-autosaved-scores", this, &FileScoreController::recoverAutosavedScores);
 }
 
 IMasterNotationPtr FileScoreController::currentMasterNotation() const
@@ -335,6 +337,47 @@ void FileScoreController::continueLastSession()
     openScore(lastScorePath);
 }
 
+void FileScoreController::recoverAutosavedScores()
+{
+    io::paths journalPaths = notationCreator()->recoverableAutosaves();
+    if (journalPaths.empty()) {
+        return;
+    }
+
+    std::string question = trc("userscores", "MuseScore did not close properly. "
+                                             "Do you want to recover the unsaved changes of %n score(s)?",
+                               nullptr, int(journalPaths.size()));
+
+    IInteractive::Result result = interactive()->question(std::string(), question, {
+        IInteractive::Button::Yes,
+        IInteractive::Button::No
+    }, IInteractive::Button::Yes);
+
+    if (result.standartButton() != IInteractive::Button::Yes) {
+        for (const io::path& journalPath : journalPaths) {
+            QFile::remove(journalPath.toQString());
+        }
+        return;
+    }
+
+    for (const io::path& journalPath : journalPaths) {
+        auto notation = notationCreator()->newMasterNotation();
+        IF_ASSERT_FAILED(notation) {
+            return;
+        }
+
+        Ret ret = notation->loadAutosave(journalPath);
+        if (!ret) {
+            LOGE() << "failed recover " << journalPath << ": " << ret.toString();
+            continue;
+        }
+
+        globalContext()->addMasterNotation(notation);
+        globalContext()->setCurrentMasterNotation(notation);
+        interactive()->open("musescore://notation");
+    }
+}
+
 void FileScoreController::exportScore()
 {
     interactive()->open("musescore://userscores/export");
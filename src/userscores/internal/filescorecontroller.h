@@ -80,6 +80,7 @@ private:
     void clearRecentScores();
 
     void continueLastSession();
+    void recoverAutosavedScores();
 
     io::path selectScoreOpeningFile();
     io::path selectScoreSavingFile(const io::path& defaultFilePath, const QString& saveTitle);
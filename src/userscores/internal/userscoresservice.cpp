@@ -21,6 +21,12 @@
  */
 #include "userscoresservice.h"
 
+#include <memory>
+
+#include <QHash>
+#include <QSet>
+
+#include "async/async.h"
 #include "log.h"
 #include "settings.h"
 
@@ -39,8 +45,68 @@ void UserScoresService::init()
 void UserScoresService::updateRecentScoreList()
 {
     io::paths paths = configuration()->recentScorePaths().val;
-    MetaList metaList = msczMetaReader()->readMetaList(paths);
-    m_recentScoreList.set(metaList);
+    int generation = ++m_recentScoreListGeneration;
+
+    //! NOTE The files are read in the background. Until a file is read again
+    //! the list keeps what it knew about it, files that can't be read are dropped at the end
+    struct ReadState {
+        QHash<QString, Meta> metaByPath;
+        QSet<QString> readPaths;
+        bool updateScheduled = false;
+        bool closed = false;
+    };
+
+    auto state = std::make_shared<ReadState>();
+    for (const Meta& meta : m_recentScoreList.val) {
+        state->metaByPath.insert(meta.filePath.toQString(), meta);
+    }
+
+    auto recentScoreList = [paths, state]() {
+        MetaList metaList;
+        for (const io::path& path : paths) {
+            auto it = state->metaByPath.constFind(path.toQString());
+            if (it != state->metaByPath.constEnd()) {
+                metaList.push_back(it.value());
+            }
+        }
+        return metaList;
+    };
+
+    async::Channel<Meta> metaRead = msczMetaReader()->readMetaListAsync(paths);
+    metaRead.onReceive(this, [this, generation, state, recentScoreList](const Meta& meta) {
+        if (generation != m_recentScoreListGeneration) {
+            return;
+        }
+
+        state->metaByPath.insert(meta.filePath.toQString(), meta);
+        state->readPaths.insert(meta.filePath.toQString());
+
+        //! NOTE The list is set once for all the files read until the next event loop iteration
+        if (state->updateScheduled) {
+            return;
+        }
+        state->updateScheduled = true;
+
+        async::Async::call(this, [this, generation, state, recentScoreList]() {
+            state->updateScheduled = false;
+            if (state->closed || generation != m_recentScoreListGeneration) {
+                return;
+            }
+            m_recentScoreList.set(recentScoreList());
+        });
+    }, Asyncable::AsyncMode::AsyncSetRepeat);
+
+    metaRead.onClose(this, [this, generation, state, recentScoreList]() {
+        if (generation != m_recentScoreListGeneration) {
+            return;
+        }
+
+        for (auto it = state->metaByPath.begin(); it != state->metaByPath.end();) {
+            it = state->readPaths.contains(it.key()) ? std::next(it) : state->metaByPath.erase(it);
+        }
+        state->closed = true;
+        m_recentScoreList.set(recentScoreList());
+    });
 }
 
 mu::ValCh<MetaList> UserScoresService::recentScoreList() const
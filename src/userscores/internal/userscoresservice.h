@@ -43,6 +43,7 @@ private:
     void updateRecentScoreList();
 
     ValCh<notation::MetaList> m_recentScoreList;
+    int m_recentScoreListGeneration = 0;
 };
 }
 
@@ -0,0 +1,173 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <QDataStream>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+#include "notation/internal/msczmetareader.h"
+
+#include "system/tests/mocks/filesystemmock.h"
+#include "global/tests/mocks/globalconfigurationmock.h"
+
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::Return;
+
+using namespace mu;
+using namespace mu::framework;
+using namespace mu::notation;
+using namespace mu::system;
+
+class MsczMetaReaderTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(m_dir.isValid());
+
+        m_fileSystem = std::make_shared<FileSystemMock>();
+        m_globalConfiguration = std::make_shared<GlobalConfigurationMock>();
+
+        ON_CALL(*m_globalConfiguration, userAppDataPath())
+        .WillByDefault(Return(io::path(m_dir.path())));
+
+        ON_CALL(*m_fileSystem, exists(_))
+        .WillByDefault(Invoke([](const io::path& path) {
+            return make_ret(QFileInfo::exists(path.toQString()) ? Ret::Code::Ok : Ret::Code::UnknownError);
+        }));
+
+        ON_CALL(*m_fileSystem, readFile(_))
+        .WillByDefault(Invoke([](const io::path& path) {
+            RetVal<QByteArray> result;
+            QFile file(path.toQString());
+            result.ret = make_ret(file.open(QIODevice::ReadOnly) ? Ret::Code::Ok : Ret::Code::UnknownError);
+            result.val = file.readAll();
+            return result;
+        }));
+
+        ON_CALL(*m_fileSystem, writeToFile(_, _))
+        .WillByDefault(Invoke([](const io::path& path, const QByteArray& data) {
+            QFile file(path.toQString());
+            bool ok = file.open(QIODevice::WriteOnly) && file.write(data) == data.size();
+            return make_ret(ok ? Ret::Code::Ok : Ret::Code::UnknownError);
+        }));
+    }
+
+    std::shared_ptr<MsczMetaReader> createReader() const
+    {
+        auto reader = std::make_shared<MsczMetaReader>();
+        reader->setfileSystem(m_fileSystem);
+        reader->setglobalConfiguration(m_globalConfiguration);
+
+        return reader;
+    }
+
+    io::path writeScore(const QString& fileName, const QString& title) const
+    {
+        QString path = m_dir.filePath(fileName);
+
+        QFile file(path);
+        file.open(QIODevice::WriteOnly);
+        file.write(QString("<museScore version=\"3.02\"><Score><metaTag name=\"workTitle\">%1</metaTag></Score></museScore>")
+                   .arg(title).toUtf8());
+
+        return io::path(path);
+    }
+
+    int cacheEntryCount() const
+    {
+        QFile file(m_dir.filePath("scoremeta.cache"));
+        if (!file.open(QIODevice::ReadOnly)) {
+            return -1;
+        }
+
+        QDataStream in(&file);
+        in.setVersion(QDataStream::Qt_5_9);
+
+        quint32 version = 0;
+        quint32 count = 0;
+        in >> version >> count;
+
+        return static_cast<int>(count);
+    }
+
+    QTemporaryDir m_dir;
+    std::shared_ptr<FileSystemMock> m_fileSystem;
+    std::shared_ptr<GlobalConfigurationMock> m_globalConfiguration;
+};
+
+TEST_F(MsczMetaReaderTest, CacheWrittenAndRead)
+{
+    // [GIVEN] A score read once
+    io::path path = writeScore("score.mscx", "First");
+    QDateTime lastModified = QFileInfo(path.toQString()).lastModified();
+
+    MetaList metaList = createReader()->readMetaList({ path });
+    ASSERT_EQ(metaList.size(), 1);
+    EXPECT_EQ(metaList.first().title, "First");
+    EXPECT_EQ(cacheEntryCount(), 1);
+
+    // [GIVEN] The file is changed, keeping its size and modification time
+    writeScore("score.mscx", "Other");
+    QFile file(path.toQString());
+    ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+    ASSERT_TRUE(file.setFileTime(lastModified, QFileDevice::FileModificationTime));
+    file.close();
+
+    // [WHEN] A new reader reads it
+    metaList = createReader()->readMetaList({ path });
+
+    // [THEN] The meta comes from the cache written by the first reader
+    ASSERT_EQ(metaList.size(), 1);
+    EXPECT_EQ(metaList.first().title, "First");
+
+    // [WHEN] The file size changes
+    writeScore("score.mscx", "Changed");
+    metaList = createReader()->readMetaList({ path });
+
+    // [THEN] The file is read again
+    ASSERT_EQ(metaList.size(), 1);
+    EXPECT_EQ(metaList.first().title, "Changed");
+}
+
+TEST_F(MsczMetaReaderTest, CacheDropsRemovedFiles)
+{
+    // [GIVEN] Two scores in the cache
+    io::path first = writeScore("first.mscx", "First");
+    io::path second = writeScore("second.mscx", "Second");
+
+    EXPECT_EQ(createReader()->readMetaList({ first, second }).size(), 2);
+    EXPECT_EQ(cacheEntryCount(), 2);
+
+    // [WHEN] One of them is removed and the list is read again
+    ASSERT_TRUE(QFile::remove(second.toQString()));
+    MetaList metaList = createReader()->readMetaList({ first, second });
+
+    // [THEN] Its entry is dropped from the cache
+    ASSERT_EQ(metaList.size(), 1);
+    EXPECT_EQ(metaList.first().title, "First");
+    EXPECT_EQ(cacheEntryCount(), 1);
+}
@@ -0,0 +1,150 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "userscores/internal/userscoresservice.h"
+
+#include "async/processevents.h"
+#include "notation/tests/mocks/msczreadermock.h"
+#include "mocks/userscoresconfigurationmock.h"
+
+using ::testing::_;
+using ::testing::Return;
+
+using namespace mu;
+using namespace mu::notation;
+using namespace mu::userscores;
+
+class UserScoresServiceTest : public ::testing::Test, public async::Asyncable
+{
+protected:
+    void SetUp() override
+    {
+        m_service = std::make_shared<UserScoresService>();
+        m_msczReader = std::make_shared<MsczReaderMock>();
+        m_configuration = std::make_shared<UserScoresConfigurationMock>();
+
+        m_service->setconfiguration(m_configuration);
+        m_service->setmsczMetaReader(m_msczReader);
+    }
+
+    Meta createMeta(const io::path& path) const
+    {
+        Meta meta;
+
+        meta.title = path.toQString();
+        meta.filePath = path;
+
+        return meta;
+    }
+
+    std::shared_ptr<UserScoresService> m_service;
+    std::shared_ptr<UserScoresConfigurationMock> m_configuration;
+    std::shared_ptr<MsczReaderMock> m_msczReader;
+};
+
+TEST_F(UserScoresServiceTest, RecentScoreListUpdatedOncePerBatch)
+{
+    // [GIVEN] Recent score paths read in the background
+    io::paths paths { "/path/to/first.mscz", "/path/to/second.mscz", "/path/to/third.mscz" };
+
+    ValCh<io::paths> recentScorePaths;
+    recentScorePaths.val = paths;
+    ON_CALL(*m_configuration, recentScorePaths())
+    .WillByDefault(Return(recentScorePaths));
+
+    async::Channel<Meta> metaRead;
+    EXPECT_CALL(*m_msczReader, readMetaListAsync(paths))
+    .WillOnce(Return(metaRead));
+
+    m_service->init();
+
+    int updates = 0;
+    m_service->recentScoreList().ch.onReceive(this, [&updates](const MetaList&) {
+        ++updates;
+    });
+
+    // [WHEN] The files are read in reverse order, the second one can't be read
+    metaRead.send(createMeta(paths[2]));
+    metaRead.send(createMeta(paths[0]));
+
+    // [THEN] The list isn't set for each file
+    EXPECT_EQ(updates, 0);
+
+    // [WHEN] The event loop runs
+    async::processEvents();
+
+    // [THEN] The list is set once, in the order of the paths
+    EXPECT_EQ(updates, 1);
+    MetaList list = m_service->recentScoreList().val;
+    ASSERT_EQ(list.size(), 2);
+    EXPECT_EQ(list[0].filePath, paths[0]);
+    EXPECT_EQ(list[1].filePath, paths[2]);
+
+    // [WHEN] The reading is finished
+    metaRead.close();
+    async::processEvents();
+
+    // [THEN] The list is set once more
+    EXPECT_EQ(updates, 2);
+    EXPECT_EQ(m_service->recentScoreList().val.size(), 2);
+}
+
+TEST_F(UserScoresServiceTest, UnreadScoresDroppedOnClose)
+{
+    // [GIVEN] A list read before
+    io::paths paths { "/path/to/first.mscz", "/path/to/second.mscz" };
+
+    ValCh<io::paths> recentScorePaths;
+    recentScorePaths.val = paths;
+    ON_CALL(*m_configuration, recentScorePaths())
+    .WillByDefault(Return(recentScorePaths));
+
+    async::Channel<Meta> firstRead;
+    async::Channel<Meta> secondRead;
+    EXPECT_CALL(*m_msczReader, readMetaListAsync(paths))
+    .WillOnce(Return(firstRead))
+    .WillOnce(Return(secondRead));
+
+    m_service->init();
+    firstRead.send(createMeta(paths[0]));
+    firstRead.send(createMeta(paths[1]));
+    firstRead.close();
+    async::processEvents();
+    ASSERT_EQ(m_service->recentScoreList().val.size(), 2);
+
+    // [WHEN] The paths are read again and the second file can't be read anymore
+    recentScorePaths.ch.send(paths);
+    secondRead.send(createMeta(paths[0]));
+    async::processEvents();
+
+    // [THEN] The list keeps the second score until the reading is finished
+    EXPECT_EQ(m_service->recentScoreList().val.size(), 2);
+
+    secondRead.close();
+    async::processEvents();
+
+    MetaList list = m_service->recentScoreList().val;
+    ASSERT_EQ(list.size(), 1);
+    EXPECT_EQ(list[0].filePath, paths[0]);
+}